@@ -0,0 +1,98 @@
+#include "inexor/vulkan-renderer/camera.hpp"
+#include "inexor/vulkan-renderer/frustum.hpp"
+#include "inexor/vulkan-renderer/world/cube.hpp"
+
+#include <benchmark/benchmark.h>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+
+namespace {
+
+using inexor::vulkan_renderer::Camera;
+using inexor::vulkan_renderer::Frustum;
+using inexor::vulkan_renderer::world::Cube;
+
+/// The edge length of the octree root.
+constexpr float OCTREE_SIZE = 256.0f;
+
+void subdivide(const std::shared_ptr<Cube> &cube, const std::int64_t levels) {
+    if (levels == 0) {
+        return;
+    }
+    cube->set_type(Cube::Type::OCTANT);
+    for (const auto &child : cube->childs()) {
+        subdivide(child, levels - 1);
+    }
+}
+
+/// @brief Returns an octree which is completely subdivided into 8^levels solid cubes, whose polygon caches are valid.
+/// The octrees are built once per number of levels and shared by all benchmark runs.
+const Cube &get_octree(const std::int64_t levels) {
+    static std::map<std::int64_t, std::shared_ptr<Cube>> octrees;
+
+    auto &octree = octrees[levels];
+    if (!octree) {
+        octree = std::make_shared<Cube>(Cube::Type::SOLID, OCTREE_SIZE, glm::vec3(-OCTREE_SIZE / 2));
+        subdivide(octree, levels);
+        benchmark::DoNotOptimize(octree->polygons(true));
+    }
+    return *octree;
+}
+
+/// @brief Returns the frustum of a camera in the center of the octree, as the renderer sets it up.
+Frustum get_camera_frustum() {
+    Camera camera;
+    camera.type = Camera::CameraType::LOOKAT;
+    camera.set_perspective(45.0f, 16.0f / 9.0f, 0.1f, 256.0f);
+    camera.set_position({0.0f, 0.0f, 5.0f});
+    camera.set_rotation({0.0f, 0.0f, 0.0f});
+
+    glm::mat4 projection = camera.matrices.perspective;
+    projection[1][1] *= -1;
+
+    return Frustum(projection * camera.matrices.view);
+}
+
+void BM_OctreePolygons(benchmark::State &state) {
+    const Cube &octree = get_octree(state.range(0));
+
+    std::size_t polygon_cache_count = 0;
+    for (auto _ : state) {
+        const auto polygons = octree.polygons();
+        polygon_cache_count = polygons.size();
+        benchmark::DoNotOptimize(polygons.data());
+    }
+    state.counters["polygon_caches"] = static_cast<double>(polygon_cache_count);
+}
+
+void BM_OctreePolygonsFrustumCulled(benchmark::State &state) {
+    const Cube &octree = get_octree(state.range(0));
+    const Frustum frustum = get_camera_frustum();
+
+    std::size_t polygon_cache_count = 0;
+    for (auto _ : state) {
+        const auto polygons = octree.polygons(frustum);
+        polygon_cache_count = polygons.size();
+        benchmark::DoNotOptimize(polygons.data());
+    }
+    state.counters["polygon_caches"] = static_cast<double>(polygon_cache_count);
+}
+
+void BM_FrustumTestBox(benchmark::State &state) {
+    const Frustum frustum = get_camera_frustum();
+
+    glm::vec3 min{-OCTREE_SIZE / 2};
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(frustum.test_box(min, min + glm::vec3(1.0f)));
+        min.x = min.x < OCTREE_SIZE / 2 ? min.x + 1.0f : -OCTREE_SIZE / 2;
+    }
+}
+
+} // namespace
+
+BENCHMARK(BM_OctreePolygons)->DenseRange(3, 6)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_OctreePolygonsFrustumCulled)->DenseRange(3, 6)->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_FrustumTestBox);
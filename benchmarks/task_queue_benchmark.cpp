@@ -0,0 +1,113 @@
+#include "inexor/vulkan-renderer/mpmc_queue.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <utility>
+
+namespace {
+
+using inexor::MPMCQueue;
+
+/// The capacity of the queues. It is large enough that the queues are never full in these benchmarks.
+constexpr std::size_t QUEUE_CAPACITY = 4096;
+
+/// A std::queue guarded by a mutex, like the tasklists of the threadpool's mutex backend.
+template <typename T>
+class MutexQueue {
+private:
+    std::mutex mutex;
+    std::queue<T> queue;
+
+public:
+    explicit MutexQueue(std::size_t) {}
+
+    bool try_push(T value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push(std::move(value));
+        return true;
+    }
+
+    bool try_pop(T &value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.empty()) {
+            return false;
+        }
+        value = std::move(queue.front());
+        queue.pop();
+        return true;
+    }
+};
+
+/// @brief Every thread pushes an element and pops one again, so all threads contend on the same queue.
+template <typename Queue>
+void BM_QueuePushPop(benchmark::State &state) {
+    static std::unique_ptr<Queue> queue;
+
+    // The benchmark library synchronizes all threads before and after the loop.
+    if (state.thread_index == 0) {
+        queue = std::make_unique<Queue>(QUEUE_CAPACITY);
+    }
+
+    std::uint64_t value = 0;
+    for (auto _ : state) {
+        while (!queue->try_push(value)) {
+            std::this_thread::yield();
+        }
+        while (!queue->try_pop(value)) {
+            std::this_thread::yield();
+        }
+        benchmark::DoNotOptimize(value);
+    }
+
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index == 0) {
+        queue.reset();
+    }
+}
+
+/// @brief Every thread pushes a burst of elements and pops them again, which resembles submitting a batch of tasks.
+template <typename Queue>
+void BM_QueueBurst(benchmark::State &state) {
+    static std::unique_ptr<Queue> queue;
+
+    if (state.thread_index == 0) {
+        queue = std::make_unique<Queue>(QUEUE_CAPACITY);
+    }
+
+    const auto burst_size = static_cast<std::uint64_t>(state.range(0));
+
+    std::uint64_t value = 0;
+    for (auto _ : state) {
+        for (std::uint64_t i = 0; i < burst_size; i++) {
+            while (!queue->try_push(i)) {
+                std::this_thread::yield();
+            }
+        }
+        for (std::uint64_t i = 0; i < burst_size; i++) {
+            while (!queue->try_pop(value)) {
+                std::this_thread::yield();
+            }
+        }
+        benchmark::DoNotOptimize(value);
+    }
+
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(burst_size));
+
+    if (state.thread_index == 0) {
+        queue.reset();
+    }
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_QueuePushPop, MutexQueue<std::uint64_t>)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_QueuePushPop, MPMCQueue<std::uint64_t>)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_QueueBurst, MutexQueue<std::uint64_t>)->Arg(64)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_QueueBurst, MPMCQueue<std::uint64_t>)->Arg(64)->ThreadRange(1, 8)->UseRealTime();
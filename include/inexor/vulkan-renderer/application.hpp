@@ -6,6 +6,7 @@
 #include <GLFW/glfw3.h>
 #include <vulkan/vulkan_core.h>
 
+#include <chrono>
 #include <cstdint>
 #include <memory>
 #include <string>
@@ -28,14 +29,21 @@ private:
 
     std::uint32_t engine_version = 0;
 
-    // The core concept of paralellization in Inexor is to use a
-    // C++17 threadpool implementation which spawns worker threads.
-    // A task system is used to distribute work over worker threads.
-    // Call thread_pool->execute(); to order new tasks to be worked on.
-    std::shared_ptr<ThreadPool> thread_pool;
-
     std::size_t current_frame = 0;
 
+    /// The number of frames to render in headless mode.
+    std::uint32_t headless_frame_count = 1000;
+
+    /// The number of textures to load, repeating the configured textures if necessary. 0 loads every configured
+    /// texture once.
+    std::uint32_t texture_count = 0;
+
+    /// Decode the texture files on the threadpool.
+    bool parallel_texture_decoding = true;
+
+    /// Load decoded and mipmapped textures from the texture cache.
+    bool texture_cache_enabled = true;
+
     // TODO: Refactor into a manger class.
     struct ShaderSetup {
         VkShaderStageFlagBits shader_type;
@@ -70,8 +78,18 @@ private:
 
     VkResult render_frame();
 
+    /// @brief Logs the threadpool's instrumentation counters and resets them.
+    void log_thread_pool_stats();
+
+    /// @brief Logs the number of uploads, their throughput and the staging allocations, and resets the counters.
+    /// @param load_time [in] The time it took to load and upload the resources.
+    void log_upload_stats(std::chrono::duration<double> load_time);
+
+    /// @brief Renders a fixed number of frames into offscreen images and reports CPU and GPU frame times.
+    void run_headless();
+
     /// @brief Implementation of the uniform buffer update method.
-    /// @param current_image [in] The current image index.
+    /// @param current_image [in] The index of the current frame in flight.
     VkResult update_uniform_buffers(const std::size_t current_image);
 
     VkResult update_keyboard_input();
@@ -0,0 +1,186 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/deletion_queue.hpp"
+#include "inexor/vulkan-renderer/wrapper/chunk_mesh_buffer.hpp"
+#include "inexor/vulkan-renderer/wrapper/compute_pipeline.hpp"
+#include "inexor/vulkan-renderer/wrapper/depth_pyramid.hpp"
+#include "inexor/vulkan-renderer/wrapper/descriptor_allocator.hpp"
+#include "inexor/vulkan-renderer/wrapper/descriptor_layout_cache.hpp"
+#include "inexor/vulkan-renderer/wrapper/gpu_memory_buffer.hpp"
+#include "inexor/vulkan-renderer/wrapper/indirect_draw_buffer.hpp"
+#include "inexor/vulkan-renderer/wrapper/pipeline_layout.hpp"
+#include "inexor/vulkan-renderer/wrapper/shader.hpp"
+#include "inexor/vulkan-renderer/wrapper/uniform_ring_buffer.hpp"
+
+#include <glm/glm.hpp>
+#include <vma/vk_mem_alloc.h>
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace inexor::vulkan_renderer {
+
+/// @brief Culls the chunks of a chunk mesh buffer on the device, so only the visible chunks are drawn.
+/// Every frame, a compute shader tests the bounding box of every chunk against the view frustum and against a depth
+/// pyramid (Hi-Z buffer) of the previous frame's depth buffer, and writes the draw commands of the visible chunks into
+/// the current frame's region of an indirect draw buffer. After the frame has been rendered, another compute shader
+/// builds the depth pyramid for the next frame from the depth buffer.
+/// If the draw count is read from the indirect draw buffer, the commands of the visible chunks are packed densely.
+/// Otherwise every chunk keeps its command, and the commands of culled chunks draw no instances.
+/// @note This class is not thread safe.
+class ChunkCuller {
+public:
+    /// The SPIR-V files of the compute shaders.
+    static constexpr const char *CULLING_SHADER_FILE = "shaders/cull_chunks.comp.spv";
+    static constexpr const char *DEPTH_PYRAMID_SHADER_FILE = "shaders/depth_pyramid.comp.spv";
+    static constexpr const char *MULTISAMPLED_DEPTH_PYRAMID_SHADER_FILE = "shaders/depth_pyramid_ms.comp.spv";
+
+    /// @brief The number of chunks the device drew and culled in a frame.
+    struct Stats {
+        std::uint32_t drawn_count = 0;
+        std::uint32_t culled_count = 0;
+    };
+
+    /// @brief The bounding box and the draw command of a chunk as the culling shader reads them.
+    struct ChunkCullData {
+        glm::vec4 bounds_min;
+        glm::vec4 bounds_max;
+        VkDrawIndexedIndirectCommand command;
+        std::uint32_t padding[3];
+    };
+
+private:
+    VkDevice device;
+    VkPhysicalDevice graphics_card;
+    VmaAllocator vma_allocator;
+
+    std::uint32_t max_chunk_count;
+    std::uint32_t frame_count;
+    bool compact_draws;
+    bool occlusion_culling_enabled;
+    VkSampleCountFlagBits depth_sample_count;
+
+    /// The bounding boxes and draw commands of the chunks, divided into one region per frame in flight.
+    VkDeviceSize chunk_frame_size;
+    wrapper::GPUMemoryBuffer chunk_buffer;
+
+    /// The number of chunks every frame in flight has culled, or 0 if it did not cull any chunks yet.
+    std::vector<std::uint32_t> frame_chunk_counts;
+
+    VkDescriptorSetLayout culling_descriptor_set_layout;
+    VkDescriptorSetLayout depth_pyramid_descriptor_set_layout;
+
+    std::unique_ptr<wrapper::PipelineLayout> culling_pipeline_layout;
+    std::unique_ptr<wrapper::PipelineLayout> depth_pyramid_pipeline_layout;
+
+    std::unique_ptr<wrapper::ComputePipeline> culling_pipeline;
+
+    /// Builds mip level 0 of the depth pyramid from the (possibly multisampled) depth buffer.
+    std::unique_ptr<wrapper::ComputePipeline> first_depth_pyramid_pipeline;
+
+    /// Builds the other mip levels of the depth pyramid from the mip level below.
+    std::unique_ptr<wrapper::ComputePipeline> depth_pyramid_pipeline;
+
+    /// Reads single texels from the depth buffer and the depth pyramid.
+    VkSampler sampler = VK_NULL_HANDLE;
+
+    VkExtent2D depth_extent = {};
+    std::unique_ptr<wrapper::DepthPyramid> depth_pyramid;
+
+    /// False until the image layout of the depth pyramid has been initialized.
+    bool depth_pyramid_initialized = false;
+
+    /// True if the depth pyramid has been built from the depth buffer of a previous frame.
+    bool depth_pyramid_valid = false;
+
+    /// The matrix the chunks of the current frame are culled with, and the one of the frame the depth pyramid was
+    /// built from.
+    glm::mat4 current_view_projection{1.0f};
+    glm::mat4 depth_pyramid_view_projection{1.0f};
+
+    /// @brief Creates a compute pipeline from a SPIR-V file.
+    [[nodiscard]] std::unique_ptr<wrapper::ComputePipeline>
+    create_pipeline(VkPipelineCache pipeline_cache, VkPipelineLayout pipeline_layout, const char *file_name,
+                    const std::string &name) const;
+
+    /// @brief Records a barrier on all mip levels of the depth pyramid.
+    void record_depth_pyramid_barrier(VkCommandBuffer command_buffer, VkPipelineStageFlags src_stage_mask,
+                                      VkAccessFlags src_access_mask, VkAccessFlags dst_access_mask,
+                                      std::uint32_t base_mip_level, std::uint32_t mip_count);
+
+public:
+    /// @brief Creates the compute pipelines, the chunk buffer and the depth pyramid.
+    /// @param device [in] The Vulkan device.
+    /// @param graphics_card [in] The graphics card.
+    /// @param vma_allocator [in] The Vulkan Memory Allocator library handle.
+    /// @param pipeline_cache [in] The pipeline cache which speeds up the creation of the pipelines.
+    /// @param descriptor_layout_cache [in] The cache which creates the descriptor set layouts.
+    /// @param max_chunk_count [in] The number of chunks every frame in flight can cull.
+    /// @param frame_count [in] The number of frames in flight.
+    /// @param compact_draws [in] True if the draw count is read from the indirect draw buffer, so the commands of the
+    /// visible chunks can be packed densely.
+    /// @param occlusion_culling_enabled [in] If false, the chunks are only tested against the view frustum and no
+    /// depth pyramid is built.
+    /// @param depth_extent [in] The size of the depth buffer.
+    /// @param depth_sample_count [in] The number of samples per pixel of the depth buffer.
+    ChunkCuller(VkDevice device, VkPhysicalDevice graphics_card, VmaAllocator vma_allocator,
+                VkPipelineCache pipeline_cache, wrapper::DescriptorLayoutCache &descriptor_layout_cache,
+                std::uint32_t max_chunk_count, std::uint32_t frame_count, bool compact_draws,
+                bool occlusion_culling_enabled, VkExtent2D depth_extent, VkSampleCountFlagBits depth_sample_count);
+
+    ChunkCuller(const ChunkCuller &) = delete;
+    ChunkCuller(ChunkCuller &&) = delete;
+
+    ChunkCuller &operator=(const ChunkCuller &) = delete;
+    ChunkCuller &operator=(ChunkCuller &&) = delete;
+
+    ~ChunkCuller();
+
+    /// @brief Recreates the depth pyramid for a new size of the depth buffer. Occlusion culling is skipped until the
+    /// depth pyramid has been built again.
+    /// @param depth_extent [in] The new size of the depth buffer.
+    /// @param deletion_queue [in] The previous depth pyramid is destroyed through this queue, as frames which are still
+    /// in flight might use it.
+    void resize(VkExtent2D depth_extent, DeletionQueue &deletion_queue);
+
+    /// @brief Reads how many chunks the device drew and culled during the previous use of a frame in flight.
+    /// This must be called after draw_buffer.begin_frame(frame_index), before record_culling() for the same frame.
+    /// @param frame_index [in] The index of the frame in flight, whose fence must have signaled.
+    /// @param draw_buffer [in] The indirect draw buffer the chunks have been culled into.
+    /// @return The statistics, or std::nullopt if the frame in flight did not cull any chunks yet.
+    [[nodiscard]] std::optional<Stats> read_stats(std::uint32_t frame_index,
+                                                  const wrapper::IndirectDrawBuffer &draw_buffer) const;
+
+    /// @brief Records the culling of all chunks into the current frame's region of the indirect draw buffer, followed
+    /// by a barrier which makes the draw commands available to indirect draw calls and to the host.
+    /// This must be recorded outside of a render pass, before the chunks are drawn.
+    /// @param command_buffer [in] The command buffer of the frame.
+    /// @param frame_index [in] The index of the frame in flight.
+    /// @param descriptor_allocator [in] The descriptor allocator of the frame in flight.
+    /// @param uniform_ring_buffer [in] The uniform ring buffer, whose current frame is the frame in flight.
+    /// @param chunk_meshes [in] The chunks to cull.
+    /// @param draw_buffer [in] The indirect draw buffer, which must have begun the frame in flight.
+    /// @param view_projection [in] The matrix which transforms the chunk bounds into clip space.
+    void record_culling(VkCommandBuffer command_buffer, std::uint32_t frame_index,
+                        wrapper::DescriptorAllocator &descriptor_allocator,
+                        wrapper::UniformRingBuffer &uniform_ring_buffer, const wrapper::ChunkMeshBuffer &chunk_meshes,
+                        wrapper::IndirectDrawBuffer &draw_buffer, const glm::mat4 &view_projection);
+
+    /// @brief Records building the depth pyramid from the depth buffer the chunks have been drawn into, which is used
+    /// to cull the chunks of the next frame. This does nothing if occlusion culling is disabled.
+    /// @param command_buffer [in] The command buffer of the frame, after the chunks have been drawn.
+    /// @param descriptor_allocator [in] The descriptor allocator of the frame in flight.
+    /// @param depth_buffer_view [in] The image view of the depth buffer, which only has the depth aspect. The depth
+    /// buffer must be in VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL and be readable by compute shaders.
+    void record_depth_pyramid(VkCommandBuffer command_buffer, wrapper::DescriptorAllocator &descriptor_allocator,
+                              VkImageView depth_buffer_view);
+
+    [[nodiscard]] bool is_occlusion_culling_enabled() const {
+        return occlusion_culling_enabled;
+    }
+};
+
+} // namespace inexor::vulkan_renderer
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace inexor::vulkan_renderer {
+
+/// @brief Delays the destruction of Vulkan objects until the frames which might still use them have finished.
+/// Every object which is pushed is tagged with the number of the frame which is currently being prepared. Once the
+/// fence of that frame has signaled, release() destroys the object. Frames are numbered by end_frame(), which must be
+/// called whenever a frame has been submitted. This replaces waiting for the device to be idle before destroying
+/// objects which are replaced at runtime, e.g. the swapchain and its framebuffers.
+/// The RAII wrappers destroy their Vulkan objects immediately in their destructors, which is only safe if the device
+/// does not use them anymore. A wrapper which might still be in use is moved into the queue with retire() instead, so
+/// its destructor runs once the frame has finished:
+/// @code
+/// deletion_queue.retire(std::move(graphics_pipeline));
+/// graphics_pipeline = std::make_unique<wrapper::GraphicsPipeline>(...);
+/// @endcode
+/// @note This class is not thread safe.
+class DeletionQueue {
+private:
+    struct Entry {
+        std::uint64_t frame;
+        std::function<void()> deleter;
+    };
+
+    std::deque<Entry> entries;
+
+    /// The number of the frame which is submitted next. Frame numbers start at 1, so 0 stands for no frame.
+    std::uint64_t current_frame = 1;
+
+public:
+    DeletionQueue() = default;
+
+    /// Delete the copy constructor so deletion queues are neither copyable nor movable, as the deleters might refer to
+    /// the queue's owner.
+    DeletionQueue(const DeletionQueue &) = delete;
+    DeletionQueue(DeletionQueue &&) = delete;
+
+    DeletionQueue &operator=(const DeletionQueue &) = delete;
+    DeletionQueue &operator=(DeletionQueue &&) = delete;
+
+    /// @brief Destroys all remaining objects, see flush().
+    ~DeletionQueue();
+
+    /// @brief Enqueues a function which destroys one or more Vulkan objects.
+    /// @param deleter [in] The function, which is called once the current frame has finished.
+    void push(std::function<void()> deleter);
+
+    /// @brief Takes ownership of an object and destroys it once the current frame has finished.
+    /// This is meant for RAII wrappers (e.g. GPUMemoryBuffer, Image, Texture or GraphicsPipeline),
+    /// pointers to them and containers of them. The moved-from wrapper does not own any Vulkan objects anymore.
+    /// @param object [in] The object, which must be movable.
+    template <typename T>
+    void retire(T &&object) {
+        static_assert(!std::is_lvalue_reference_v<T>, "Objects must be moved into the deletion queue!");
+
+        auto retired_object = std::make_shared<T>(std::move(object));
+        push([retired_object]() mutable { retired_object.reset(); });
+    }
+
+    /// @brief Starts the next frame. This must be called after a frame has been submitted.
+    /// @return The number of the submitted frame, which must be passed to release() once its fence has signaled.
+    std::uint64_t end_frame();
+
+    /// @brief Destroys all objects which were pushed until the given frame was submitted.
+    /// @param finished_frame [in] The number of a frame whose fence has signaled. As fences signal in submission order,
+    /// all frames before it have finished as well.
+    void release(std::uint64_t finished_frame);
+
+    /// @brief Destroys all objects regardless of their frame.
+    /// @note The device must not use any of the objects anymore, e.g. because it is idle.
+    void flush();
+
+    /// @brief Returns the number of objects (or groups of objects) which wait for their destruction.
+    [[nodiscard]] std::size_t get_size() const {
+        return entries.size();
+    }
+};
+
+} // namespace inexor::vulkan_renderer
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace inexor::vulkan_renderer {
+
+/// @brief The number of allocations served by all frame arenas during one frame.
+struct FrameArenaStats {
+    std::size_t allocation_count = 0;
+    std::size_t allocated_bytes = 0;
+};
+
+/// @brief A linear allocator for transient data which only lives for the duration of one frame.
+/// Every thread has its own arena (see FrameArena::get()), so allocating never needs a lock. Allocating is a pointer
+/// bump, deallocating does nothing. The whole arena is rewound at once when the thread first uses it in a new frame.
+/// FrameArena is a std::pmr::memory_resource, so it can be passed to std::pmr containers directly:
+/// @code
+/// std::pmr::vector<OctreeVertex> vertices(&FrameArena::get());
+/// @endcode
+/// @warning Memory from a frame arena must not be used after the next call of FrameArena::begin_frame().
+class FrameArena : public std::pmr::memory_resource {
+public:
+    /// The size of the first memory block of every arena in bytes.
+    static constexpr std::size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+    /// The capacity in bytes an arena keeps across frames without needing it. If an arena grew beyond this in an
+    /// oversized frame (e.g. while loading the octree), the additional memory is released once a frame needs less.
+    static constexpr std::size_t MAX_RETAINED_CAPACITY = 4 * 1024 * 1024;
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        std::size_t size = 0;
+    };
+
+    std::vector<Block> blocks;
+
+    /// The index of the block which is currently allocated from.
+    std::size_t current_block = 0;
+
+    /// The number of bytes which are used in the current block.
+    std::size_t current_offset = 0;
+
+    /// The number of bytes which have been allocated since the last reset.
+    std::size_t used_bytes = 0;
+
+    /// The frame index this arena was last reset in.
+    std::uint64_t frame_index = 0;
+
+    /// The number of the current frame, incremented by begin_frame().
+    static std::atomic<std::uint64_t> global_frame_index;
+
+    /// Allocation counters of all arenas in the current frame.
+    static std::atomic<std::size_t> frame_allocation_count;
+    static std::atomic<std::size_t> frame_allocated_bytes;
+
+    /// Allocation counters of all arenas in the previous frame.
+    static std::atomic<std::size_t> last_frame_allocation_count;
+    static std::atomic<std::size_t> last_frame_allocated_bytes;
+
+    /// @brief Appends a new memory block which is large enough for the given allocation.
+    void add_block(std::size_t minimum_size);
+
+protected:
+    void *do_allocate(std::size_t bytes, std::size_t alignment) override;
+
+    void do_deallocate(void *, std::size_t, std::size_t) override {
+        // Memory is only released by rewinding the whole arena.
+    }
+
+    [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override {
+        return this == &other;
+    }
+
+public:
+    /// @param block_size [in] The size of the first memory block in bytes.
+    explicit FrameArena(std::size_t block_size = DEFAULT_BLOCK_SIZE);
+
+    /// Delete the copy constructor so frame arenas are move-only objects.
+    FrameArena(const FrameArena &) = delete;
+    FrameArena(FrameArena &&) noexcept = default;
+
+    /// Delete the copy assignment operator so frame arenas are move-only objects.
+    FrameArena &operator=(const FrameArena &) = delete;
+    FrameArena &operator=(FrameArena &&) noexcept = default;
+
+    ~FrameArena() override = default;
+
+    /// @brief Rewinds the arena so its memory can be reused.
+    /// If the last frame needed more than one memory block, they are merged into one block of the total size. If the
+    /// capacity exceeds MAX_RETAINED_CAPACITY but the last frame needed less, it is shrunk to MAX_RETAINED_CAPACITY.
+    void reset();
+
+    /// @brief Returns the total size of all memory blocks in bytes.
+    [[nodiscard]] std::size_t get_capacity() const;
+
+    /// @brief Returns the frame arena of the calling thread.
+    /// The arena is reset automatically when it is first used after begin_frame() has been called.
+    [[nodiscard]] static FrameArena &get();
+
+    /// @brief Starts a new frame for the frame arenas of all threads.
+    /// @note This should be called once per frame by the render thread, after the frame's fence has been waited for.
+    static void begin_frame();
+
+    /// @brief Returns the allocation counts of all frame arenas in the previous frame.
+    [[nodiscard]] static FrameArenaStats get_last_frame_stats();
+};
+
+} // namespace inexor::vulkan_renderer
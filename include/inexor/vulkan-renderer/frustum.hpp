@@ -0,0 +1,49 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <array>
+
+namespace inexor::vulkan_renderer {
+
+/// @brief The six planes which bound the volume a camera sees.
+/// Every plane is stored as a vec4 whose xyz is the normalized normal, which points into the frustum, and whose w is
+/// the distance to the origin, so a point p is inside of a plane if dot(plane.xyz, p) + plane.w >= 0.
+struct Frustum {
+    /// @brief The result of testing a bounding box against the frustum.
+    enum class Visibility { OUTSIDE, INTERSECTING, INSIDE };
+
+    /// The left, right, bottom, top, near and far plane.
+    std::array<glm::vec4, 6> planes{};
+
+    /// The components of the planes in structure of arrays layout, so test_box() can test four planes at once. The
+    /// last two entries are padding planes which contain every point.
+    alignas(16) std::array<float, 8> normals_x{};
+    alignas(16) std::array<float, 8> normals_y{};
+    alignas(16) std::array<float, 8> normals_z{};
+    alignas(16) std::array<float, 8> distances{};
+
+    Frustum() = default;
+
+    /// @brief Extracts the planes from a projection matrix, as described by Gribb and Hartmann.
+    /// The depth range of the clip space must be 0 to 1, as it is in Vulkan.
+    /// @param view_projection [in] The projection matrix multiplied by the view matrix. If a model matrix is included
+    /// as well, the planes are in the space of the model.
+    explicit Frustum(const glm::mat4 &view_projection);
+
+    /// @brief Tests an axis aligned bounding box against all planes, using SSE2 if it is available.
+    /// The test is conservative: a box which is outside of the frustum, but not entirely outside of a single plane,
+    /// is reported as intersecting.
+    /// @param min [in] The minimum corner of the box.
+    /// @param max [in] The maximum corner of the box.
+    [[nodiscard]] Visibility test_box(const glm::vec3 &min, const glm::vec3 &max) const;
+
+    /// @brief Tests an axis aligned bounding box against all planes without SIMD instructions.
+    /// This is what test_box() does if SSE2 is not available. It sums the terms of the plane distances in the same
+    /// order as the SSE2 path, so both return the same result even for boxes which touch a plane.
+    /// @param min [in] The minimum corner of the box.
+    /// @param max [in] The maximum corner of the box.
+    [[nodiscard]] Visibility test_box_scalar(const glm::vec3 &min, const glm::vec3 &max) const;
+};
+
+} // namespace inexor::vulkan_renderer
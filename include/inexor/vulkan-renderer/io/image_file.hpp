@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+
+namespace inexor::vulkan_renderer::io {
+
+/// @brief An image file (e.g. JPG or PNG) which is decoded into RGBA8 texels with stb_image.
+/// Decoding does not touch any global state, so image files can be loaded on worker threads.
+class ImageFile {
+private:
+    struct StbImageDeleter {
+        void operator()(std::uint8_t *texel_data) const;
+    };
+
+    std::string file_name;
+    std::unique_ptr<std::uint8_t, StbImageDeleter> texel_data;
+
+    std::uint32_t width = 0;
+    std::uint32_t height = 0;
+
+    /// The number of channels in the file. The texel data always has four channels.
+    std::uint32_t channels = 0;
+
+    /// @brief Takes ownership of the texel data returned by stb_image.
+    void set_texel_data(std::uint8_t *data, int image_width, int image_height, int image_channels);
+
+public:
+    /// @brief Reads and decodes an image file.
+    /// @param file_name [in] The name of the file.
+    /// @exception std::runtime_error The file could not be loaded or decoded.
+    explicit ImageFile(const std::filesystem::path &file_name);
+
+    /// @brief Decodes an image file which has already been read into memory.
+    /// @param file_data [in] The content of the file.
+    /// @param file_size [in] The size of the file in bytes.
+    /// @param file_name [in] The name of the file, which is used for error messages.
+    /// @exception std::runtime_error The file could not be decoded.
+    ImageFile(const std::uint8_t *file_data, std::size_t file_size, const std::string &file_name);
+
+    [[nodiscard]] const std::string &get_file_name() const {
+        return file_name;
+    }
+
+    [[nodiscard]] std::uint32_t get_width() const {
+        return width;
+    }
+
+    [[nodiscard]] std::uint32_t get_height() const {
+        return height;
+    }
+
+    [[nodiscard]] std::uint32_t get_channels() const {
+        return channels;
+    }
+
+    /// @brief Returns the tightly packed RGBA8 texels.
+    [[nodiscard]] const std::uint8_t *get_data() const {
+        return texel_data.get();
+    }
+
+    /// @brief Returns the size of the texel data in bytes.
+    [[nodiscard]] std::size_t get_data_size() const {
+        return static_cast<std::size_t>(width) * height * 4;
+    }
+};
+
+} // namespace inexor::vulkan_renderer::io
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/io/mapped_file.hpp"
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace inexor::vulkan_renderer::io {
+
+/// @brief A 2D texture in a KTX 2.0 container (https://github.khronos.org/KTX-Specification/).
+/// Only textures without supercompression are supported, whose texel data can be copied into an image directly.
+/// The supported formats are VK_FORMAT_R8G8B8A8_UNORM and the BC1, BC3 and BC7 block compressed formats.
+/// The file is mapped into memory, so the texel data is copied straight from the file into the staging memory.
+class Ktx2File {
+private:
+    MappedFile file;
+
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    std::uint32_t width = 0;
+    std::uint32_t height = 0;
+
+    /// The offset of every mip level in the file, starting with the first (largest) level.
+    std::vector<VkDeviceSize> level_offsets;
+
+    /// The end of the last mip level data in the file.
+    VkDeviceSize data_size = 0;
+
+public:
+    /// @brief Reads and validates a KTX 2.0 file.
+    /// @param file_name [in] The name of the file.
+    /// @exception std::runtime_error The file is not a valid KTX 2.0 file or uses an unsupported feature or format.
+    explicit Ktx2File(const std::filesystem::path &file_name);
+
+    [[nodiscard]] const std::string &get_file_name() const {
+        return file.get_file_name();
+    }
+
+    [[nodiscard]] VkFormat get_format() const {
+        return format;
+    }
+
+    [[nodiscard]] std::uint32_t get_width() const {
+        return width;
+    }
+
+    [[nodiscard]] std::uint32_t get_height() const {
+        return height;
+    }
+
+    [[nodiscard]] std::uint32_t get_mip_levels() const {
+        return static_cast<std::uint32_t>(level_offsets.size());
+    }
+
+    /// @brief Returns the offset of every mip level relative to get_data(), starting with the first level.
+    [[nodiscard]] const std::vector<VkDeviceSize> &get_level_offsets() const {
+        return level_offsets;
+    }
+
+    /// @brief Returns the start of the file, which the mip level offsets are relative to.
+    [[nodiscard]] const std::uint8_t *get_data() const {
+        return file.get_data();
+    }
+
+    /// @brief Returns the size of the data which contains all mip levels, starting at get_data().
+    [[nodiscard]] VkDeviceSize get_data_size() const {
+        return data_size;
+    }
+};
+
+/// @brief Returns the size of a 4x4 block of a block compressed format, or of a texel of an uncompressed format.
+/// @param format [in] The format, which must be supported by Ktx2File.
+/// @return The size in bytes, or 0 if the format is not supported.
+[[nodiscard]] std::uint32_t get_ktx2_block_size(VkFormat format);
+
+/// @brief Writes a 2D texture into a KTX 2.0 file.
+/// @param file_name [in] The name of the file.
+/// @param format [in] The format of the texel data, which must be supported by Ktx2File.
+/// @param width [in] The width of the first mip level.
+/// @param height [in] The height of the first mip level.
+/// @param levels [in] The tightly packed texel data of every mip level, starting with the first level.
+/// @exception std::runtime_error The file could not be written.
+void write_ktx2_file(const std::filesystem::path &file_name, VkFormat format, std::uint32_t width,
+                     std::uint32_t height, const std::vector<std::vector<std::uint8_t>> &levels);
+
+} // namespace inexor::vulkan_renderer::io
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+namespace inexor::vulkan_renderer::io {
+
+/// @brief A read-only memory mapping of a whole file.
+/// The operating system pages the file in on access, so data can be copied from the file (e.g. into a staging buffer)
+/// without reading it into a separate buffer first.
+class MappedFile {
+private:
+    std::string file_name;
+    const std::uint8_t *data = nullptr;
+    std::size_t size = 0;
+
+public:
+    /// @brief Maps a file into memory.
+    /// @param file_name [in] The name of the file.
+    /// @exception std::runtime_error The file could not be opened or mapped.
+    explicit MappedFile(const std::filesystem::path &file_name);
+
+    /// Delete the copy constructor so mapped files are move-only objects.
+    MappedFile(const MappedFile &) = delete;
+    MappedFile(MappedFile &&other) noexcept;
+
+    /// Delete the copy assignment operator so mapped files are move-only objects.
+    MappedFile &operator=(const MappedFile &) = delete;
+    MappedFile &operator=(MappedFile &&) = delete;
+
+    ~MappedFile();
+
+    [[nodiscard]] const std::string &get_file_name() const {
+        return file_name;
+    }
+
+    /// @brief Returns the content of the file, which is a null pointer if the file is empty.
+    [[nodiscard]] const std::uint8_t *get_data() const {
+        return data;
+    }
+
+    [[nodiscard]] std::size_t get_size() const {
+        return size;
+    }
+};
+
+} // namespace inexor::vulkan_renderer::io
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/io/ktx2_file.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+
+namespace inexor::vulkan_renderer::io {
+
+/// @brief A directory of textures which have been decoded and mipmapped before.
+/// Every entry is a KTX 2.0 file with the full mip chain in VK_FORMAT_R8G8B8A8_UNORM, named after a hash of the
+/// content of its source file and of the processing options. Loading an entry skips decoding and mip generation, and
+/// its texel data is copied straight from the memory mapped file into the staging memory. A changed source file (or a
+/// change of the processing) leads to a new entry, so entries never have to be invalidated.
+/// @note Loading textures is thread safe. Entries are written to a temporary file first and renamed afterwards, so
+/// concurrent loads of the same texture and crashes never leave a broken entry behind.
+class TextureCache {
+private:
+    std::filesystem::path directory;
+
+    std::atomic<std::uint32_t> hit_count = 0;
+    std::atomic<std::uint32_t> miss_count = 0;
+
+public:
+    /// @brief Creates the cache directory if it does not exist yet.
+    /// @param directory [in] The cache directory.
+    explicit TextureCache(const std::filesystem::path &directory);
+
+    TextureCache(const TextureCache &) = delete;
+    TextureCache(TextureCache &&) = delete;
+
+    TextureCache &operator=(const TextureCache &) = delete;
+    TextureCache &operator=(TextureCache &&) = delete;
+
+    /// @brief Returns the cache entry of a texture file, which is created from the file if it does not exist yet.
+    /// @param source_file_name [in] The texture file, e.g. a JPG or PNG file.
+    /// @exception std::runtime_error The texture file could not be loaded. If only the cache entry could not be
+    /// written, the exception is thrown as well, so the caller can fall back to loading the texture file directly.
+    [[nodiscard]] Ktx2File load(const std::filesystem::path &source_file_name);
+
+    /// @brief Returns the number of textures which have been loaded from an existing cache entry.
+    [[nodiscard]] std::uint32_t get_hit_count() const {
+        return hit_count.load();
+    }
+
+    /// @brief Returns the number of textures whose cache entry had to be created.
+    [[nodiscard]] std::uint32_t get_miss_count() const {
+        return miss_count.load();
+    }
+};
+
+} // namespace inexor::vulkan_renderer::io
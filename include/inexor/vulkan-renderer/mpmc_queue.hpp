@@ -0,0 +1,141 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace inexor {
+
+/// @brief A bounded lock-free multi-producer/multi-consumer queue.
+/// This is Dmitry Vyukov's ring buffer queue: every cell carries a sequence number which tells producers and
+/// consumers whether the cell is free to be written or ready to be read. Pushing and popping only need a single
+/// compare-and-swap on the shared position in the common case and never block.
+/// It is used to hand over work and resources (decoded textures, meshes, upload requests) between threads.
+/// @tparam T The type of the elements. T must be default constructible and move assignable.
+template <typename T>
+class MPMCQueue {
+private:
+    static constexpr std::size_t CACHE_LINE_SIZE = 64;
+
+    struct alignas(CACHE_LINE_SIZE) Cell {
+        std::atomic<std::size_t> sequence;
+        T data;
+    };
+
+    std::unique_ptr<Cell[]> buffer;
+
+    std::size_t buffer_mask = 0;
+
+    // Producers and consumers work on different cache lines.
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> enqueue_position = 0;
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> dequeue_position = 0;
+
+public:
+    /// @brief Creates an empty queue.
+    /// @param capacity [in] The maximum number of elements in the queue. Must be a power of two and at least 2.
+    explicit MPMCQueue(const std::size_t capacity) {
+        if (capacity < 2 || (capacity & (capacity - 1)) != 0) {
+            throw std::runtime_error("Error: The capacity of a MPMC queue must be a power of two!");
+        }
+
+        buffer = std::make_unique<Cell[]>(capacity);
+        buffer_mask = capacity - 1;
+
+        for (std::size_t i = 0; i < capacity; i++) {
+            buffer[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    /// Delete the copy constructor so queues are neither copyable nor movable, as other threads might access them.
+    MPMCQueue(const MPMCQueue &) = delete;
+    MPMCQueue(MPMCQueue &&) = delete;
+
+    MPMCQueue &operator=(const MPMCQueue &) = delete;
+    MPMCQueue &operator=(MPMCQueue &&) = delete;
+
+    ~MPMCQueue() = default;
+
+    /// @brief Tries to append an element to the queue.
+    /// @param value [in] The element to append.
+    /// @return False if the queue is full, in which case value is not moved from.
+    template <typename U>
+    [[nodiscard]] bool try_push(U &&value) {
+        Cell *cell = nullptr;
+        std::size_t position = enqueue_position.load(std::memory_order_relaxed);
+
+        while (true) {
+            cell = &buffer[position & buffer_mask];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+            if (difference == 0) {
+                // The cell is free, try to claim it.
+                if (enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                // The cell still contains an element from the previous round: the queue is full.
+                return false;
+            } else {
+                // Another producer claimed the cell in the meantime.
+                position = enqueue_position.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->data = std::forward<U>(value);
+        cell->sequence.store(position + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /// @brief Tries to take the oldest element out of the queue.
+    /// @param value [out] The element which was taken out of the queue.
+    /// @return False if the queue is empty.
+    [[nodiscard]] bool try_pop(T &value) {
+        Cell *cell = nullptr;
+        std::size_t position = dequeue_position.load(std::memory_order_relaxed);
+
+        while (true) {
+            cell = &buffer[position & buffer_mask];
+            const std::size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            const auto difference = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position + 1);
+
+            if (difference == 0) {
+                // The cell contains an element, try to claim it.
+                if (dequeue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                // The cell has not been written yet: the queue is empty.
+                return false;
+            } else {
+                // Another consumer claimed the cell in the meantime.
+                position = dequeue_position.load(std::memory_order_relaxed);
+            }
+        }
+
+        value = std::move(cell->data);
+
+        // Leave a moved-from element behind so resources are released right away.
+        cell->data = T{};
+        cell->sequence.store(position + buffer_mask + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    [[nodiscard]] std::size_t capacity() const {
+        return buffer_mask + 1;
+    }
+
+    /// @brief Returns the number of elements in the queue.
+    /// @note The result is only approximate if other threads access the queue at the same time.
+    [[nodiscard]] std::size_t size_approx() const {
+        const std::size_t enqueued = enqueue_position.load(std::memory_order_relaxed);
+        const std::size_t dequeued = dequeue_position.load(std::memory_order_relaxed);
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+};
+
+} // namespace inexor
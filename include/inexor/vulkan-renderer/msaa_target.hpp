@@ -1,17 +0,0 @@
-#pragma once
-
-#include "inexor/vulkan-renderer/wrapper/image.hpp"
-
-#include <memory>
-
-namespace inexor::vulkan_renderer {
-
-struct MSAATarget {
-    // The color buffer.
-    std::unique_ptr<wrapper::Image> color;
-
-    // The depth buffer.
-    std::unique_ptr<wrapper::Image> depth;
-};
-
-} // namespace inexor::vulkan_renderer
@@ -0,0 +1,88 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/thread_pool.hpp"
+#include "inexor/vulkan-renderer/wrapper/command_buffer.hpp"
+#include "inexor/vulkan-renderer/wrapper/command_pool.hpp"
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace inexor::vulkan_renderer {
+
+/// @brief Records the draw calls of a render stage into secondary command buffers on several threads.
+/// The draws are split into contiguous ranges, one for every recording slot. The calling thread records the first
+/// range itself while the threadpool records the others as frame-critical tasks. Command pools must not be used by
+/// several threads at the same time, so every slot has its own command pool for every frame in flight.
+class ParallelCommandRecorder {
+public:
+    /// @brief Records a range of draws into a secondary command buffer.
+    /// The command buffer is in recording state and continues the render pass of the inheritance info. No other state
+    /// is inherited, so the function has to bind the pipeline, the descriptor sets and so on by itself.
+    /// @note The function is called from several threads at the same time.
+    using RecordFunction =
+        std::function<void(VkCommandBuffer command_buffer, std::uint32_t first_draw, std::uint32_t draw_count)>;
+
+private:
+    VkDevice device;
+
+    std::shared_ptr<ThreadPool> thread_pool;
+
+    std::uint32_t thread_count;
+
+    /// The command pools of all slots, indexed by [frame][slot].
+    std::vector<std::vector<wrapper::CommandPool>> command_pools;
+
+    /// One secondary command buffer for every command pool, indexed by [frame][slot].
+    std::vector<std::vector<wrapper::CommandBuffer>> command_buffers;
+
+    std::uint32_t current_frame = 0;
+
+public:
+    /// @brief Creates the command pools and allocates the secondary command buffers.
+    /// @param device [in] The Vulkan device.
+    /// @param queue_family_index [in] The queue family the primary command buffers are submitted to.
+    /// @param thread_pool [in] The threadpool which records the draw ranges.
+    /// @param frame_count [in] The number of frames in flight.
+    /// @param thread_count [in] The maximum number of threads which record at the same time, including the calling
+    /// thread. If this is 1, everything is recorded on the calling thread.
+    ParallelCommandRecorder(VkDevice device, std::uint32_t queue_family_index, std::shared_ptr<ThreadPool> thread_pool,
+                            std::uint32_t frame_count, std::uint32_t thread_count);
+
+    /// Delete the copy constructor so parallel command recorders are move-only objects.
+    ParallelCommandRecorder(const ParallelCommandRecorder &) = delete;
+    ParallelCommandRecorder(ParallelCommandRecorder &&) noexcept = default;
+
+    /// Delete the copy assignment operator so parallel command recorders are move-only objects.
+    ParallelCommandRecorder &operator=(const ParallelCommandRecorder &) = delete;
+    ParallelCommandRecorder &operator=(ParallelCommandRecorder &&) noexcept = default;
+
+    ~ParallelCommandRecorder() = default;
+
+    /// @brief Resets the command pools of a frame in flight, so its command buffers can be recorded again.
+    /// @param frame_index [in] The index of the frame in flight.
+    /// @warning The device must have finished executing the command buffers of this frame, e.g. by waiting for the
+    /// frame's fence.
+    void begin_frame(std::uint32_t frame_index);
+
+    /// @brief Records draws into the secondary command buffers of the current frame.
+    /// @param inheritance_info [in] The render pass and framebuffer the command buffers are executed in.
+    /// @param draw_count [in] The total number of draws.
+    /// @param record_function [in] The function which records a range of draws.
+    /// @return The secondary command buffers in the order of their draw ranges, allocated from the frame arena of the
+    /// calling thread.
+    /// @throws std::runtime_error If a command buffer could not be recorded.
+    [[nodiscard]] std::pmr::vector<VkCommandBuffer> record(const VkCommandBufferInheritanceInfo &inheritance_info,
+                                                           std::uint32_t draw_count,
+                                                           const RecordFunction &record_function);
+
+    [[nodiscard]] std::uint32_t get_thread_count() const {
+        return thread_count;
+    }
+};
+
+} // namespace inexor::vulkan_renderer
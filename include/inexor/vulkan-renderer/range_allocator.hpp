@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+
+namespace inexor::vulkan_renderer {
+
+/// @brief Sub-allocates contiguous ranges from a fixed number of elements, e.g. the vertices of a large vertex buffer.
+/// The free ranges are sorted by their offset. An allocation takes the first free range which is large enough, and a
+/// freed range is merged with its free neighbours, so the elements don't fragment when ranges of different sizes are
+/// allocated and freed over and over again.
+/// @note This class is not thread safe.
+class RangeAllocator {
+private:
+    std::uint32_t capacity;
+    std::uint32_t free_count;
+
+    /// The offset and the size of every free range.
+    std::map<std::uint32_t, std::uint32_t> free_ranges;
+
+public:
+    /// @param capacity [in] The number of elements which ranges are allocated from.
+    explicit RangeAllocator(std::uint32_t capacity);
+
+    /// @brief Allocates a contiguous range of elements.
+    /// @param count [in] The number of elements, which must not be 0.
+    /// @return The offset of the first element, or std::nullopt if there is no free range which is large enough.
+    [[nodiscard]] std::optional<std::uint32_t> allocate(std::uint32_t count);
+
+    /// @brief Frees a range which has been returned by allocate().
+    /// @param offset [in] The offset of the range.
+    /// @param count [in] The number of elements which have been allocated.
+    void free(std::uint32_t offset, std::uint32_t count);
+
+    [[nodiscard]] std::uint32_t get_capacity() const {
+        return capacity;
+    }
+
+    /// @brief Returns the number of free elements, which might be split into several ranges.
+    [[nodiscard]] std::uint32_t get_free_count() const {
+        return free_count;
+    }
+
+    /// @brief Returns the number of free ranges.
+    [[nodiscard]] std::size_t get_free_range_count() const {
+        return free_ranges.size();
+    }
+};
+
+} // namespace inexor::vulkan_renderer
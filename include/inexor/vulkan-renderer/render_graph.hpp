@@ -0,0 +1,404 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/deletion_queue.hpp"
+#include "inexor/vulkan-renderer/wrapper/framebuffer.hpp"
+#include "inexor/vulkan-renderer/wrapper/renderpass.hpp"
+
+#include <vma/vk_mem_alloc.h>
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace inexor::vulkan_renderer {
+
+class RenderGraph;
+
+/// @brief The kind of image a texture resource describes.
+enum class TextureUsage {
+    /// The image which is presented (or read back in headless mode). It is not owned by the render graph.
+    BACK_BUFFER,
+
+    /// A color image which is owned by the render graph.
+    COLOR,
+
+    /// A depth (and stencil) image which is owned by the render graph.
+    DEPTH_STENCIL,
+};
+
+/// @brief Something render stages read from or write to.
+class RenderResource {
+private:
+    std::string name;
+
+public:
+    explicit RenderResource(std::string name) : name(std::move(name)) {}
+
+    /// Delete the copy constructor so render resources are move-only objects.
+    RenderResource(const RenderResource &) = delete;
+    RenderResource(RenderResource &&) noexcept = default;
+
+    /// Delete the copy assignment operator so render resources are move-only objects.
+    RenderResource &operator=(const RenderResource &) = delete;
+    RenderResource &operator=(RenderResource &&) noexcept = default;
+
+    virtual ~RenderResource() = default;
+
+    [[nodiscard]] const std::string &get_name() const {
+        return name;
+    }
+};
+
+/// @brief A two dimensional image which has the size of the render graph's back buffer.
+/// Except for the back buffer, textures are transient: they are created by the render graph, only exist from the
+/// first to the last stage which uses them during a frame, and share memory with other textures which are not alive
+/// at the same time. Exported textures are the exception, see set_exported().
+class TextureResource : public RenderResource {
+    friend RenderGraph;
+
+private:
+    TextureUsage usage;
+    VkFormat format = VK_FORMAT_UNDEFINED;
+    VkSampleCountFlagBits sample_count = VK_SAMPLE_COUNT_1_BIT;
+    bool exported = false;
+
+public:
+    TextureResource(std::string name, const TextureUsage usage) : RenderResource(std::move(name)), usage(usage) {}
+
+    /// @brief Sets the format of the texture. This must be called before the render graph is compiled.
+    void set_format(const VkFormat format) {
+        this->format = format;
+    }
+
+    /// @brief Sets the number of samples per pixel, e.g. for multisampled render targets.
+    void set_sample_count(const VkSampleCountFlagBits sample_count) {
+        this->sample_count = sample_count;
+    }
+
+    /// @brief Keeps the content of the texture after the last stage which uses it, so it can be read outside of the
+    /// render graph after record(), e.g. by a compute shader. At the end of the frame, the texture is transitioned into
+    /// VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL for reads in compute shaders. Its memory is never shared with other
+    /// textures. This must be called before the render graph is compiled.
+    void set_exported(const bool exported) {
+        this->exported = exported;
+    }
+
+    [[nodiscard]] TextureUsage get_usage() const {
+        return usage;
+    }
+
+    [[nodiscard]] VkFormat get_format() const {
+        return format;
+    }
+};
+
+/// @brief A graphics pass of the render graph, which is recorded inside of its own render pass.
+/// Stages only declare which textures they read and write. The render graph derives the order of the stages, the
+/// image layout transitions and the pipeline barriers in between from those declarations.
+class RenderStage {
+    friend RenderGraph;
+
+private:
+    /// @brief How a stage accesses a texture.
+    enum class TextureAccess {
+        ATTACHMENT,
+        RESOLVE_ATTACHMENT,
+        SAMPLED,
+    };
+
+    struct TextureAccessInfo {
+        const TextureResource *texture;
+        TextureAccess access;
+
+        /// The color attachment which is resolved into this texture (only for resolve attachments).
+        const TextureResource *resolve_source = nullptr;
+
+        std::optional<VkClearValue> clear_value;
+    };
+
+    std::string name;
+    std::vector<TextureAccessInfo> accesses;
+    std::function<void(VkCommandBuffer)> on_record;
+    std::function<std::pmr::vector<VkCommandBuffer>(const VkCommandBufferInheritanceInfo &)> on_record_secondary;
+
+    [[nodiscard]] const TextureAccessInfo *find_access(const TextureResource *texture) const;
+
+public:
+    explicit RenderStage(std::string name) : name(std::move(name)) {}
+
+    /// Delete the copy constructor so render stages are move-only objects.
+    RenderStage(const RenderStage &) = delete;
+    RenderStage(RenderStage &&) noexcept = default;
+
+    /// Delete the copy assignment operator so render stages are move-only objects.
+    RenderStage &operator=(const RenderStage &) = delete;
+    RenderStage &operator=(RenderStage &&) noexcept = default;
+
+    ~RenderStage() = default;
+
+    /// @brief Declares that this stage renders into a texture.
+    /// @param texture [in] The color, depth or back buffer texture.
+    /// @param clear_value [in] The value the texture is cleared to at the beginning of the stage. If no value is
+    /// given, the texture's content is kept if an earlier stage wrote to it.
+    void writes_to(const TextureResource *texture, std::optional<VkClearValue> clear_value = std::nullopt);
+
+    /// @brief Declares that a multisampled color texture of this stage is resolved into another texture.
+    /// @param source [in] The multisampled texture, which must have been passed to writes_to() before.
+    /// @param target [in] The single sampled texture to resolve into.
+    void resolves_to(const TextureResource *source, const TextureResource *target);
+
+    /// @brief Declares that this stage samples a texture in its fragment shader.
+    /// @param texture [in] The texture, which must be written by another stage.
+    void reads_from(const TextureResource *texture);
+
+    /// @brief Sets the function which records the stage's commands inside of the stage's render pass.
+    void set_on_record(std::function<void(VkCommandBuffer)> on_record) {
+        this->on_record = std::move(on_record);
+    }
+
+    /// @brief Sets the function which records the stage's commands into secondary command buffers.
+    /// The function receives the inheritance info of the stage's render pass and framebuffer and returns the
+    /// secondary command buffers, which are executed in the given order. If this function is set, it is used instead
+    /// of the one passed to set_on_record().
+    void set_on_record_secondary(
+        std::function<std::pmr::vector<VkCommandBuffer>(const VkCommandBufferInheritanceInfo &)> on_record_secondary) {
+        this->on_record_secondary = std::move(on_record_secondary);
+    }
+
+    [[nodiscard]] const std::string &get_name() const {
+        return name;
+    }
+};
+
+/// @brief A frame graph which turns render stages into render passes, barriers and images.
+/// The graph is used in three steps:
+/// 1. Add textures and stages with add() and declare what every stage reads and writes.
+/// 2. Call compile() once. This orders the stages, removes stages which do not contribute to the back buffer and
+/// creates one render pass per stage, so graphics pipelines can be created for them.
+/// 3. Call create_physical_resources() whenever the back buffer images change, e.g. after the swapchain has been
+/// recreated. This creates the transient images and the framebuffers.
+/// Afterwards, record() records all stages into a command buffer.
+class RenderGraph {
+private:
+    /// @brief A transient image without memory of its own, as its memory might be shared with other images.
+    class PhysicalImage {
+    private:
+        VkDevice device;
+
+    public:
+        VkImage image = VK_NULL_HANDLE;
+        VkImageView image_view = VK_NULL_HANDLE;
+
+        explicit PhysicalImage(const VkDevice device) : device(device) {}
+
+        /// Delete the copy constructor so physical images are move-only objects.
+        PhysicalImage(const PhysicalImage &) = delete;
+        PhysicalImage(PhysicalImage &&other) noexcept;
+
+        /// Delete the copy assignment operator so physical images are move-only objects.
+        PhysicalImage &operator=(const PhysicalImage &) = delete;
+        PhysicalImage &operator=(PhysicalImage &&) = delete;
+
+        ~PhysicalImage();
+    };
+
+    /// @brief A block of device memory which one or more transient images are bound to.
+    class MemoryBlock {
+    private:
+        VmaAllocator vma_allocator;
+
+    public:
+        VmaAllocation allocation = VK_NULL_HANDLE;
+
+        explicit MemoryBlock(const VmaAllocator vma_allocator) : vma_allocator(vma_allocator) {}
+
+        /// Delete the copy constructor so memory blocks are move-only objects.
+        MemoryBlock(const MemoryBlock &) = delete;
+        MemoryBlock(MemoryBlock &&other) noexcept;
+
+        /// Delete the copy assignment operator so memory blocks are move-only objects.
+        MemoryBlock &operator=(const MemoryBlock &) = delete;
+        MemoryBlock &operator=(MemoryBlock &&) = delete;
+
+        ~MemoryBlock();
+    };
+
+    /// @brief The layout of a texture and the pipeline stages and accesses which used it last.
+    struct TextureState {
+        VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+        VkPipelineStageFlags stage_mask = 0;
+        VkAccessFlags access_mask = 0;
+    };
+
+    /// @brief An image layout transition or memory dependency of a texture which is recorded before a stage.
+    struct TextureBarrier {
+        const TextureResource *texture;
+        TextureState old_state;
+        TextureState new_state;
+    };
+
+    /// @brief Everything compile() and create_physical_resources() derived for one stage.
+    struct PhysicalStage {
+        const RenderStage *stage;
+
+        /// The textures in the order of the render pass attachments.
+        std::vector<const TextureResource *> attachments;
+        std::vector<VkClearValue> clear_values;
+        std::vector<TextureBarrier> barriers;
+
+        std::unique_ptr<wrapper::RenderPass> render_pass;
+
+        /// One framebuffer per back buffer image.
+        std::unique_ptr<wrapper::Framebuffer> framebuffer;
+    };
+
+    /// @brief The first and the last index (in the order of stages) of the stages which use a texture.
+    struct TextureLifetime {
+        std::size_t first_stage;
+        std::size_t last_stage;
+    };
+
+    VkDevice device;
+    VmaAllocator vma_allocator;
+
+    std::vector<std::unique_ptr<TextureResource>> textures;
+    std::vector<std::unique_ptr<RenderStage>> stages;
+
+    const TextureResource *back_buffer = nullptr;
+    VkImageLayout back_buffer_final_layout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    /// The stages which contribute to the back buffer, ordered so that every stage comes after the stages it
+    /// depends on.
+    std::vector<PhysicalStage> physical_stages;
+
+    std::unordered_map<const TextureResource *, TextureLifetime> lifetimes;
+    std::unordered_map<const TextureResource *, VkImageUsageFlags> image_usages;
+
+    /// The barrier which transitions the back buffer into its final layout after the last stage.
+    std::optional<TextureBarrier> back_buffer_final_barrier;
+
+    /// The barriers which make the exported textures readable after the last stage.
+    std::vector<TextureBarrier> export_barriers;
+
+    // Created by create_physical_resources().
+    VkExtent2D extent = {};
+    std::vector<VkImage> back_buffer_images;
+    std::vector<VkImageView> back_buffer_image_views;
+    std::unordered_map<const TextureResource *, PhysicalImage> physical_images;
+    std::vector<MemoryBlock> memory_blocks;
+    VkDeviceSize transient_memory_size = 0;
+
+    /// @brief Returns the layout, pipeline stages and accesses a stage needs for a texture.
+    [[nodiscard]] static TextureState get_required_state(const RenderStage::TextureAccessInfo &access);
+
+    /// @brief Returns the state of exported textures at the end of the frame.
+    [[nodiscard]] static TextureState get_export_state();
+
+    /// @brief Orders the stages which the back buffer depends on.
+    /// @throws std::runtime_error If the dependencies of the stages contain a cycle.
+    void sort_stages();
+
+    /// @brief Determines the lifetime and the image usage flags of every texture.
+    void collect_texture_usages();
+
+    /// @brief Creates the render pass and the barriers of every stage.
+    void create_render_passes();
+
+    /// @brief Creates the transient images and binds them to (possibly shared) memory blocks.
+    void create_transient_images();
+
+    /// @brief Returns the image or the back buffer image for a texture.
+    [[nodiscard]] VkImage get_image(const TextureResource *texture, std::uint32_t back_buffer_index) const;
+
+    /// @brief Returns the image view or the back buffer image view for a texture.
+    [[nodiscard]] VkImageView get_image_view(const TextureResource *texture, std::uint32_t back_buffer_index) const;
+
+    void record_barriers(VkCommandBuffer command_buffer, const TextureBarrier *barriers, std::size_t barrier_count,
+                         std::uint32_t back_buffer_index) const;
+
+public:
+    /// @param device [in] The Vulkan device.
+    /// @param vma_allocator [in] The Vulkan Memory Allocator library handle, used for transient images.
+    RenderGraph(VkDevice device, VmaAllocator vma_allocator);
+
+    /// Delete the copy constructor so render graphs are move-only objects.
+    RenderGraph(const RenderGraph &) = delete;
+    RenderGraph(RenderGraph &&) = delete;
+
+    /// Delete the copy assignment operator so render graphs are move-only objects.
+    RenderGraph &operator=(const RenderGraph &) = delete;
+    RenderGraph &operator=(RenderGraph &&) = delete;
+
+    ~RenderGraph();
+
+    /// @brief Adds a texture or a stage to the render graph.
+    /// @tparam T Either TextureResource or RenderStage.
+    /// @param args [in] The constructor arguments of T.
+    /// @return A pointer to the new texture or stage, which is valid for the lifetime of the render graph.
+    template <typename T, typename... Args>
+    T *add(Args &&... args) {
+        static_assert(std::is_same_v<T, TextureResource> || std::is_same_v<T, RenderStage>,
+                      "Only textures and render stages can be added to a render graph!");
+
+        auto object = std::make_unique<T>(std::forward<Args>(args)...);
+        T *pointer = object.get();
+
+        if constexpr (std::is_same_v<T, TextureResource>) {
+            textures.push_back(std::move(object));
+        } else {
+            stages.push_back(std::move(object));
+        }
+
+        return pointer;
+    }
+
+    /// @brief Orders the stages and creates their render passes.
+    /// @param target [in] The back buffer texture. Stages which do not contribute to it are not recorded.
+    /// @param target_final_layout [in] The layout the back buffer is transitioned to after the last stage.
+    /// @throws std::runtime_error If the render graph is invalid.
+    void compile(const TextureResource *target, VkImageLayout target_final_layout);
+
+    /// @brief (Re)creates the transient images and the framebuffers.
+    /// @param extent [in] The size of the back buffer images, which is also the size of all other textures.
+    /// @param back_buffer_images [in] The back buffer images, e.g. the swapchain images.
+    /// @param back_buffer_image_views [in] The image views of the back buffer images.
+    /// @param deletion_queue [in] The previous images and framebuffers are destroyed through this queue, as frames
+    /// which are still in flight might use them.
+    void create_physical_resources(VkExtent2D extent, const std::vector<VkImage> &back_buffer_images,
+                                   const std::vector<VkImageView> &back_buffer_image_views,
+                                   DeletionQueue &deletion_queue);
+
+    /// @brief Records all stages, including the barriers between them, into a command buffer.
+    /// @param command_buffer [in] The command buffer, which must be in recording state.
+    /// @param back_buffer_index [in] The index of the back buffer image to render into.
+    void record(VkCommandBuffer command_buffer, std::uint32_t back_buffer_index) const;
+
+    /// @brief Returns the render pass of a stage, which is needed to create graphics pipelines for the stage.
+    /// @throws std::runtime_error If the stage was not compiled.
+    [[nodiscard]] VkRenderPass get_render_pass(const RenderStage *stage) const;
+
+    /// @brief Returns the image of an exported texture, see TextureResource::set_exported().
+    /// The image is replaced by create_physical_resources().
+    /// @throws std::runtime_error If the texture is not exported or not used by any stage.
+    [[nodiscard]] VkImage get_exported_image(const TextureResource *texture) const;
+
+    /// @brief Returns the image view of an exported texture, which only has the depth aspect for depth buffers.
+    /// The image view is replaced by create_physical_resources().
+    /// @throws std::runtime_error If the texture is not exported or not used by any stage.
+    [[nodiscard]] VkImageView get_exported_image_view(const TextureResource *texture) const;
+
+    /// @brief Returns the total size of the memory blocks which the transient images are bound to in bytes.
+    [[nodiscard]] VkDeviceSize get_transient_memory_size() const {
+        return transient_memory_size;
+    }
+};
+
+} // namespace inexor::vulkan_renderer
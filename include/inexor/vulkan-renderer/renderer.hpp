@@ -2,24 +2,35 @@
 
 #include "inexor/vulkan-renderer/availability_checks.hpp"
 #include "inexor/vulkan-renderer/camera.hpp"
+#include "inexor/vulkan-renderer/chunk_culler.hpp"
+#include "inexor/vulkan-renderer/deletion_queue.hpp"
 #include "inexor/vulkan-renderer/fps_counter.hpp"
 #include "inexor/vulkan-renderer/gpu_info.hpp"
-#include "inexor/vulkan-renderer/msaa_target.hpp"
+#include "inexor/vulkan-renderer/io/texture_cache.hpp"
+#include "inexor/vulkan-renderer/parallel_command_recorder.hpp"
+#include "inexor/vulkan-renderer/render_graph.hpp"
 #include "inexor/vulkan-renderer/settings_decision_maker.hpp"
+#include "inexor/vulkan-renderer/thread_pool.hpp"
 #include "inexor/vulkan-renderer/time_step.hpp"
+#include "inexor/vulkan-renderer/upload_manager.hpp"
 
 // Those components have been refactored to fulfill RAII idioms.
+#include "inexor/vulkan-renderer/wrapper/bindless_texture_array.hpp"
+#include "inexor/vulkan-renderer/wrapper/chunk_mesh_buffer.hpp"
 #include "inexor/vulkan-renderer/wrapper/command_buffer.hpp"
 #include "inexor/vulkan-renderer/wrapper/command_pool.hpp"
-#include "inexor/vulkan-renderer/wrapper/descriptor.hpp"
+#include "inexor/vulkan-renderer/wrapper/descriptor_allocator.hpp"
+#include "inexor/vulkan-renderer/wrapper/descriptor_layout_cache.hpp"
 #include "inexor/vulkan-renderer/wrapper/device.hpp"
 #include "inexor/vulkan-renderer/wrapper/fence.hpp"
 #include "inexor/vulkan-renderer/wrapper/framebuffer.hpp"
 #include "inexor/vulkan-renderer/wrapper/glfw_context.hpp"
 #include "inexor/vulkan-renderer/wrapper/graphics_pipeline.hpp"
 #include "inexor/vulkan-renderer/wrapper/image.hpp"
+#include "inexor/vulkan-renderer/wrapper/indirect_draw_buffer.hpp"
 #include "inexor/vulkan-renderer/wrapper/instance.hpp"
 #include "inexor/vulkan-renderer/wrapper/mesh_buffer.hpp"
+#include "inexor/vulkan-renderer/wrapper/pipeline_cache.hpp"
 #include "inexor/vulkan-renderer/wrapper/pipeline_layout.hpp"
 #include "inexor/vulkan-renderer/wrapper/renderpass.hpp"
 #include "inexor/vulkan-renderer/wrapper/semaphore.hpp"
@@ -27,22 +38,50 @@
 #include "inexor/vulkan-renderer/wrapper/swapchain.hpp"
 #include "inexor/vulkan-renderer/wrapper/texture.hpp"
 #include "inexor/vulkan-renderer/wrapper/uniform_buffer.hpp"
+#include "inexor/vulkan-renderer/wrapper/uniform_ring_buffer.hpp"
 #include "inexor/vulkan-renderer/wrapper/vma.hpp"
 #include "inexor/vulkan-renderer/wrapper/window.hpp"
 #include "inexor/vulkan-renderer/wrapper/window_surface.hpp"
 
+#include <glm/glm.hpp>
 #include <vulkan/vulkan_core.h>
 
+#include <array>
 #include <cstdint>
 #include <memory>
+#include <optional>
 #include <vector>
 
 namespace inexor::vulkan_renderer {
 
+// Coroutine support is optional and requires C++20, so task.hpp is only included by the engine's sources.
+class FenceWaiter;
+
 // The maximum number of images to process simultaneously.
 // TODO: Refactoring! That is triple buffering essentially!
 constexpr unsigned int MAX_FRAMES_IN_FLIGHT = 2;
 
+// The default number of threads which record the secondary command buffers of a render stage.
+constexpr std::uint32_t DEFAULT_RECORDING_THREAD_COUNT = 4;
+
+// The maximum time in seconds the main loop sleeps waiting for window events while the window is minimized.
+constexpr double MINIMIZED_WINDOW_EVENT_TIMEOUT = 0.1;
+
+// The number of bytes of uniform data every frame in flight can allocate from the uniform ring buffer.
+constexpr VkDeviceSize UNIFORM_RING_BUFFER_FRAME_SIZE = 1024 * 1024;
+
+// The size of the persistently mapped staging buffer which texture and mesh uploads are sub-allocated from.
+constexpr VkDeviceSize STAGING_RING_BUFFER_SIZE = 32 * 1024 * 1024;
+
+// The file the pipeline cache is stored in between runs.
+constexpr const char *PIPELINE_CACHE_FILE_NAME = "pipeline_cache.bin";
+
+// The directory decoded and mipmapped textures are cached in between runs.
+constexpr const char *TEXTURE_CACHE_DIRECTORY = "texture_cache";
+
+// The color format of the offscreen render targets in headless mode.
+constexpr VkFormat HEADLESS_COLOR_FORMAT = VK_FORMAT_R8G8B8A8_UNORM;
+
 class VulkanRenderer {
 protected:
     // We try to avoid inheritance here and prefer a composition pattern.
@@ -64,6 +103,7 @@ protected:
 
     std::vector<VkPipelineShaderStageCreateInfo> shader_stages;
 
+    /// The primary command buffers, one per frame in flight. They are recorded again every frame.
     std::vector<wrapper::CommandBuffer> command_buffers;
 
     std::vector<wrapper::Semaphore> image_available_semaphores;
@@ -72,6 +112,15 @@ protected:
 
     std::vector<wrapper::Fence> in_flight_fences;
 
+    /// Destroys objects which are replaced at runtime once the frames which might use them have finished.
+    DeletionQueue deletion_queue;
+
+    /// The deletion queue's number of the frame which was submitted last for every frame in flight.
+    std::array<std::uint64_t, MAX_FRAMES_IN_FLIGHT> in_flight_frame_numbers{};
+
+    /// True if the swapchain could not be recreated because the window is minimized.
+    bool swapchain_recreation_pending = false;
+
     VkDebugReportCallbackEXT debug_report_callback = {};
 
     bool debug_report_callback_initialised = false;
@@ -89,29 +138,61 @@ protected:
     FPSCounter fps_counter;
 
     // TODO: Refactor this!
-    VkDescriptorBufferInfo uniform_buffer_info = {};
+    VkDescriptorBufferInfo pass_uniform_buffer_info = {};
     VkDescriptorImageInfo image_info = {};
-    VkPipelineCache pipeline_cache;
+
+    /// The pipeline cache, which is loaded from PIPELINE_CACHE_FILE_NAME at startup and saved there on shutdown.
+    std::unique_ptr<wrapper::PipelineCache> pipeline_cache;
+
+    /// The texture cache in TEXTURE_CACHE_DIRECTORY, or nullptr if it is disabled.
+    std::unique_ptr<io::TextureCache> texture_cache;
 
     // TODO: Read from TOML configuration file and pass value to core engine.
     bool multisampling_enabled = true;
 
     VkSampleCountFlagBits multisampling_sample_count = VK_SAMPLE_COUNT_4_BIT;
 
-    MSAATarget msaa_target_buffer;
-
     bool vsync_enabled = false;
 
     Camera game_camera;
 
     std::vector<wrapper::Shader> shaders;
     std::vector<wrapper::Texture> textures;
-    std::vector<wrapper::UniformBuffer> uniform_buffers;
     std::vector<wrapper::MeshBuffer> mesh_buffers;
-    std::vector<wrapper::Descriptor> descriptors;
 
-    // TODO(Hanni): Remove this with RAII refactoring of descriptors!
-    VkDescriptorImageInfo descriptor_image_info = {};
+    /// Creates every distinct descriptor set layout once.
+    std::unique_ptr<wrapper::DescriptorLayoutCache> descriptor_layout_cache;
+
+    /// Allocates the descriptor sets which live as long as the renderer.
+    std::unique_ptr<wrapper::DescriptorAllocator> descriptor_allocator;
+
+    /// Allocates the descriptor sets which are only used by one frame in flight, one allocator per frame in flight.
+    /// All sets of a frame are freed at once when the frame is recorded again.
+    std::vector<std::unique_ptr<wrapper::DescriptorAllocator>> frame_descriptor_allocators;
+
+    /// The layout of descriptor set 0, which holds the pass uniform data.
+    VkDescriptorSetLayout uniform_descriptor_set_layout = VK_NULL_HANDLE;
+
+    /// Descriptor set 0, which is bound with the dynamic offset of the pass uniform data.
+    VkDescriptorSet uniform_descriptor_set = VK_NULL_HANDLE;
+
+    /// The uniform data of all passes, sub-allocated per frame in flight.
+    std::unique_ptr<wrapper::UniformRingBuffer> uniform_ring_buffer;
+
+    /// The dynamic offset of the current frame's PassUniformBufferObject in the uniform ring buffer.
+    std::uint32_t pass_uniform_offset = 0;
+
+    /// The projection matrix times the view matrix of the current frame, as the shaders use them.
+    glm::mat4 view_projection{1.0f};
+
+    /// The model matrix of the octree, which is passed to every draw as push constant.
+    glm::mat4 octree_model_matrix{1.0f};
+
+    /// All textures, bound as descriptor set 1. Draws select their texture by its index in the array.
+    std::unique_ptr<wrapper::BindlessTextureArray> texture_array;
+
+    /// The index of the octree's texture in the texture array.
+    std::uint32_t octree_texture_index = 0;
 
     // RAII wrapper for VkInstance.
     std::unique_ptr<wrapper::Instance> vkinstance = nullptr;
@@ -125,6 +206,9 @@ protected:
     // RAII wrapper for Vulkan Memory Allocator.
     std::unique_ptr<wrapper::VulkanMemoryAllocator> vma = nullptr;
 
+    /// Uploads textures and meshes on the data transfer queue.
+    std::unique_ptr<UploadManager> upload_manager;
+
     // RAII wrapper for glfw windows.
     std::unique_ptr<wrapper::Window> window = nullptr;
 
@@ -134,20 +218,119 @@ protected:
     /// RAII wrapper for glfw contexts.
     std::unique_ptr<wrapper::GLFWContext> glfw_context = nullptr;
 
-    /// RAII wrapper for command pools.
-    std::unique_ptr<wrapper::CommandPool> command_pool = nullptr;
+    /// RAII wrapper for command pools, one per frame in flight. A pool is reset before its frame is recorded.
+    std::vector<wrapper::CommandPool> command_pools;
+
+    // The core concept of paralellization in Inexor is to use a
+    // C++17 threadpool implementation which spawns worker threads.
+    // A task system is used to distribute work over worker threads.
+    // Call thread_pool->execute(); to order new tasks to be worked on.
+    std::shared_ptr<ThreadPool> thread_pool;
+
+    /// @brief Deletes the fence waiter in renderer.cpp, where FenceWaiter is a complete type.
+    struct FenceWaiterDeleter {
+        void operator()(FenceWaiter *fence_waiter) const;
+    };
+
+    /// Resumes coroutines which wait for fences, see wait_for_fence. The fences are checked once every frame.
+    /// This is only created if the engine is built with INEXOR_USE_COROUTINES.
+    std::unique_ptr<FenceWaiter, FenceWaiterDeleter> fence_waiter;
+
+    /// Records the draws of the octree stage into secondary command buffers on the threadpool.
+    std::unique_ptr<ParallelCommandRecorder> octree_recorder;
 
-    std::unique_ptr<wrapper::Image> depth_buffer;
+    /// The number of threads which record the octree stage.
+    std::uint32_t recording_thread_count = DEFAULT_RECORDING_THREAD_COUNT;
 
-    std::unique_ptr<wrapper::Image> depth_stencil;
+    /// The number of chunks the octree world is built from. Every chunk is one draw.
+    std::uint32_t octree_draw_count = 1;
+
+    /// The meshes of all octree chunks, sub-allocated from one vertex buffer and one index buffer.
+    std::unique_ptr<wrapper::ChunkMeshBuffer> chunk_meshes;
+
+    /// The draw commands of the octree chunks, written again for every frame in flight.
+    std::unique_ptr<wrapper::IndirectDrawBuffer> chunk_draw_buffer;
+
+    /// If true, the chunks are drawn with indirect draw calls. Otherwise every chunk is drawn with vkCmdDrawIndexed.
+    bool indirect_drawing_enabled = true;
+
+    /// If true, the number of indirect chunk draws is read from the indirect draw buffer.
+    bool draw_indirect_count_enabled = false;
+
+    /// Culls the chunks against the view frustum and the depth buffer of the previous frame before they are drawn
+    /// indirectly. This is nullptr if the chunks are drawn directly or GPU culling is disabled.
+    std::unique_ptr<ChunkCuller> chunk_culler;
+
+    /// If true, the chunks which are drawn indirectly are culled on the device.
+    bool gpu_culling_enabled = true;
+
+    /// If true, the chunk culler also culls chunks which are hidden behind the depth buffer of the previous frame.
+    bool occlusion_culling_enabled = true;
+
+    /// The number of chunks the device drew and culled in the frame which has finished last.
+    std::optional<ChunkCuller::Stats> chunk_culling_stats;
 
     std::unique_ptr<wrapper::PipelineLayout> pipeline_layout;
 
     std::unique_ptr<wrapper::GraphicsPipeline> graphics_pipeline;
 
-    std::unique_ptr<wrapper::RenderPass> renderpass;
+    /// The render graph, which owns the render passes, framebuffers and transient attachments.
+    std::unique_ptr<RenderGraph> render_graph;
+
+    /// The swapchain image or offscreen image which is rendered into.
+    TextureResource *back_buffer = nullptr;
+
+    /// The depth buffer of the octree stage, which is exported to the chunk culler if occlusion culling is enabled.
+    TextureResource *depth_buffer = nullptr;
+
+    /// The stage which renders the octree.
+    RenderStage *octree_stage = nullptr;
+
+    /// If true, there is no window, surface or swapchain. The renderer draws into offscreen_images instead.
+    bool headless = false;
+
+    /// The color render targets in headless mode, one per frame in flight.
+    std::vector<wrapper::Image> offscreen_images;
+
+    /// Two timestamps (begin and end of the frame's command buffer) for every command buffer.
+    /// This is VK_NULL_HANDLE if the graphics queue does not support timestamps.
+    VkQueryPool timestamp_query_pool = VK_NULL_HANDLE;
 
-    std::unique_ptr<wrapper::Framebuffer> framebuffer;
+    /// The number of nanoseconds per timestamp tick.
+    float timestamp_period = 0.0f;
+
+    /// @brief Returns the color format of the render targets (swapchain images or offscreen images).
+    [[nodiscard]] VkFormat get_color_format() const;
+
+    /// @brief Returns the size of the render targets.
+    [[nodiscard]] VkExtent2D get_render_extent() const;
+
+    /// @brief Returns the number of render targets, which is also the number of command buffers.
+    [[nodiscard]] std::uint32_t get_render_target_count() const;
+
+    /// @brief Returns the name of the draw call which draws the octree chunks.
+    [[nodiscard]] const char *get_chunk_draw_call_name() const;
+
+    /// @brief Records the indirect draws of all octree chunks.
+    /// @param command_buffer [in] The command buffer, which has bound the chunk meshes and the graphics pipeline.
+    void record_indirect_chunk_draws(VkCommandBuffer command_buffer) const;
+
+    /// @brief Returns the images of the render targets.
+    [[nodiscard]] std::vector<VkImage> get_render_target_images() const;
+
+    /// @brief Returns the image views of the render targets.
+    [[nodiscard]] std::vector<VkImageView> get_render_target_views() const;
+
+    /// @brief Creates the offscreen color images for headless mode.
+    VkResult create_offscreen_images();
+
+    /// @brief Creates the timestamp query pool which is used to measure GPU frame times.
+    VkResult create_timestamp_queries();
+
+    /// @brief Reads the GPU time spent on a command buffer from its timestamps.
+    /// @param command_buffer_index [in] The index of the command buffer.
+    /// @return The GPU time in milliseconds, or std::nullopt if the timestamps are not available.
+    [[nodiscard]] std::optional<double> get_gpu_frame_time(std::uint32_t command_buffer_index) const;
 
     /// @brief Create a physical device handle.
     /// @param graphics_card The regarded graphics card.
@@ -155,45 +338,49 @@ protected:
 
     VkResult update_cameras();
 
-    /// @brief Create depth image.
-    VkResult create_depth_buffer();
-
-    /// @brief Creates the command buffers.
+    /// @brief Creates the command pools and command buffers of all frames in flight.
     VkResult create_command_buffers();
 
-    /// @brief Records the command buffers.
-    VkResult record_command_buffers();
+    /// @brief Records the primary command buffer of a frame in flight.
+    /// @param frame_index [in] The index of the frame in flight, whose fence must be signaled.
+    /// @param image_index [in] The index of the render target to render into.
+    VkResult record_command_buffer(std::uint32_t frame_index, std::uint32_t image_index);
 
     /// @brief Creates the semaphores neccesary for synchronisation.
     VkResult create_synchronisation_objects();
 
-    /// @brief Cleans the swapchain.
+    /// @brief Destroys the graphics pipeline, its layout and the render graph before shutdown.
+    /// @note This is not needed to recreate the swapchain, see recreate_swapchain().
     VkResult cleanup_swapchain();
 
-    /// @brief Creates the uniform buffers.
+    /// @brief Creates the uniform ring buffer.
     VkResult create_uniform_buffers();
 
-    VkResult create_descriptor_pool();
+    /// @brief Creates the descriptor layout cache and the descriptor allocators.
+    VkResult create_descriptor_allocators();
 
+    /// @brief Creates the layout of the descriptor set with the uniform data.
     VkResult create_descriptor_set_layouts();
 
-    VkResult create_descriptor_writes();
-
-    /// @brief Creates the descriptor set.
+    /// @brief Allocates and writes the descriptor set with the uniform data.
     VkResult create_descriptor_sets();
 
     /// @brief Recreates the swapchain.
+    /// Only the images and framebuffers which depend on the size of the render targets are recreated. Pipelines use
+    /// dynamic viewport and scissor state, so they stay valid. The previous swapchain, images and framebuffers are
+    /// destroyed through the deletion queue, so this does not wait for the device to be idle. While the window is
+    /// minimized, the recreation is postponed and swapchain_recreation_pending is set.
     VkResult recreate_swapchain();
 
-    /// @brief Creates the command pool.
-    VkResult create_command_pool();
-
-    /// @brief Creates the frame buffers.
-    VkResult create_frame_buffers();
+    /// @brief Declares the render stages and their attachments, compiles the render graph and creates its resources.
+    VkResult setup_render_graph();
 
     /// @brief Creates the rendering pipeline.
     VkResult create_pipeline();
 
+    /// @brief Creates the chunk culler if the chunks are drawn indirectly and GPU culling is enabled.
+    VkResult create_chunk_culler();
+
     /// @brief Destroys all Vulkan objects.
     VkResult shutdown_vulkan();
 
@@ -33,6 +33,7 @@ public:
     /// - Add more here if you want..
     /// @note Add more checks to the validation mechanism if neccesary, e.h. check for geometry shader support.
     /// @param graphics_card The graphics card which will be checked for suitability.
+    /// @param surface The window surface, or VK_NULL_HANDLE for headless rendering (skips swapchain and presentation).
     /// @return True if the graphics card is suitable, false otherwise.
     /// @warning Do not discriminate graphics cards which are not VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU,
     /// because this would deny some players to run Inexor on their machines!
@@ -48,6 +49,7 @@ public:
     /// @note The user can manually specify which graphics card will be used by passing the command line argument -gpu
     /// <index>.
     /// @param vulkan_instance A pointer to the Vulkan instance handle.
+    /// @param surface The window surface, or VK_NULL_HANDLE for headless rendering.
     /// @param preferred_graphics_card_index The preferred graphics card (by array index).
     /// @return The physical device which was chosen to be the best one.
     [[nodiscard]] std::optional<VkPhysicalDevice>
@@ -2,15 +2,53 @@
 
 #include <glm/glm.hpp>
 
+#include <array>
+#include <cstdint>
+
 namespace inexor::vulkan_renderer {
 
-/// @note We can exactly match the definition in the shader using data types in GLM.
-/// The data in the matrices is binary compatible with the way the shader expects
-/// it, so we can later just memcpy a UniformBufferObject to a VkBuffer.
-struct UniformBufferObject {
-    glm::mat4 model;
+// We can exactly match the definitions in the shader using data types in GLM.
+// The data in the matrices is binary compatible with the way the shader expects
+// it, so we can just memcpy the uniform buffer objects to a VkBuffer.
+
+/// @brief The uniform data which is the same for all draws of a render pass.
+struct PassUniformBufferObject {
     glm::mat4 view;
     glm::mat4 proj;
 };
 
+/// @brief The data of a single draw, which is passed to the vertex shader as push constants.
+/// Push constants are recorded into the command buffer, so no buffer has to be written for every draw.
+struct DrawPushConstants {
+    glm::mat4 model;
+
+    /// The index of the draw's texture in the texture array.
+    std::uint32_t texture_index;
+};
+
+/// @brief The uniform data of the compute shader which culls the octree chunks.
+struct CullingUniformBufferObject {
+    /// The planes of the view frustum in the space of the chunk bounds.
+    std::array<glm::vec4, 6> frustum_planes;
+
+    /// The matrix which transforms the chunk bounds into the clip space of the frame the depth pyramid was built from.
+    glm::mat4 occlusion_view_projection;
+
+    glm::vec2 depth_pyramid_size;
+    std::uint32_t chunk_count;
+    std::uint32_t depth_pyramid_mip_count;
+
+    /// If 0, the chunks are only tested against the view frustum.
+    std::uint32_t occlusion_culling_enabled;
+
+    /// If 0, every chunk keeps its place in the indirect draw buffer, and culled chunks draw no instances.
+    std::uint32_t compact_draws;
+};
+
+/// @brief The sizes which are passed to the compute shaders which build the depth pyramid as push constants.
+struct DepthPyramidPushConstants {
+    glm::ivec2 source_size;
+    glm::ivec2 destination_size;
+};
+
 } // namespace inexor::vulkan_renderer
@@ -0,0 +1,339 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/thread_pool.hpp"
+
+#include <vulkan/vulkan_core.h>
+
+#include <cassert>
+#include <coroutine>
+#include <exception>
+#include <future>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace inexor::vulkan_renderer {
+
+template <typename T>
+class Task;
+
+namespace detail {
+
+/// @brief Resumes the awaiting coroutine once a Task has finished.
+/// Symmetric transfer makes sure long chains of tasks do not grow the stack.
+struct FinalAwaiter {
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    template <typename Promise>
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<Promise> handle) noexcept {
+        if (auto continuation = handle.promise().continuation) {
+            return continuation;
+        }
+        return std::noop_coroutine();
+    }
+
+    void await_resume() const noexcept {}
+};
+
+/// @brief The parts of a Task's promise which do not depend on the result type.
+struct TaskPromiseBase {
+    std::coroutine_handle<> continuation;
+
+    std::exception_ptr exception;
+
+    std::suspend_always initial_suspend() const noexcept {
+        return {};
+    }
+
+    FinalAwaiter final_suspend() const noexcept {
+        return {};
+    }
+
+    void unhandled_exception() noexcept {
+        exception = std::current_exception();
+    }
+
+    void rethrow_if_exception() const {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+};
+
+template <typename T>
+struct TaskPromise : TaskPromiseBase {
+    std::optional<T> result;
+
+    Task<T> get_return_object() noexcept;
+
+    template <typename U>
+    void return_value(U &&value) {
+        result.emplace(std::forward<U>(value));
+    }
+
+    T take_result() {
+        rethrow_if_exception();
+        assert(result);
+        return std::move(*result);
+    }
+};
+
+template <>
+struct TaskPromise<void> : TaskPromiseBase {
+    Task<void> get_return_object() noexcept;
+
+    void return_void() const noexcept {}
+
+    void take_result() const {
+        rethrow_if_exception();
+    }
+};
+
+} // namespace detail
+
+/// @brief A lazily started coroutine which produces a value of type T.
+/// A Task does not run until it is awaited (or handed to start_task). Together with the awaitables below, this allows
+/// to write asset loading chains linearly without blocking a worker thread on std::future::get().
+/// @code
+/// Task<Texture> load(ThreadPool &pool, ...) {
+///     auto data = co_await read_file_async(pool, file_name);
+///     co_await schedule_on(pool, TaskPriority::FRAME_CRITICAL);
+///     ...
+/// }
+/// @endcode
+template <typename T = void>
+class [[nodiscard]] Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+
+private:
+    std::coroutine_handle<promise_type> handle;
+
+public:
+    explicit Task(std::coroutine_handle<promise_type> handle) : handle(handle) {}
+
+    /// Delete the copy constructor so tasks are move-only objects.
+    Task(const Task &) = delete;
+    Task(Task &&other) noexcept : handle(std::exchange(other.handle, nullptr)) {}
+
+    Task &operator=(const Task &) = delete;
+    Task &operator=(Task &&) = delete;
+
+    ~Task() {
+        if (handle) {
+            handle.destroy();
+        }
+    }
+
+    bool await_ready() const noexcept {
+        return !handle || handle.done();
+    }
+
+    /// @brief Starts the task and resumes the awaiting coroutine once it is done.
+    std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+        handle.promise().continuation = awaiting;
+        return handle;
+    }
+
+    T await_resume() {
+        assert(handle);
+        return handle.promise().take_result();
+    }
+};
+
+namespace detail {
+
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+    return Task<T>{std::coroutine_handle<TaskPromise<T>>::from_promise(*this)};
+}
+
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+    return Task<void>{std::coroutine_handle<TaskPromise<void>>::from_promise(*this)};
+}
+
+/// @brief An eagerly started coroutine which destroys itself once it is done.
+/// This is only used to bridge from regular code into coroutines, see start_task.
+struct DetachedTask {
+    struct promise_type {
+        DetachedTask get_return_object() const noexcept {
+            return {};
+        }
+
+        std::suspend_never initial_suspend() const noexcept {
+            return {};
+        }
+
+        std::suspend_never final_suspend() const noexcept {
+            return {};
+        }
+
+        void return_void() const noexcept {}
+
+        void unhandled_exception() const noexcept {
+            std::terminate();
+        }
+    };
+};
+
+template <typename T>
+DetachedTask run_detached(Task<T> task, std::promise<T> promise) {
+    try {
+        if constexpr (std::is_void_v<T>) {
+            co_await task;
+            promise.set_value();
+        } else {
+            promise.set_value(co_await task);
+        }
+    } catch (...) {
+        promise.set_exception(std::current_exception());
+    }
+}
+
+} // namespace detail
+
+/// @brief Starts a task from regular (non-coroutine) code.
+/// The task runs on the calling thread until its first suspension point.
+/// @param task [in] The task to start.
+/// @return A future which becomes ready once the task is done.
+/// @warning Do not call get() on the future from a worker thread of the pool the task runs on.
+template <typename T>
+std::future<T> start_task(Task<T> task) {
+    std::promise<T> promise;
+    auto future = promise.get_future();
+    detail::run_detached(std::move(task), std::move(promise));
+    return future;
+}
+
+/// @brief An awaitable which continues the awaiting coroutine on a worker thread of the threadpool.
+class ScheduleAwaitable {
+private:
+    ThreadPool &thread_pool;
+    TaskPriority priority;
+
+public:
+    ScheduleAwaitable(ThreadPool &thread_pool, const TaskPriority priority)
+        : thread_pool(thread_pool), priority(priority) {}
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        // The returned future is not needed because the coroutine itself carries the result.
+        static_cast<void>(thread_pool.execute(priority, [handle]() { handle.resume(); }));
+    }
+
+    void await_resume() const noexcept {}
+};
+
+/// @brief Continues the awaiting coroutine on a worker thread of the threadpool.
+/// @param thread_pool [in] The threadpool to continue on.
+/// @param priority [in] The priority of the continuation.
+[[nodiscard]] inline ScheduleAwaitable schedule_on(ThreadPool &thread_pool,
+                                                   const TaskPriority priority = TaskPriority::BACKGROUND) {
+    return {thread_pool, priority};
+}
+
+/// @brief Resumes coroutines which wait for Vulkan fences once the fences have been signaled.
+/// The fences are checked with vkGetFenceStatus, which never blocks, whenever update() is called. The render thread
+/// calls update() once every frame, so no worker thread is ever blocked waiting for the GPU.
+class FenceWaiter {
+private:
+    /// @brief A coroutine which waits for a fence.
+    struct PendingFence {
+        VkDevice device;
+        VkFence fence;
+        TaskPriority priority;
+        VkResult *result;
+        std::coroutine_handle<> handle;
+    };
+
+    ThreadPool &thread_pool;
+
+    std::mutex pending_fences_mutex;
+
+    std::vector<PendingFence> pending_fences;
+
+public:
+    /// @brief Default constructor.
+    /// @param thread_pool [in] The threadpool the waiting coroutines are resumed on.
+    explicit FenceWaiter(ThreadPool &thread_pool) : thread_pool(thread_pool) {}
+
+    FenceWaiter(const FenceWaiter &) = delete;
+    FenceWaiter(FenceWaiter &&) = delete;
+
+    ~FenceWaiter();
+
+    FenceWaiter &operator=(const FenceWaiter &) = delete;
+    FenceWaiter &operator=(FenceWaiter &&) = delete;
+
+    /// @brief Suspends a coroutine until the fence has been signaled. Use wait_for_fence instead of calling this.
+    /// @param device [in] The Vulkan device.
+    /// @param fence [in] The fence to wait for.
+    /// @param priority [in] The priority of the continuation.
+    /// @param result [out] Receives VK_SUCCESS or the error which occured while waiting, e.g. VK_ERROR_DEVICE_LOST.
+    /// @param handle [in] The coroutine to resume.
+    void add(VkDevice device, VkFence fence, TaskPriority priority, VkResult *result, std::coroutine_handle<> handle);
+
+    /// @brief Checks all pending fences once and resumes the coroutines of the signaled ones on the threadpool.
+    /// This does not block.
+    /// @return The number of coroutines which have been resumed.
+    std::size_t update();
+
+    /// @brief Returns the number of coroutines which are still waiting for their fence.
+    [[nodiscard]] std::size_t get_pending_count();
+};
+
+/// @brief An awaitable which continues the awaiting coroutine once a Vulkan fence has been signaled.
+class FenceAwaitable {
+private:
+    FenceWaiter &fence_waiter;
+    VkDevice device;
+    VkFence fence;
+    TaskPriority priority;
+    VkResult result = VK_SUCCESS;
+
+public:
+    FenceAwaitable(FenceWaiter &fence_waiter, const VkDevice device, const VkFence fence, const TaskPriority priority)
+        : fence_waiter(fence_waiter), device(device), fence(fence), priority(priority) {}
+
+    bool await_ready() const {
+        return vkGetFenceStatus(device, fence) == VK_SUCCESS;
+    }
+
+    void await_suspend(std::coroutine_handle<> handle) {
+        fence_waiter.add(device, fence, priority, &result, handle);
+    }
+
+    /// @brief Returns VK_SUCCESS or the error which occured while waiting, e.g. VK_ERROR_DEVICE_LOST.
+    VkResult await_resume() const noexcept {
+        return result;
+    }
+};
+
+/// @brief Continues the awaiting coroutine on a worker thread once the fence has been signaled.
+/// @param fence_waiter [in] The fence waiter which checks the fence.
+/// @param device [in] The Vulkan device.
+/// @param fence [in] The fence to wait for.
+/// @param priority [in] The priority of the continuation.
+[[nodiscard]] inline FenceAwaitable wait_for_fence(FenceWaiter &fence_waiter, const VkDevice device,
+                                                   const VkFence fence,
+                                                   const TaskPriority priority = TaskPriority::BACKGROUND) {
+    assert(device);
+    assert(fence);
+    return {fence_waiter, device, fence, priority};
+}
+
+/// @brief Reads an entire file on a worker thread of the threadpool.
+/// @param thread_pool [in] The threadpool to read the file on.
+/// @param file_name [in] The name of the file.
+/// @return The file's data. The coroutine continues on the worker thread which read the file.
+/// @throws std::runtime_error If the file could not be loaded.
+Task<std::vector<char>> read_file_async(ThreadPool &thread_pool, std::string file_name);
+
+} // namespace inexor::vulkan_renderer
@@ -1,11 +1,17 @@
 #pragma once
 
+#include "inexor/vulkan-renderer/mpmc_queue.hpp"
+
 #include <spdlog/spdlog.h>
 
+#include <array>
 #include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstdint>
 #include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
@@ -27,19 +33,119 @@ constexpr unsigned int THREADPOOL_MIN_THREAD_COUNT = 6;
 // threads than cpu cores are available, generating overhead.
 constexpr unsigned int THREADPOOL_BACKUP_CPU_CORE_COUNT = 8;
 
+// The number of worker threads which exclusively work on frame-critical tasks.
+// Those threads form the low-latency lane: Background tasks can never occupy them,
+// so frame-critical tasks will always find a worker even if all other threads are busy.
+constexpr unsigned int THREADPOOL_LOW_LATENCY_THREAD_COUNT = 1;
+
 // TODO: Minimum number of threads.
 // TODO: Maximum number of threads.
 // TODO: Method for changing the number of threads at runtime.
 
+/// @brief The priority classes of tasks in the threadpool.
+/// Tasks of a higher priority class are always picked before tasks of a lower priority class.
+enum class TaskPriority : std::size_t {
+    /// Latency-critical work which must be finished for the current frame.
+    FRAME_CRITICAL = 0,
+
+    /// Work which may take several frames, e.g. map saves or texture decoding.
+    BACKGROUND = 1,
+};
+
+/// @brief The data structure which holds the tasks of the threadpool.
+enum class TaskQueueBackend {
+    /// std::queue guarded by a mutex. Unbounded.
+    MUTEX,
+
+    /// Bounded lock-free ring buffers (see MPMCQueue). Enqueueing a task never takes a lock unless a worker is asleep.
+    LOCK_FREE,
+};
+
+/// The default capacity of every tasklist if the lock-free backend is used.
+constexpr std::size_t THREADPOOL_LOCK_FREE_CAPACITY = 4096;
+
+/// The number of entries in TaskPriority.
+constexpr std::size_t THREADPOOL_TASK_PRIORITY_COUNT = 2;
+
+/// @brief A histogram of durations with power-of-two microsecond buckets.
+/// Recording is lock-free so it can be called from any worker thread.
+class LatencyHistogram {
+public:
+    static constexpr std::size_t BUCKET_COUNT = 20;
+
+private:
+    std::array<std::atomic<std::uint64_t>, BUCKET_COUNT> buckets{};
+
+    std::atomic<std::uint64_t> total_count = 0;
+
+    std::atomic<std::uint64_t> total_microseconds = 0;
+
+    std::atomic<std::uint64_t> max_microseconds = 0;
+
+public:
+    /// @brief Adds a duration to the histogram.
+    /// @param duration [in] The duration to add.
+    void record(std::chrono::nanoseconds duration);
+
+    /// @brief Resets all buckets to zero.
+    void reset();
+
+    /// @brief Returns the number of recorded durations for every bucket.
+    /// Bucket 0 contains durations below 1 microsecond, bucket i contains durations in [2^(i-1), 2^i) microseconds.
+    /// The last bucket contains all durations which are even longer.
+    [[nodiscard]] std::array<std::uint64_t, BUCKET_COUNT> get_buckets() const;
+
+    /// @brief Returns the exclusive upper bound of a bucket.
+    /// @param bucket_index [in] The index of the bucket.
+    [[nodiscard]] static std::chrono::microseconds get_bucket_upper_bound(std::size_t bucket_index);
+
+    [[nodiscard]] std::uint64_t get_count() const {
+        return total_count.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] std::chrono::microseconds get_max() const {
+        return std::chrono::microseconds(max_microseconds.load(std::memory_order_relaxed));
+    }
+
+    [[nodiscard]] std::chrono::microseconds get_average() const;
+};
+
+/// @brief A snapshot of the threadpool's instrumentation counters.
+/// All counters refer to the time since instrumentation was enabled or the last call of ThreadPool::reset_stats().
+struct ThreadPoolStats {
+    /// The number of tasks put into the tasklists, per priority class.
+    std::array<std::uint64_t, THREADPOOL_TASK_PRIORITY_COUNT> enqueued_tasks{};
+
+    /// The number of tasks which finished execution, per priority class.
+    std::array<std::uint64_t, THREADPOOL_TASK_PRIORITY_COUNT> completed_tasks{};
+
+    /// The number of tasks waiting in the tasklists right now, per priority class.
+    std::array<std::size_t, THREADPOOL_TASK_PRIORITY_COUNT> queue_depth{};
+
+    /// The fraction of time every worker thread spent executing tasks, between 0 and 1.
+    std::vector<float> worker_utilization;
+};
+
 /// @brief A C++17 threadpool implementation.
+/// Tasks are sorted into priority classes (see TaskPriority). Frame-critical tasks are always picked before background
+/// tasks, and a number of worker threads is reserved for frame-critical tasks only.
+/// @note Instrumentation (counters, histograms, utilization) is disabled by default. While disabled, the workers do not
+/// read the clock or touch any counters.
 class ThreadPool {
 public:
     /// @brief Standard constructor.
     /// @param thread_count [in] The number of threads to create for the threadpool.
     /// It is advisable to create as many threads as there are processor cores available,
     /// hence we are using std::thread::hardware_concurrency() as standard argument value.
+    /// @param low_latency_thread_count [in] The number of threads which only work on frame-critical tasks.
+    /// @param backend [in] The data structure which holds the tasks.
+    /// @param lock_free_capacity [in] The capacity of every tasklist if the lock-free backend is used.
+    /// Must be a power of two. If a tasklist is full, execute() waits until a worker has taken a task.
     /// @warning You should not create too many threads because this increases overhead!
-    ThreadPool(std::size_t thread_count = std::thread::hardware_concurrency());
+    ThreadPool(std::size_t thread_count = std::thread::hardware_concurrency(),
+               std::size_t low_latency_thread_count = THREADPOOL_LOW_LATENCY_THREAD_COUNT,
+               TaskQueueBackend backend = TaskQueueBackend::MUTEX,
+               std::size_t lock_free_capacity = THREADPOOL_LOCK_FREE_CAPACITY);
 
     // @brief The default destructor destroys all threads.
     ~ThreadPool();
@@ -51,13 +157,49 @@ public:
     ThreadPool &operator=(const ThreadPool &) = delete;
 
     /// @brief Spawns a new worker thread.
-    void start_thread();
+    /// This is thread safe, also while get_stats() or reset_stats() are called.
+    /// @param low_latency_lane [in] If true, the worker will only work on frame-critical tasks.
+    void start_thread(bool low_latency_lane = false);
 
-    /// @brief Executes a task from the tasklist.
+    /// @brief Executes a task from the tasklist as a background task.
     /// @note We only accept invokable arguments in the template.
     template <typename F, typename... Args, typename = std::enable_if_t<std::is_invocable_v<F &&, Args &&...>>>
     auto execute(F, Args &&...);
 
+    /// @brief Executes a task from the tasklist with the given priority.
+    /// @param priority [in] The priority class of the task.
+    /// @note We only accept invokable arguments in the template.
+    template <typename F, typename... Args, typename = std::enable_if_t<std::is_invocable_v<F &&, Args &&...>>>
+    auto execute(TaskPriority priority, F, Args &&...);
+
+    /// @brief Returns the histogram of the time tasks of a priority class spent waiting in the queue.
+    /// @param priority [in] The priority class.
+    /// @note The histograms are only filled while instrumentation is enabled.
+    [[nodiscard]] const LatencyHistogram &get_queue_latency_histogram(TaskPriority priority) const {
+        return queue_latency_histograms[static_cast<std::size_t>(priority)];
+    }
+
+    /// @brief Returns the histogram of the execution time of tasks of a priority class.
+    /// @param priority [in] The priority class.
+    [[nodiscard]] const LatencyHistogram &get_execution_time_histogram(TaskPriority priority) const {
+        return execution_time_histograms[static_cast<std::size_t>(priority)];
+    }
+
+    /// @brief Enables or disables the instrumentation of the threadpool.
+    /// Enabling the instrumentation resets all counters.
+    /// @param enabled [in] True if the instrumentation should be enabled.
+    void set_instrumentation_enabled(bool enabled);
+
+    [[nodiscard]] bool is_instrumentation_enabled() const {
+        return instrumentation_enabled.load(std::memory_order_relaxed);
+    }
+
+    /// @brief Returns a snapshot of the instrumentation counters.
+    [[nodiscard]] ThreadPoolStats get_stats();
+
+    /// @brief Resets all instrumentation counters and histograms.
+    void reset_stats();
+
 private:
     //_task_container_base and _task_container exist simply as a wrapper around a
     //  MoveConstructible - but not CopyConstructible - Callable object. Since an
@@ -71,6 +213,10 @@ private:
         virtual ~TaskContainerBase(){};
 
         virtual void operator()() = 0;
+
+        // The time point at which the task was put into the tasklist.
+        // This is only set while instrumentation is enabled.
+        std::chrono::steady_clock::time_point enqueue_time{};
     };
 
     //_task_container takes a typename F, which must be Callable and MoveConstructible.
@@ -106,26 +252,91 @@ private:
         return std::make_unique<TaskContainer<Task>>(std::forward<Task>(f));
     }
 
+    /// @brief The instrumentation counters of a single worker thread.
+    struct WorkerStats {
+        std::atomic<std::uint64_t> busy_nanoseconds = 0;
+    };
+
+    /// @brief Puts a task into the tasklist of its priority class and wakes up a suitable worker.
+    void enqueue(TaskPriority priority, std::unique_ptr<TaskContainerBase> task);
+
+    /// @brief Waits until there is a task for a worker and takes it out of the mutex guarded tasklists.
+    /// @param lowest_priority [in] The index of the lowest priority class the worker may work on.
+    /// @param worker_cv [in] The condition variable the worker sleeps on.
+    /// @param priority [out] The priority class of the task.
+    /// @param task [out] The task.
+    /// @return False if the worker should stop.
+    bool take_task(std::size_t lowest_priority, std::condition_variable &worker_cv, std::size_t &priority,
+                   std::unique_ptr<TaskContainerBase> &task);
+
+    /// @brief Waits until there is a task for a worker and takes it out of the lock-free tasklists.
+    /// @note The parameters are the same as for take_task.
+    bool take_task_lock_free(std::size_t lowest_priority, std::condition_variable &worker_cv, std::size_t &priority,
+                             std::unique_ptr<TaskContainerBase> &task);
+
+    /// @brief Runs a task on the calling worker and updates the instrumentation counters.
+    void run_task(std::size_t priority, std::unique_ptr<TaskContainerBase> task, WorkerStats &stats);
+
+    /// This mutex locks the lists of threads and worker stats, so threads can be started while stats are read.
+    std::mutex threads_mutex;
+
     // The threads.
     std::vector<std::thread> threads;
 
-    /// The tasklist contains the list of work that should be done.
-    std::queue<std::unique_ptr<TaskContainerBase>> tasklist;
+    /// The tasklists contain the list of work that should be done, one for every priority class.
+    std::array<std::queue<std::unique_ptr<TaskContainerBase>>, THREADPOOL_TASK_PRIORITY_COUNT> tasklists;
+
+    /// The tasklists of the lock-free backend, one for every priority class.
+    std::array<std::unique_ptr<MPMCQueue<std::unique_ptr<TaskContainerBase>>>, THREADPOOL_TASK_PRIORITY_COUNT>
+        lock_free_tasklists;
+
+    /// The number of tasks in the lock-free tasklists, used to decide whether a worker may go to sleep.
+    std::array<std::atomic<std::size_t>, THREADPOOL_TASK_PRIORITY_COUNT> pending_tasks{};
+
+    /// The number of workers which are waiting on a condition variable (lock-free backend only).
+    std::atomic<std::size_t> sleeping_workers = 0;
+
+    TaskQueueBackend backend;
 
     /// This mutex locks tasklist access.
+    /// The lock-free backend only uses it to put workers to sleep and wake them up.
     std::mutex tasklist_mutex;
 
+    /// Wakes up general purpose workers.
     std::condition_variable tasklist_cv;
 
+    /// Wakes up workers of the low-latency lane.
+    std::condition_variable low_latency_cv;
+
+    /// The time tasks spent in the tasklists, one histogram for every priority class.
+    std::array<LatencyHistogram, THREADPOOL_TASK_PRIORITY_COUNT> queue_latency_histograms;
+
+    /// The time tasks took to execute, one histogram for every priority class.
+    std::array<LatencyHistogram, THREADPOOL_TASK_PRIORITY_COUNT> execution_time_histograms;
+
+    std::array<std::atomic<std::uint64_t>, THREADPOOL_TASK_PRIORITY_COUNT> enqueued_tasks{};
+
+    std::array<std::atomic<std::uint64_t>, THREADPOOL_TASK_PRIORITY_COUNT> completed_tasks{};
+
+    /// One entry for every worker thread, in the same order as threads.
+    std::vector<std::unique_ptr<WorkerStats>> worker_stats;
+
+    /// The time point the instrumentation counters were last reset.
+    std::atomic<std::chrono::steady_clock::rep> stats_reset_time = 0;
+
+    std::atomic<bool> instrumentation_enabled = false;
+
     std::atomic<bool> stop_threads = false;
 };
 
 template <typename F, typename... Args, typename>
 auto ThreadPool::execute(F function, Args &&... args) {
-    spdlog::warn("Executing task from task list.");
+    return execute(TaskPriority::BACKGROUND, std::move(function), std::forward<Args>(args)...);
+}
 
-    // Lock the task list so we can add the new task.
-    std::unique_lock<std::mutex> queue_lock(tasklist_mutex, std::defer_lock);
+template <typename F, typename... Args, typename>
+auto ThreadPool::execute(const TaskPriority priority, F function, Args &&... args) {
+    spdlog::trace("Executing task from task list.");
 
     // Bind the function pointer and the parameters to the task package.
     std::packaged_task<std::invoke_result_t<F, Args...>()> task_package(std::bind(function, args...));
@@ -133,24 +344,11 @@ auto ThreadPool::execute(F function, Args &&... args) {
     //
     std::future<std::invoke_result_t<F, Args...>> future = task_package.get_future();
 
-    spdlog::warn("Locking queue_lock.");
-
-    //
-    queue_lock.lock();
-
     // This lambda move-captures the packaged_task declared above.
     // Since the packaged_task type is not CopyConstructible, the
     // function is not CopyConstructible either, hence the need
     // for a TaskContainer to wrap around it.
-    tasklist.emplace(allocate_task_container(std::move(task_package)));
-
-    //
-    queue_lock.unlock();
-
-    spdlog::warn("Unlocking queue_lock.");
-
-    //
-    tasklist_cv.notify_one();
+    enqueue(priority, allocate_task_container(std::move(task_package)));
 
     //
     return std::move(future);
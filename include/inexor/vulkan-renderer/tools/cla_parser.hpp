@@ -67,7 +67,46 @@ class CommandLineArgumentParser {
         {"--no-separate-data-queue", false},
 
         // Disable debug markers (even if -renderdoc is specified)
-        {"--no-vk-debug-markers", false}};
+        {"--no-vk-debug-markers", false},
+
+        // Log threadpool statistics every second.
+        {"--threadpool-stats", false},
+
+        // Render into offscreen images without a window and report frame times.
+        {"--headless", false},
+
+        // The number of frames to render in headless mode.
+        {"--frames", true},
+
+        // The maximum number of threads which record the octree's draw calls.
+        {"--record-threads", true},
+
+        // The number of chunks the octree world is built from, every chunk is one draw.
+        {"--draws", true},
+
+        // Record one vkCmdDrawIndexed call per chunk instead of indirect draw calls.
+        {"--no-indirect-draws", false},
+
+        // Do not read the number of indirect draws from a buffer even if VK_KHR_draw_indirect_count is available.
+        {"--no-draw-indirect-count", false},
+
+        // Draw all indirectly drawn chunks instead of culling them on the device.
+        {"--no-gpu-culling", false},
+
+        // Cull the chunks on the device against the view frustum only, not against the previous frame's depth buffer.
+        {"--no-occlusion-culling", false},
+
+        // Decode the texture files on the main thread instead of the threadpool.
+        {"--serial-texture-decoding", false},
+
+        // The number of textures to load, repeating the configured textures if necessary.
+        {"--texture-count", true},
+
+        // Always decode the texture files instead of loading them from the texture cache.
+        {"--no-texture-cache", false},
+
+        // Bind the textures as a small fallback array even if VK_EXT_descriptor_indexing is available.
+        {"--no-descriptor-indexing", false}};
 
     std::unordered_map<std::string, CommandLineArgumentValue> parsed_arguments;
 
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace inexor::vulkan_renderer::tools {
+
+/// @brief Returns the number of mip levels of a full mip chain down to a size of 1x1.
+/// @param width [in] The width of the first mip level.
+/// @param height [in] The height of the first mip level.
+[[nodiscard]] std::uint32_t calculate_mip_levels(std::uint32_t width, std::uint32_t height);
+
+/// @brief Generates the mip chain of an RGBA8 image with a 2x2 box filter.
+/// This is the fallback for formats which can't be blitted with linear filtering, and it is used for the offline
+/// texture compression as well.
+/// @param texture_data [in] The tightly packed texels of the first mip level.
+/// @param width [in] The width of the first mip level.
+/// @param height [in] The height of the first mip level.
+/// @param mip_levels [in] The number of mip levels to generate, including the first one.
+/// @param mip_level_offsets [out] The offset of every mip level in the returned data.
+/// @return The tightly packed texels of all mip levels.
+[[nodiscard]] std::vector<std::uint8_t> generate_mip_chain(const std::uint8_t *texture_data, std::uint32_t width,
+                                                           std::uint32_t height, std::uint32_t mip_levels,
+                                                           std::vector<std::uint64_t> &mip_level_offsets);
+
+} // namespace inexor::vulkan_renderer::tools
@@ -0,0 +1,240 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/wrapper/command_buffer.hpp"
+#include "inexor/vulkan-renderer/wrapper/command_pool.hpp"
+#include "inexor/vulkan-renderer/wrapper/fence.hpp"
+#include "inexor/vulkan-renderer/wrapper/gpu_memory_buffer.hpp"
+#include "inexor/vulkan-renderer/wrapper/staging_ring_buffer.hpp"
+
+#include <vma/vk_mem_alloc.h>
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace inexor::vulkan_renderer {
+
+/// @brief The counters of an upload manager since its creation or the last call of reset_stats().
+struct UploadStats {
+    std::uint64_t upload_count = 0;
+    std::uint64_t uploaded_bytes = 0;
+
+    /// The number of staging buffers which have been allocated because an upload was larger than the staging ring.
+    std::uint64_t staging_allocation_count = 0;
+
+    /// The number of times an upload had to wait for a batch because the staging ring was full.
+    std::uint64_t staging_ring_stall_count = 0;
+};
+
+/// @brief Uploads buffer and image data to the device on the data transfer queue.
+/// All uploads which are requested between two calls of submit() are recorded into one command buffer and submitted
+/// as one batch, which signals a fence when it has finished. Nothing waits for the transfer queue to become idle, so
+/// uploads overlap with rendering on the graphics queue.
+/// If the data transfer queue belongs to another queue family than the graphics queue, the ownership of every
+/// uploaded resource is released by the batch and acquired again by record_acquire_barriers() on the graphics queue.
+/// The upload data is copied into a persistently mapped staging ring. The part of the ring a batch has used is reused
+/// as soon as the fence of the batch has signaled. If the ring is full, the upload waits for the oldest batch.
+/// @note This class is not thread safe, all methods must be called from the same thread.
+class UploadManager {
+private:
+    /// @brief An image whose mip levels are generated from its first level with blits.
+    struct MipmapGeneration {
+        VkImage image;
+        VkExtent3D extent;
+        std::uint32_t mip_levels;
+        VkImageLayout final_layout;
+        VkPipelineStageFlags dst_stage_mask;
+        VkAccessFlags dst_access_mask;
+    };
+
+    /// A command buffer with all uploads which have been requested between two calls of submit().
+    struct Batch {
+        std::uint64_t id;
+        wrapper::CommandBuffer command_buffer;
+        std::unique_ptr<wrapper::Fence> fence;
+
+        /// The position in the staging ring after the data of this batch, released when the batch finishes.
+        std::uint64_t staging_ring_mark = 0;
+
+        /// The staging buffers of uploads which do not fit into the staging ring. They must stay alive until the batch
+        /// has finished executing.
+        std::vector<std::unique_ptr<wrapper::GPUMemoryBuffer>> staging_buffers;
+
+        /// The barriers which acquire the ownership of the uploaded resources on the graphics queue.
+        std::vector<VkBufferMemoryBarrier> acquire_buffer_barriers;
+        std::vector<VkImageMemoryBarrier> acquire_image_barriers;
+        VkPipelineStageFlags acquire_stage_mask = 0;
+
+        /// The images whose mip levels are generated on the graphics queue after their first level has been acquired.
+        std::vector<MipmapGeneration> mipmap_generations;
+    };
+
+    VkDevice device;
+    VmaAllocator vma_allocator;
+    VkQueue transfer_queue;
+    std::uint32_t transfer_queue_family_index;
+    std::uint32_t graphics_queue_family_index;
+
+    wrapper::CommandPool command_pool;
+
+    std::unique_ptr<wrapper::StagingRingBuffer> staging_ring;
+
+    /// The batch which is being recorded, if any upload has been requested since the last submit().
+    std::optional<Batch> recording_batch;
+
+    /// The submitted batches in the order of submission, which is also the order in which they finish.
+    std::deque<Batch> submitted_batches;
+
+    /// The command buffers and fences of finished batches, which are reused by the next batches.
+    std::vector<wrapper::CommandBuffer> free_command_buffers;
+    std::vector<std::unique_ptr<wrapper::Fence>> free_fences;
+
+    /// The acquire barriers of finished batches, which have not been recorded on the graphics queue yet.
+    std::vector<VkBufferMemoryBarrier> pending_buffer_barriers;
+    std::vector<VkImageMemoryBarrier> pending_image_barriers;
+    VkPipelineStageFlags pending_stage_mask = 0;
+    std::vector<MipmapGeneration> pending_mipmap_generations;
+
+    std::uint64_t next_batch_id = 1;
+
+    /// The id of the last batch which has finished executing.
+    std::uint64_t finished_batch_id = 0;
+
+    /// The id of the last batch whose resources can be used by commands recorded from now on.
+    std::uint64_t available_batch_id = 0;
+
+    UploadStats stats;
+
+    [[nodiscard]] bool needs_ownership_transfer() const {
+        return transfer_queue_family_index != graphics_queue_family_index;
+    }
+
+    /// @brief Returns the batch which is being recorded and starts recording a new one if necessary.
+    Batch &get_recording_batch();
+
+    /// @brief Copies upload data into the staging ring, or into a staging buffer of the recording batch if it is
+    /// larger than the ring. This might submit the recording batch and wait for it if the ring is full.
+    /// @return The staging buffer and the offset of the data in it.
+    std::pair<VkBuffer, VkDeviceSize> copy_to_staging_memory(const void *data, VkDeviceSize size);
+
+    /// @brief Transitions the given mip levels of an image into VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL and records the
+    /// copies from the staging memory into them.
+    static void record_image_copy(VkCommandBuffer command_buffer, VkImage image, VkBuffer staging_buffer,
+                                  VkDeviceSize staging_offset, VkExtent3D extent,
+                                  const std::vector<VkDeviceSize> &mip_level_offsets);
+
+    /// @brief Records the blits which downsample every mip level from the previous one, and the transition of all
+    /// levels into the final layout. The first level must be in VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL.
+    /// @note The command buffer must belong to a queue with graphics capabilities.
+    static void record_mipmap_generation(VkCommandBuffer command_buffer, const MipmapGeneration &mipmap_generation);
+
+    /// @brief Marks the batch at the front of submitted_batches as finished and reclaims its resources.
+    void retire_oldest_batch();
+
+public:
+    /// @brief Creates the command pool of the data transfer queue and the staging ring.
+    /// @param device [in] The Vulkan device.
+    /// @param vma_allocator [in] The Vulkan Memory Allocator library handle.
+    /// @param transfer_queue [in] The data transfer queue.
+    /// @param transfer_queue_family_index [in] The queue family index of the data transfer queue.
+    /// @param graphics_queue_family_index [in] The queue family index of the queue which uses the uploaded resources.
+    /// @param staging_ring_size [in] The size of the staging ring in bytes.
+    UploadManager(VkDevice device, VmaAllocator vma_allocator, VkQueue transfer_queue,
+                  std::uint32_t transfer_queue_family_index, std::uint32_t graphics_queue_family_index,
+                  VkDeviceSize staging_ring_size);
+
+    /// Delete the copy constructor so upload managers are move-only objects.
+    UploadManager(const UploadManager &) = delete;
+    UploadManager(UploadManager &&) noexcept = default;
+
+    /// Delete the copy assignment operator so upload managers are move-only objects.
+    UploadManager &operator=(const UploadManager &) = delete;
+    UploadManager &operator=(UploadManager &&) noexcept = default;
+
+    /// @brief Waits for all submitted batches, because their staging buffers are destroyed along with the manager.
+    ~UploadManager();
+
+    /// @brief Copies data into a buffer.
+    /// @param buffer [in] The target buffer, which must have been created with VK_BUFFER_USAGE_TRANSFER_DST_BIT.
+    /// @param data [in] The data to upload. It is copied into a staging buffer immediately.
+    /// @param size [in] The size of the data in bytes.
+    /// @param buffer_offset [in] The offset in the target buffer in bytes.
+    /// @param dst_stage_mask [in] The pipeline stages in which the graphics queue uses the buffer.
+    /// @param dst_access_mask [in] The type of access of the graphics queue.
+    void upload_buffer(VkBuffer buffer, const void *data, VkDeviceSize size, VkDeviceSize buffer_offset,
+                       VkPipelineStageFlags dst_stage_mask, VkAccessFlags dst_access_mask);
+
+    /// @brief Copies data into the mip levels of a color image and transitions it into its final layout.
+    /// The previous content of the image is discarded.
+    /// @param image [in] The target image, which must have been created with VK_IMAGE_USAGE_TRANSFER_DST_BIT.
+    /// @param data [in] The tightly packed texel data of all mip levels. It is copied into a staging buffer
+    /// immediately.
+    /// @param size [in] The size of the data in bytes.
+    /// @param extent [in] The extent of the first mip level.
+    /// @param mip_level_offsets [in] The offset of every mip level in the data, starting with the first level. Every
+    /// offset must be a multiple of the texel (block) size.
+    /// @param final_layout [in] The layout the image is used in, e.g. VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL.
+    /// @param dst_stage_mask [in] The pipeline stages in which the graphics queue uses the image.
+    /// @param dst_access_mask [in] The type of access of the graphics queue.
+    void upload_image(VkImage image, const void *data, VkDeviceSize size, VkExtent3D extent,
+                      const std::vector<VkDeviceSize> &mip_level_offsets, VkImageLayout final_layout,
+                      VkPipelineStageFlags dst_stage_mask, VkAccessFlags dst_access_mask);
+
+    /// @brief Copies data into the first mip level of a color image, generates the other mip levels from it and
+    /// transitions the image into its final layout.
+    /// The mip levels are downsampled with linear filtered blits, either in the upload batch or, if the data transfer
+    /// queue does not belong to the graphics queue family, by record_acquire_barriers() on the graphics queue.
+    /// @param image [in] The target image, which must have been created with VK_IMAGE_USAGE_TRANSFER_SRC_BIT and
+    /// VK_IMAGE_USAGE_TRANSFER_DST_BIT. Its format must support VK_FORMAT_FEATURE_BLIT_SRC_BIT,
+    /// VK_FORMAT_FEATURE_BLIT_DST_BIT and VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT with optimal tiling.
+    /// @param data [in] The tightly packed texel data of the first mip level.
+    /// @param size [in] The size of the data in bytes.
+    /// @param extent [in] The extent of the first mip level.
+    /// @param mip_levels [in] The number of mip levels of the image.
+    /// @param final_layout [in] The layout the image is used in, e.g. VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL.
+    /// @param dst_stage_mask [in] The pipeline stages in which the graphics queue uses the image.
+    /// @param dst_access_mask [in] The type of access of the graphics queue.
+    void upload_image_and_generate_mipmaps(VkImage image, const void *data, VkDeviceSize size, VkExtent3D extent,
+                                           std::uint32_t mip_levels, VkImageLayout final_layout,
+                                           VkPipelineStageFlags dst_stage_mask, VkAccessFlags dst_access_mask);
+
+    /// @brief Submits all uploads which have been requested since the last call as one batch.
+    /// @return The id of the batch. If there was nothing to submit, this is the id of the last submitted batch.
+    /// @throws std::runtime_error If the batch could not be submitted.
+    std::uint64_t submit();
+
+    /// @brief Reclaims the staging buffers and command buffers of all batches which have finished executing.
+    /// This does not block.
+    void update();
+
+    /// @brief Blocks until a batch has finished executing.
+    /// @param batch_id [in] The id which has been returned by submit().
+    void wait(std::uint64_t batch_id);
+
+    /// @brief Records the barriers which acquire the resources of all finished batches on the graphics queue, and the
+    /// generation of the mip levels of their images if the data transfer queue could not generate them.
+    /// This must be called at the beginning of every command buffer of the graphics queue, before any uploaded
+    /// resource is used.
+    /// @param command_buffer [in] A command buffer of the graphics queue in recording state, outside of a render pass.
+    void record_acquire_barriers(VkCommandBuffer command_buffer);
+
+    /// @brief Returns true if the resources of a batch can be used by commands which are recorded from now on.
+    /// @param batch_id [in] The id which has been returned by submit().
+    [[nodiscard]] bool is_available(const std::uint64_t batch_id) const {
+        return batch_id <= available_batch_id;
+    }
+
+    [[nodiscard]] const UploadStats &get_stats() const {
+        return stats;
+    }
+
+    void reset_stats() {
+        stats = {};
+    }
+};
+
+} // namespace inexor::vulkan_renderer
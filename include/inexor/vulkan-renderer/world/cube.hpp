@@ -9,6 +9,11 @@
 #include <memory>
 #include <vector>
 
+// forward declaration
+namespace inexor::vulkan_renderer {
+struct Frustum;
+} // namespace inexor::vulkan_renderer
+
 // forward declaration
 namespace inexor::vulkan_renderer::world {
 class Cube;
@@ -94,6 +99,10 @@ public:
     void set_type(Type new_type);
     /// Get type.
     [[nodiscard]] Type type() const noexcept;
+    /// Get the edge length.
+    [[nodiscard]] float size() const noexcept;
+    /// Get the corner with the smallest coordinates.
+    [[nodiscard]] glm::vec3 position() const noexcept;
 
     /// Get childs.
     [[nodiscard]] const std::array<std::shared_ptr<Cube>, Cube::SUB_CUBES> &childs() const;
@@ -114,6 +123,11 @@ public:
     /// Recursive way to collect all the caches.
     /// @param update_invalid If true it will update invalid polygon caches.
     [[nodiscard]] std::vector<PolygonCache> polygons(bool update_invalid = false) const;
+    /// Recursive way to collect the caches of the cubes which are not outside of the frustum. Octants outside of the
+    /// frustum are skipped together with all their childs, and the childs of octants inside of it are not tested.
+    /// @param frustum The frustum, whose planes must be in the space of the octree.
+    /// @param update_invalid If true it will update invalid polygon caches of the collected cubes.
+    [[nodiscard]] std::vector<PolygonCache> polygons(const Frustum &frustum, bool update_invalid = false) const;
 };
 
 } // namespace inexor::vulkan_renderer::world
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/wrapper/texture.hpp"
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <string>
+
+namespace inexor::vulkan_renderer::wrapper {
+
+/// @brief A descriptor set with one large array of combined image samplers which textures register into.
+/// Draws select their texture by its index in the array, so all draws share the same descriptor set no matter which
+/// textures they use. The array is bound to binding 0 of its own descriptor set, whose size is passed to the shaders
+/// as specialization constant TEXTURE_ARRAY_SIZE_CONSTANT_ID.
+/// If VK_EXT_descriptor_indexing is enabled, the array is partially bound and can be updated after it has been bound,
+/// so textures can be added at any time. Its size is only limited by the update-after-bind limits of the device.
+/// Otherwise, the array falls back to a small array in which every element must be valid. All elements point to the
+/// first texture until they are replaced, and textures must only be added while the descriptor set is not in use.
+/// @note This class is not thread safe.
+class BindlessTextureArray {
+private:
+    VkDevice device = VK_NULL_HANDLE;
+    std::string name;
+
+    bool bindless = false;
+    std::uint32_t capacity = 0;
+    std::uint32_t size = 0;
+
+    VkDescriptorSetLayout descriptor_set_layout = VK_NULL_HANDLE;
+    VkDescriptorPool descriptor_pool = VK_NULL_HANDLE;
+    VkDescriptorSet descriptor_set = VK_NULL_HANDLE;
+
+    /// @brief Writes a texture into a range of array elements.
+    void write_descriptors(const Texture &texture, std::uint32_t first_element, std::uint32_t element_count);
+
+public:
+    /// The maximum size of the array if descriptor indexing is enabled.
+    static constexpr std::uint32_t MAX_BINDLESS_TEXTURE_COUNT = 4096;
+
+    /// The size of the array if descriptor indexing is not available.
+    static constexpr std::uint32_t MAX_FALLBACK_TEXTURE_COUNT = 16;
+
+    /// The specialization constant which holds the size of the array in the shaders.
+    static constexpr std::uint32_t TEXTURE_ARRAY_SIZE_CONSTANT_ID = 0;
+
+    /// @brief Creates the descriptor set layout, the descriptor pool and the descriptor set of the array.
+    /// @param device [in] The Vulkan device.
+    /// @param graphics_card [in] The graphics card, whose limits determine the size of the array.
+    /// @param descriptor_indexing_enabled [in] True if VK_EXT_descriptor_indexing and its features for
+    /// partially bound, update-after-bind sampled image arrays are enabled on the device.
+    /// @param name [in] The internal name of the array.
+    BindlessTextureArray(VkDevice device, VkPhysicalDevice graphics_card, bool descriptor_indexing_enabled,
+                         const std::string &name);
+
+    BindlessTextureArray(const BindlessTextureArray &) = delete;
+    BindlessTextureArray(BindlessTextureArray &&) = delete;
+
+    BindlessTextureArray &operator=(const BindlessTextureArray &) = delete;
+    BindlessTextureArray &operator=(BindlessTextureArray &&) = delete;
+
+    ~BindlessTextureArray();
+
+    /// @brief Registers a texture in the next free element of the array.
+    /// @param texture [in] The texture, which must outlive its use by the device.
+    /// @return The index of the texture in the array, which selects the texture in the shaders.
+    /// @exception std::runtime_error The array is full.
+    std::uint32_t add(const Texture &texture);
+
+    /// @brief Returns true if the array uses descriptor indexing, false if it uses the fallback array.
+    [[nodiscard]] bool is_bindless() const {
+        return bindless;
+    }
+
+    /// @brief Returns the number of elements of the array, which is the maximum number of textures.
+    [[nodiscard]] std::uint32_t get_capacity() const {
+        return capacity;
+    }
+
+    /// @brief Returns the number of textures which have been added.
+    [[nodiscard]] std::uint32_t get_size() const {
+        return size;
+    }
+
+    [[nodiscard]] VkDescriptorSetLayout get_descriptor_set_layout() const {
+        return descriptor_set_layout;
+    }
+
+    [[nodiscard]] VkDescriptorSet get_descriptor_set() const {
+        return descriptor_set;
+    }
+};
+
+} // namespace inexor::vulkan_renderer::wrapper
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/range_allocator.hpp"
+#include "inexor/vulkan-renderer/upload_manager.hpp"
+#include "inexor/vulkan-renderer/wrapper/gpu_memory_buffer.hpp"
+
+#include <glm/glm.hpp>
+#include <vma/vk_mem_alloc.h>
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace inexor::vulkan_renderer::wrapper {
+
+/// @brief One large vertex buffer and one large index buffer which the meshes of all chunks of the world are
+/// sub-allocated from.
+/// All chunks are drawn with the same vertex and index buffer bindings. For every chunk there is one
+/// VkDrawIndexedIndirectCommand, so the whole world can be drawn with a single vkCmdDrawIndexedIndirect call. The
+/// indices of a chunk start at 0 and are offset by the command's vertexOffset. The draw commands are densely packed,
+/// removing a chunk moves the last command into its place. The bounding box of every chunk is kept next to its draw
+/// command, so the chunks can be culled before they are drawn.
+/// @note This class is not thread safe.
+class ChunkMeshBuffer {
+public:
+    /// The index type of all chunk meshes.
+    static constexpr VkIndexType INDEX_TYPE = VK_INDEX_TYPE_UINT32;
+
+    /// @brief The axis aligned bounding box of a chunk's vertices.
+    struct Bounds {
+        glm::vec3 min;
+        glm::vec3 max;
+    };
+
+private:
+    /// @brief The ranges of a chunk's vertices and indices.
+    struct Chunk {
+        std::uint32_t first_vertex = 0;
+        std::uint32_t vertex_count = 0;
+        std::uint32_t first_index = 0;
+        std::uint32_t index_count = 0;
+
+        /// The index of the chunk's draw command.
+        std::uint32_t draw_index = 0;
+    };
+
+    std::string name;
+
+    VkDeviceSize vertex_size;
+
+    GPUMemoryBuffer vertex_buffer;
+    GPUMemoryBuffer index_buffer;
+
+    RangeAllocator vertex_ranges;
+    RangeAllocator index_ranges;
+
+    /// The chunks, indexed by their id. Removed chunks have no vertices.
+    std::vector<Chunk> chunks;
+
+    /// The ids of removed chunks, which are reused by the next chunks.
+    std::vector<std::uint32_t> free_chunk_ids;
+
+    /// The draw command of every chunk, its bounding box, and the id of the chunk every command belongs to.
+    std::vector<VkDrawIndexedIndirectCommand> draw_commands;
+    std::vector<Bounds> draw_bounds;
+    std::vector<std::uint32_t> draw_chunk_ids;
+
+public:
+    /// @brief Creates the vertex buffer and the index buffer.
+    /// @param device [in] The Vulkan device.
+    /// @param vma_allocator [in] The Vulkan Memory Allocator library handle.
+    /// @param name [in] The internal name of the buffers.
+    /// @param vertex_size [in] The size of one vertex in bytes.
+    /// @param max_vertex_count [in] The number of vertices of all chunks together the vertex buffer can hold.
+    /// @param max_index_count [in] The number of indices of all chunks together the index buffer can hold.
+    ChunkMeshBuffer(VkDevice device, VmaAllocator vma_allocator, const std::string &name, VkDeviceSize vertex_size,
+                    std::uint32_t max_vertex_count, std::uint32_t max_index_count);
+
+    ChunkMeshBuffer(const ChunkMeshBuffer &) = delete;
+    ChunkMeshBuffer(ChunkMeshBuffer &&) = delete;
+
+    ChunkMeshBuffer &operator=(const ChunkMeshBuffer &) = delete;
+    ChunkMeshBuffer &operator=(ChunkMeshBuffer &&) = delete;
+
+    ~ChunkMeshBuffer() = default;
+
+    /// @brief Sub-allocates the mesh of a chunk and uploads it.
+    /// The chunk must not be drawn before the batch of the upload manager is available.
+    /// @param upload_manager [in] The upload manager which copies the mesh into the buffers.
+    /// @param vertices [in] The vertices of the chunk.
+    /// @param vertex_count [in] The number of vertices, which must not be 0.
+    /// @param indices [in] The indices of the chunk, relative to its first vertex.
+    /// @param index_count [in] The number of indices, which must not be 0.
+    /// @param bounds [in] The bounding box of the vertices.
+    /// @return The id of the chunk.
+    /// @exception std::runtime_error There is not enough space left for the vertices or the indices.
+    std::uint32_t add_chunk(UploadManager &upload_manager, const void *vertices, std::uint32_t vertex_count,
+                            const std::uint32_t *indices, std::uint32_t index_count, const Bounds &bounds);
+
+    /// @brief Frees the mesh of a chunk and removes its draw command.
+    /// @param chunk_id [in] The id which has been returned by add_chunk().
+    /// @warning The next chunks might be uploaded into the freed ranges, so the device must not use the chunk anymore.
+    /// Chunks which might still be drawn by a frame in flight have to be removed through the deletion queue.
+    void remove_chunk(std::uint32_t chunk_id);
+
+    [[nodiscard]] VkBuffer get_vertex_buffer() const {
+        return vertex_buffer.get_buffer();
+    }
+
+    [[nodiscard]] VkBuffer get_index_buffer() const {
+        return index_buffer.get_buffer();
+    }
+
+    /// @brief Returns the draw commands of all chunks.
+    [[nodiscard]] const std::vector<VkDrawIndexedIndirectCommand> &get_draw_commands() const {
+        return draw_commands;
+    }
+
+    /// @brief Returns the bounding boxes of all chunks, in the order of their draw commands.
+    [[nodiscard]] const std::vector<Bounds> &get_draw_bounds() const {
+        return draw_bounds;
+    }
+
+    /// @brief Returns the number of chunks.
+    [[nodiscard]] std::uint32_t get_chunk_count() const {
+        return static_cast<std::uint32_t>(draw_commands.size());
+    }
+};
+
+} // namespace inexor::vulkan_renderer::wrapper
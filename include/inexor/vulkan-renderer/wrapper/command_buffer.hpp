@@ -18,7 +18,12 @@ public:
     CommandBuffer &operator=(const CommandBuffer &) = delete;
     CommandBuffer &operator=(CommandBuffer &&other) noexcept = default;
 
-    CommandBuffer(const VkDevice device, const VkCommandPool command_pool);
+    /// @brief Allocates a command buffer from a command pool.
+    /// @param device [in] The Vulkan device.
+    /// @param command_pool [in] The command pool to allocate from.
+    /// @param level [in] Whether this is a primary or a secondary command buffer.
+    CommandBuffer(const VkDevice device, const VkCommandPool command_pool,
+                  const VkCommandBufferLevel level = VK_COMMAND_BUFFER_LEVEL_PRIMARY);
 
     /// @note We don't need to destroy the command buffer because it will be destroyed along with it's associated
     /// command pool automatically.
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <string>
+
+namespace inexor::vulkan_renderer::wrapper {
+
+class ComputePipeline {
+private:
+    VkDevice device;
+    VkPipeline compute_pipeline;
+    std::string name;
+
+public:
+    /// Delete the copy constructor so compute pipelines are move-only objects.
+    ComputePipeline(const ComputePipeline &) = delete;
+    ComputePipeline(ComputePipeline &&other) noexcept;
+
+    /// Delete the copy assignment operator so compute pipelines are move-only objects.
+    ComputePipeline &operator=(const ComputePipeline &) = delete;
+    ComputePipeline &operator=(ComputePipeline &&) noexcept = default;
+
+    /// @brief Creates a compute pipeline.
+    /// @param device [in] The Vulkan device.
+    /// @param pipeline_cache [in] The pipeline cache which speeds up the creation of the pipeline.
+    /// @param pipeline_layout [in] The pipeline layout.
+    /// @param shader_stage [in] The compute shader.
+    /// @param name [in] The internal name of the compute pipeline.
+    ComputePipeline(VkDevice device, VkPipelineCache pipeline_cache, VkPipelineLayout pipeline_layout,
+                    const VkPipelineShaderStageCreateInfo &shader_stage, const std::string &name);
+
+    ~ComputePipeline();
+
+    [[nodiscard]] VkPipeline get() const {
+        return compute_pipeline;
+    }
+};
+
+} // namespace inexor::vulkan_renderer::wrapper
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/wrapper/image.hpp"
+
+#include <vma/vk_mem_alloc.h>
+#include <vulkan/vulkan_core.h>
+
+#include <cassert>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace inexor::vulkan_renderer::wrapper {
+
+/// @brief A hierarchical depth buffer (Hi-Z buffer), in which every texel of a mip level holds the farthest depth of
+/// the texels it covers in the mip level below.
+/// The size of mip level 0 is the largest power of two which is not larger than the depth buffer, so every texel of
+/// every mip level covers a rectangle of whole texels of the level below. Every mip level has its own image view, so
+/// it can be written by a compute shader while the level below is sampled.
+/// @note The image is meant to stay in VK_IMAGE_LAYOUT_GENERAL, as its mip levels are written and sampled in turns.
+class DepthPyramid {
+public:
+    /// The format of the depth values.
+    static constexpr VkFormat FORMAT = VK_FORMAT_R32_SFLOAT;
+
+private:
+    VkDevice device;
+    std::string name;
+    VkExtent2D extent;
+    std::uint32_t mip_count;
+    Image image;
+
+    /// One image view per mip level.
+    std::vector<VkImageView> mip_views;
+
+public:
+    /// @brief Creates the image and the image views of all mip levels.
+    /// @param device [in] The Vulkan device.
+    /// @param graphics_card [in] The graphics card.
+    /// @param vma_allocator [in] The Vulkan Memory Allocator library handle.
+    /// @param depth_extent [in] The size of the depth buffer the pyramid is built from.
+    /// @param name [in] The internal name of the pyramid.
+    DepthPyramid(VkDevice device, VkPhysicalDevice graphics_card, VmaAllocator vma_allocator, VkExtent2D depth_extent,
+                 const std::string &name);
+
+    DepthPyramid(const DepthPyramid &) = delete;
+    DepthPyramid(DepthPyramid &&) = delete;
+
+    DepthPyramid &operator=(const DepthPyramid &) = delete;
+    DepthPyramid &operator=(DepthPyramid &&) = delete;
+
+    ~DepthPyramid();
+
+    [[nodiscard]] VkImage get_image() const {
+        return image.get();
+    }
+
+    /// @brief Returns the image view of all mip levels.
+    [[nodiscard]] VkImageView get_image_view() const {
+        return image.get_image_view();
+    }
+
+    /// @brief Returns the image view of one mip level.
+    /// @param mip_level [in] The mip level.
+    [[nodiscard]] VkImageView get_mip_view(const std::uint32_t mip_level) const {
+        assert(mip_level < mip_count);
+        return mip_views[mip_level];
+    }
+
+    /// @brief Returns the size of mip level 0.
+    [[nodiscard]] VkExtent2D get_extent() const {
+        return extent;
+    }
+
+    /// @brief Returns the size of a mip level.
+    /// @param mip_level [in] The mip level.
+    [[nodiscard]] VkExtent2D get_mip_extent(std::uint32_t mip_level) const;
+
+    [[nodiscard]] std::uint32_t get_mip_count() const {
+        return mip_count;
+    }
+};
+
+} // namespace inexor::vulkan_renderer::wrapper
@@ -0,0 +1,96 @@
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace inexor::vulkan_renderer::wrapper {
+
+/// @brief Allocates descriptor sets of any layout from a growing list of descriptor pools.
+/// When the current pool runs out of memory, the allocator continues with a new pool, which is twice as large as the
+/// previous one (up to MAX_SETS_PER_POOL). Sets are never freed one by one, instead reset() frees all sets at once and
+/// keeps the pools for reuse. An allocator whose sets are only used by one frame in flight can therefore be reset as
+/// soon as the frame's fence has signaled.
+/// @note This class is not thread safe.
+class DescriptorAllocator {
+public:
+    /// @brief The number of descriptors of a type which a pool holds per descriptor set.
+    using PoolSizeRatio = std::pair<VkDescriptorType, float>;
+
+    /// The number of descriptor sets the first pool can hold.
+    static constexpr std::uint32_t DEFAULT_SETS_PER_POOL = 32;
+
+    /// The number of descriptor sets a pool can hold at most.
+    static constexpr std::uint32_t MAX_SETS_PER_POOL = 4096;
+
+private:
+    VkDevice device = VK_NULL_HANDLE;
+    std::string name;
+
+    std::vector<PoolSizeRatio> pool_size_ratios;
+
+    /// The number of descriptor sets the next new pool can hold.
+    std::uint32_t sets_per_pool = 0;
+
+    /// The pool which sets are allocated from, or VK_NULL_HANDLE before the first allocation.
+    VkDescriptorPool current_pool = VK_NULL_HANDLE;
+
+    /// The pools which sets have been allocated from since the last reset, except for the current pool.
+    std::vector<VkDescriptorPool> used_pools;
+
+    /// The pools which have been reset and can be used again.
+    std::vector<VkDescriptorPool> free_pools;
+
+    std::uint64_t allocated_set_count = 0;
+
+    /// @brief Continues with a free pool, or with a new pool if there is none.
+    void use_next_pool();
+
+public:
+    /// @brief The descriptor types a pool is sized for by default.
+    /// @return Generous ratios for uniform buffers, storage buffers and images.
+    [[nodiscard]] static std::vector<PoolSizeRatio> get_default_pool_size_ratios();
+
+    /// @brief Creates a descriptor allocator. No pool is created until the first set is allocated.
+    /// @param device [in] The Vulkan device.
+    /// @param name [in] The internal name of the allocator.
+    /// @param pool_size_ratios [in] The number of descriptors of every type a pool holds per descriptor set.
+    /// @param initial_sets_per_pool [in] The number of descriptor sets the first pool can hold.
+    DescriptorAllocator(VkDevice device, const std::string &name,
+                        const std::vector<PoolSizeRatio> &pool_size_ratios = get_default_pool_size_ratios(),
+                        std::uint32_t initial_sets_per_pool = DEFAULT_SETS_PER_POOL);
+
+    DescriptorAllocator(const DescriptorAllocator &) = delete;
+    DescriptorAllocator(DescriptorAllocator &&) = delete;
+
+    DescriptorAllocator &operator=(const DescriptorAllocator &) = delete;
+    DescriptorAllocator &operator=(DescriptorAllocator &&) = delete;
+
+    /// @brief Destroys all pools, which frees all descriptor sets.
+    ~DescriptorAllocator();
+
+    /// @brief Allocates a descriptor set, creating a new pool if the current one is exhausted.
+    /// @param descriptor_set_layout [in] The layout of the descriptor set.
+    /// @return The descriptor set, which stays valid until reset() is called or the allocator is destroyed.
+    /// @exception std::runtime_error The set could not be allocated even from a new pool.
+    [[nodiscard]] VkDescriptorSet allocate(VkDescriptorSetLayout descriptor_set_layout);
+
+    /// @brief Frees all descriptor sets at once. The pools are kept and reused by the next allocations.
+    /// @warning The device must not use any of the descriptor sets anymore.
+    void reset();
+
+    /// @brief Returns the number of pools which have been created.
+    [[nodiscard]] std::size_t get_pool_count() const {
+        return used_pools.size() + free_pools.size() + (current_pool != VK_NULL_HANDLE ? 1 : 0);
+    }
+
+    /// @brief Returns the number of descriptor sets which have been allocated since the last reset.
+    [[nodiscard]] std::uint64_t get_allocated_set_count() const {
+        return allocated_set_count;
+    }
+};
+
+} // namespace inexor::vulkan_renderer::wrapper
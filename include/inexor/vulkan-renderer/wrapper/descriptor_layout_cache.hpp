@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace inexor::vulkan_renderer::wrapper {
+
+/// @brief Creates every distinct descriptor set layout only once.
+/// Layouts are looked up by a hash of their bindings, so every pass or material which asks for the same bindings gets
+/// the same VkDescriptorSetLayout, and descriptor sets and pipeline layouts built from it are compatible. The layouts
+/// live as long as the cache.
+/// @note Immutable samplers are compared by the address of the sampler array. This class is not thread safe.
+class DescriptorLayoutCache {
+private:
+    /// @brief The bindings of a layout, sorted by binding number.
+    struct LayoutKey {
+        std::vector<VkDescriptorSetLayoutBinding> bindings;
+
+        bool operator==(const LayoutKey &other) const;
+    };
+
+    struct LayoutKeyHash {
+        std::size_t operator()(const LayoutKey &key) const;
+    };
+
+    VkDevice device = VK_NULL_HANDLE;
+    std::string name;
+
+    std::unordered_map<LayoutKey, VkDescriptorSetLayout, LayoutKeyHash> layouts;
+
+public:
+    /// @param device [in] The Vulkan device.
+    /// @param name [in] The internal name of the cache.
+    DescriptorLayoutCache(VkDevice device, const std::string &name);
+
+    DescriptorLayoutCache(const DescriptorLayoutCache &) = delete;
+    DescriptorLayoutCache(DescriptorLayoutCache &&) = delete;
+
+    DescriptorLayoutCache &operator=(const DescriptorLayoutCache &) = delete;
+    DescriptorLayoutCache &operator=(DescriptorLayoutCache &&) = delete;
+
+    /// @brief Destroys all layouts.
+    ~DescriptorLayoutCache();
+
+    /// @brief Returns the descriptor set layout with the given bindings, which is created if it does not exist yet.
+    /// @param bindings [in] The bindings of the layout in any order.
+    /// @exception std::runtime_error The layout could not be created.
+    [[nodiscard]] VkDescriptorSetLayout get(std::vector<VkDescriptorSetLayoutBinding> bindings);
+
+    /// @brief Returns the number of distinct layouts which have been created.
+    [[nodiscard]] std::size_t get_size() const {
+        return layouts.size();
+    }
+};
+
+} // namespace inexor::vulkan_renderer::wrapper
@@ -23,6 +23,16 @@ private:
     std::uint32_t graphics_queue_family_index;
     std::uint32_t transfer_queue_family_index;
 
+    /// True if VK_EXT_descriptor_indexing is enabled for partially bound, update-after-bind sampled image arrays.
+    bool descriptor_indexing_enabled = false;
+
+    /// True if one vkCmdDrawIndexedIndirect call can issue more than one draw.
+    bool multi_draw_indirect_enabled = false;
+
+    /// VK_KHR_draw_indirect_count is not part of the core, so the function pointer needs to be loaded manually. This
+    /// is nullptr if the extension is not enabled.
+    PFN_vkCmdDrawIndexedIndirectCountKHR vk_cmd_draw_indexed_indirect_count = nullptr;
+
     // The debug marker extension is not part of the core,
     // so function pointers need to be loaded manually.
     PFN_vkDebugMarkerSetObjectTagEXT vk_debug_marker_set_object_tag;
@@ -42,9 +52,13 @@ public:
     Device &operator=(Device &&) noexcept = default;
 
     /// @brief Creates a graphics card interface.
+    /// @param instance [in] The Vulkan instance.
+    /// @param surface [in] The window surface, or VK_NULL_HANDLE for headless rendering.
+    /// In that case, no swapchain extension is enabled and the graphics queue is also returned as presentation queue.
+    /// @param prefer_descriptor_indexing [in] Enable VK_EXT_descriptor_indexing if the graphics card supports it.
     /// @param preferred_gpu_index [in] The index of the preferred physical device to use.
     Device(const VkInstance instance, const VkSurfaceKHR surface, bool enable_vulkan_debug_markers,
-           bool prefer_distinct_transfer_queue,
+           bool prefer_distinct_transfer_queue, bool prefer_descriptor_indexing,
            const std::optional<std::uint32_t> preferred_physical_device_index = std::nullopt);
 
     // TODO: Add overloaded constructors for VkPhysicalDeviceFeatures and requested device extensions in the future!
@@ -91,6 +105,33 @@ public:
         return transfer_queue_family_index;
     }
 
+    /// @brief Returns true if textures can be bound as one partially bound, update-after-bind array.
+    [[nodiscard]] bool is_descriptor_indexing_enabled() const {
+        return descriptor_indexing_enabled;
+    }
+
+    /// @brief Returns true if one vkCmdDrawIndexedIndirect call can issue more than one draw.
+    [[nodiscard]] bool is_multi_draw_indirect_enabled() const {
+        return multi_draw_indirect_enabled;
+    }
+
+    /// @brief Returns true if draw_indexed_indirect_count() can be used.
+    [[nodiscard]] bool is_draw_indirect_count_enabled() const {
+        return vk_cmd_draw_indexed_indirect_count != nullptr;
+    }
+
+    /// @brief Records indexed indirect draws whose number is read from a buffer (VK_KHR_draw_indirect_count).
+    /// @param command_buffer [in] The command buffer in recording state.
+    /// @param buffer [in] The buffer which contains the VkDrawIndexedIndirectCommand structures.
+    /// @param offset [in] The offset of the first draw command in the buffer.
+    /// @param count_buffer [in] The buffer which contains the number of draws.
+    /// @param count_buffer_offset [in] The offset of the number of draws in the count buffer.
+    /// @param max_draw_count [in] The maximum number of draws, regardless of the number in the count buffer.
+    /// @param stride [in] The distance between two draw commands in bytes.
+    void draw_indexed_indirect_count(VkCommandBuffer command_buffer, VkBuffer buffer, VkDeviceSize offset,
+                                     VkBuffer count_buffer, VkDeviceSize count_buffer_offset,
+                                     std::uint32_t max_draw_count, std::uint32_t stride) const;
+
 #ifndef NDEBUG
 
     /// @brief Vulkan debug marker: Sets the name of a Vulkan resource.
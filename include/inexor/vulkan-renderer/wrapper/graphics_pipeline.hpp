@@ -11,7 +11,6 @@ class GraphicsPipeline {
 private:
     VkDevice device;
     VkPipeline graphics_pipeline;
-    VkPipelineCache pipeline_cache;
     std::string name;
 
 public:
@@ -24,22 +23,23 @@ public:
     GraphicsPipeline &operator=(GraphicsPipeline &&) noexcept = default;
 
     /// @brief Creates a graphics pipeline.
+    /// The viewport and the scissor are dynamic states which must be set with vkCmdSetViewport and vkCmdSetScissor
+    /// before drawing, so the pipeline does not depend on the size of the render targets.
     /// @param device [in] The Vulkan device.
+    /// @param pipeline_cache [in] The pipeline cache which speeds up the creation of the pipeline.
     /// @param pipeline_layout [in] The pipeline layout.
     /// @param render_pass [in] The associated renderpass.
     /// @param shader_stages [in] The shaders and the stages they are used in.
     /// @param vertex_binding [in] The vertex binding description.
     /// @param attribute_binding [in] The vertex attribute binding description.
-    /// @param window_width [in] The width of the window.
-    /// @param window_height [in] The height of the window.
     /// @param multisampling_enabled [in] True if multisampling is enabled, false otherwise.
     /// @note For now, The engines uses 4 samples for MSAA by default. This might change in the future.
     /// @param name [in] The internal name of the graphics pipeline.
-    GraphicsPipeline(const VkDevice device, const VkPipelineLayout pipeline_layout, const VkRenderPass render_pass,
+    GraphicsPipeline(const VkDevice device, const VkPipelineCache pipeline_cache,
+                     const VkPipelineLayout pipeline_layout, const VkRenderPass render_pass,
                      const std::vector<VkPipelineShaderStageCreateInfo> &shader_stages,
                      const VkVertexInputBindingDescription vertex_binding,
                      const std::vector<VkVertexInputAttributeDescription> &attribute_binding,
-                     const std::uint32_t window_width, const std::uint32_t window_height,
                      const bool multisampling_enabled, const std::string &name);
 
     ~GraphicsPipeline();
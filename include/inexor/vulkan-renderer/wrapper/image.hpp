@@ -4,6 +4,7 @@
 #include <vulkan/vulkan_core.h>
 
 #include <cassert>
+#include <cstdint>
 #include <string>
 
 namespace inexor::vulkan_renderer::wrapper {
@@ -38,9 +39,11 @@ public:
     /// @param sample_count [in] The sample count, mostly 1 if multisampling for this image is disabled.
     /// @param name [in] The internal name of this image.
     /// @param image_extent [in] The width and height of the image.
+    /// @param mip_levels [in] The number of mip levels of the image, all of which are part of the image view.
     Image(const VkDevice device, const VkPhysicalDevice graphics_card, const VmaAllocator vma_allocator,
           const VkFormat format, const VkImageUsageFlags image_usage, const VkImageAspectFlags aspect_flags,
-          const VkSampleCountFlagBits sample_count, const std::string &name, const VkExtent2D image_extent);
+          const VkSampleCountFlagBits sample_count, const std::string &name, const VkExtent2D image_extent,
+          const std::uint32_t mip_levels = 1);
 
     ~Image();
 
@@ -53,6 +56,11 @@ public:
         return image_view;
     }
 
+    /// @brief Returns the size of the memory allocation of the image in bytes.
+    [[nodiscard]] VkDeviceSize get_allocation_size() const {
+        return allocation_info.size;
+    }
+
     [[nodiscard]] VkImage get() const {
         assert(image);
         return image;
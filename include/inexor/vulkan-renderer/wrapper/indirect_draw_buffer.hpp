@@ -0,0 +1,113 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/wrapper/gpu_memory_buffer.hpp"
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <string>
+
+namespace inexor::vulkan_renderer::wrapper {
+
+/// @brief A persistently mapped buffer of indexed indirect draw commands which is divided into one region per frame in
+/// flight.
+/// Every region starts with the number of draws, which vkCmdDrawIndexedIndirectCount reads from the buffer, followed
+/// by the VkDrawIndexedIndirectCommand structures. A frame never writes into the region of another frame which the
+/// device might still read from. The draws are either written by the host, or by a compute shader which binds the
+/// region as storage buffer, see begin_device_write().
+class IndirectDrawBuffer : public GPUMemoryBuffer {
+public:
+    /// The distance between two draw commands in bytes.
+    static constexpr std::uint32_t COMMAND_STRIDE = sizeof(VkDrawIndexedIndirectCommand);
+
+    /// The offset of the first draw command in a region. The draw count is stored before it.
+    static constexpr VkDeviceSize FIRST_COMMAND_OFFSET = 16;
+
+    /// The alignment of the regions, which is the largest minStorageBufferOffsetAlignment the specification allows.
+    static constexpr VkDeviceSize REGION_ALIGNMENT = 256;
+
+private:
+    std::uint32_t max_draw_count;
+    std::uint32_t frame_count;
+    VkDeviceSize frame_size;
+
+    /// The offset of the current frame's region in the buffer.
+    VkDeviceSize frame_begin = 0;
+
+    std::uint32_t draw_count = 0;
+
+public:
+    /// @brief Creates a new indirect draw buffer.
+    /// @param device [in] The Vulkan device from which the buffer will be created.
+    /// @param vma_allocator [in] The Vulkan Memory Allocator library handle.
+    /// @param name [in] The internal name of the buffer.
+    /// @param max_draw_count [in] The number of draw commands every frame in flight can write.
+    /// @param frame_count [in] The number of frames in flight.
+    IndirectDrawBuffer(const VkDevice &device, const VmaAllocator &vma_allocator, const std::string &name,
+                       std::uint32_t max_draw_count, std::uint32_t frame_count);
+
+    IndirectDrawBuffer(const IndirectDrawBuffer &) = delete;
+    IndirectDrawBuffer(IndirectDrawBuffer &&) = delete;
+
+    IndirectDrawBuffer &operator=(const IndirectDrawBuffer &) = delete;
+    IndirectDrawBuffer &operator=(IndirectDrawBuffer &&) = delete;
+
+    ~IndirectDrawBuffer() override = default;
+
+    /// @brief Starts writing into the region of a frame in flight. The draws of the previous use of the region are
+    /// discarded.
+    /// @param frame_index [in] The index of the frame in flight.
+    /// @warning The device must have finished executing the frame's command buffers.
+    void begin_frame(std::uint32_t frame_index);
+
+    /// @brief Copies draw commands into the current frame's region, replacing the commands which have been written
+    /// before, and stores their number as draw count.
+    /// @param commands [in] The draw commands.
+    /// @param count [in] The number of draw commands.
+    /// @throws std::runtime_error If there are more than max_draw_count commands.
+    void write(const VkDrawIndexedIndirectCommand *commands, std::uint32_t count);
+
+    /// @brief Prepares the current frame's region for draw commands which a compute shader writes instead of the host.
+    /// The draw count in the buffer is reset to 0, so the shader can count the draws it writes with atomic operations.
+    /// The draw count on the host is set to the number of commands the shader writes at most.
+    /// @param count [in] The number of draw commands the shader writes at most.
+    /// @throws std::runtime_error If count is larger than max_draw_count.
+    void begin_device_write(std::uint32_t count);
+
+    /// @brief Returns the draw count the device has written into the current frame's region during the previous use of
+    /// the region. This must be called after begin_frame(), before anything is written into the region.
+    /// @warning The shader writes must have been made available to the host by a pipeline barrier.
+    [[nodiscard]] std::uint32_t read_device_draw_count() const;
+
+    /// @brief Makes the draws of the current frame visible to the device if the memory is not host coherent.
+    /// This must be called after the last write of a frame, before its command buffers are submitted.
+    void flush();
+
+    /// @brief Returns the offset of the current frame's draw count in the buffer.
+    [[nodiscard]] VkDeviceSize get_count_offset() const {
+        return frame_begin;
+    }
+
+    /// @brief Returns the offset of one of the current frame's draw commands in the buffer.
+    /// @param draw_index [in] The index of the draw command.
+    [[nodiscard]] VkDeviceSize get_command_offset(const std::uint32_t draw_index) const {
+        return frame_begin + FIRST_COMMAND_OFFSET + static_cast<VkDeviceSize>(draw_index) * COMMAND_STRIDE;
+    }
+
+    /// @brief Returns the size of the current frame's region which holds the draw count and max_draw_count draw
+    /// commands, starting at get_count_offset().
+    [[nodiscard]] VkDeviceSize get_region_size() const {
+        return FIRST_COMMAND_OFFSET + static_cast<VkDeviceSize>(max_draw_count) * COMMAND_STRIDE;
+    }
+
+    /// @brief Returns the number of draw commands which have been written for the current frame.
+    [[nodiscard]] std::uint32_t get_draw_count() const {
+        return draw_count;
+    }
+
+    [[nodiscard]] std::uint32_t get_max_draw_count() const {
+        return max_draw_count;
+    }
+};
+
+} // namespace inexor::vulkan_renderer::wrapper
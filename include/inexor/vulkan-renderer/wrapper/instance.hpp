@@ -37,11 +37,13 @@ public:
     /// @param requested_instance_layers [in] A vector of required Vulkan instance layers.
     /// @param enable_validation_layers [in] True if validation layers are requested, false otherwise.
     /// @param enable_renderdoc_layer [in] True if RenderDoc instance layer is requested, false otherwise.
+    /// @param enable_window_surface [in] True if the instance extensions required by GLFW window surfaces should be
+    /// enabled, false for headless rendering.
     Instance(const std::string &application_name, const std::string &engine_name,
              const std::uint32_t application_version, const std::uint32_t engine_version,
              const std::uint32_t vulkan_api_version, std::vector<std::string> requested_instance_extensions,
              std::vector<std::string> requested_instance_layers, bool enable_validation_layers,
-             bool enable_renderdoc_layer);
+             bool enable_renderdoc_layer, bool enable_window_surface = true);
 
     /// @brief Creates a VkInstance.
     /// @note When this constructor is used, no instance layers or instance extensions will be requested,
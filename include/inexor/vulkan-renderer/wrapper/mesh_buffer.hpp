@@ -1,5 +1,6 @@
 ﻿#pragma once
 
+#include "inexor/vulkan-renderer/upload_manager.hpp"
 #include "inexor/vulkan-renderer/wrapper/gpu_memory_buffer.hpp"
 
 #include <vma/vma_usage.h>
@@ -49,14 +50,16 @@ public:
     MeshBuffer &operator=(MeshBuffer &&) noexcept = default;
 
     /// @brief Creates a new vertex buffer and an associated index buffer.
-    MeshBuffer(const VkDevice device, VkQueue data_transfer_queue, const std::uint32_t data_transfer_queue_family_index,
-               const VmaAllocator vma_allocator, const std::string &name, const VkDeviceSize size_of_vertex_structure,
+    /// The mesh buffer must not be used before the batch of the upload manager is available.
+    MeshBuffer(const VkDevice device, UploadManager &upload_manager, const VmaAllocator vma_allocator,
+               const std::string &name, const VkDeviceSize size_of_vertex_structure,
                const std::size_t number_of_vertices, void *vertices, const VkDeviceSize size_of_index_structure,
                const std::size_t number_of_indices, void *indices);
 
     /// @brief Creates a vertex buffer without index buffer.
-    MeshBuffer(const VkDevice device, VkQueue data_transfer_queue, const std::uint32_t data_transfer_queue_family_index,
-               const VmaAllocator vma_allocator, const std::string &name, const VkDeviceSize size_of_vertex_structure,
+    /// The mesh buffer must not be used before the batch of the upload manager is available.
+    MeshBuffer(const VkDevice device, UploadManager &upload_manager, const VmaAllocator vma_allocator,
+               const std::string &name, const VkDeviceSize size_of_vertex_structure,
                const std::size_t number_of_vertices, void *vertices);
 
     ~MeshBuffer();
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <vulkan/vulkan_core.h>
+
+#include <string>
+
+namespace inexor::vulkan_renderer::wrapper {
+
+/// @brief RAII wrapper class for VkPipelineCache which is stored on disk across runs.
+/// The cache file starts with a header which identifies the graphics card, the driver version and the pipeline cache
+/// UUID it has been created with. If any of these do not match the current device, the file is ignored and the cache
+/// starts empty, because pipeline cache data is only valid for the exact device and driver which created it.
+class PipelineCache {
+private:
+    VkDevice device;
+    VkPipelineCache pipeline_cache = VK_NULL_HANDLE;
+    VkPhysicalDeviceProperties graphics_card_properties = {};
+    std::string file_name;
+
+    /// True if the cache has been created from the data in the cache file.
+    bool loaded_from_file = false;
+
+public:
+    /// @brief Creates the pipeline cache and loads its initial data from a file, if it is valid for the device.
+    /// @param device [in] The Vulkan device.
+    /// @param graphics_card [in] The graphics card the device has been created for.
+    /// @param file_name [in] The file the cache is loaded from and saved to.
+    PipelineCache(VkDevice device, VkPhysicalDevice graphics_card, const std::string &file_name);
+
+    /// Delete the copy constructor so pipeline caches are move-only objects.
+    PipelineCache(const PipelineCache &) = delete;
+    PipelineCache(PipelineCache &&other) noexcept;
+
+    /// Delete the copy assignment operator so pipeline caches are move-only objects.
+    PipelineCache &operator=(const PipelineCache &) = delete;
+    PipelineCache &operator=(PipelineCache &&) noexcept = default;
+
+    ~PipelineCache();
+
+    /// @brief Writes the data of the cache to the cache file.
+    /// The data is written to a temporary file first, so a crash while saving does not leave a broken cache behind.
+    /// @return True if the cache has been saved successfully, false otherwise.
+    bool save() const;
+
+    /// @brief Returns true if the cache has been created from the data in the cache file.
+    [[nodiscard]] bool is_loaded_from_file() const {
+        return loaded_from_file;
+    }
+
+    [[nodiscard]] VkPipelineCache get() const {
+        return pipeline_cache;
+    }
+};
+
+} // namespace inexor::vulkan_renderer::wrapper
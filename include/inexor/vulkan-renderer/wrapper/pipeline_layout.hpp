@@ -25,9 +25,10 @@ public:
     /// @brief Creates a pipeline layout
     /// @param device [in] The Vulkan device.
     /// @param descriptor_set_layouts [in] The descriptor set layouts for the pipeline layout.
+    /// @param push_constant_ranges [in] The push constant ranges for the pipeline layout.
     /// @param name [in] The internal name of the pipeline layout.
     PipelineLayout(const VkDevice device, const std::vector<VkDescriptorSetLayout> &descriptor_set_layouts,
-                   const std::string &name);
+                   const std::vector<VkPushConstantRange> &push_constant_ranges, const std::string &name);
 
     ~PipelineLayout();
 
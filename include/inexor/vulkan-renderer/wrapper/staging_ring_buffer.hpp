@@ -0,0 +1,76 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/wrapper/gpu_memory_buffer.hpp"
+
+#include <vulkan/vulkan_core.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace inexor::vulkan_renderer::wrapper {
+
+/// @brief A persistently mapped staging buffer which upload data is sub-allocated from in a ring.
+/// Allocations are released in the order in which they were made: get_mark() returns a position after all previous
+/// allocations, and release() frees everything before such a position once the device has finished reading from it.
+/// This replaces one buffer allocation per upload with a pointer bump into memory which is allocated only once.
+/// @note This class is not thread safe.
+class StagingRingBuffer : public GPUMemoryBuffer {
+private:
+    VkDeviceSize size;
+    VkDeviceSize alignment;
+
+    /// The positions are counted in bytes since the creation of the ring and never wrap around, the offset in the
+    /// buffer is the position modulo the size. Everything in [tail, head) is in use.
+    std::uint64_t head = 0;
+    std::uint64_t tail = 0;
+
+public:
+    /// @brief Creates a new staging ring buffer.
+    /// @param device [in] The Vulkan device from which the buffer will be created.
+    /// @param vma_allocator [in] The Vulkan Memory Allocator library handle.
+    /// @param name [in] The internal name of the buffer.
+    /// @param size [in] The size of the buffer in bytes.
+    /// @param alignment [in] The alignment of every allocation, which must be a power of two.
+    StagingRingBuffer(const VkDevice &device, const VmaAllocator &vma_allocator, const std::string &name,
+                      VkDeviceSize size, VkDeviceSize alignment);
+
+    /// Delete the copy constructor so staging ring buffers are neither copyable nor movable, as submitted uploads
+    /// still read from their memory.
+    StagingRingBuffer(const StagingRingBuffer &) = delete;
+    StagingRingBuffer(StagingRingBuffer &&) = delete;
+
+    StagingRingBuffer &operator=(const StagingRingBuffer &) = delete;
+    StagingRingBuffer &operator=(StagingRingBuffer &&) = delete;
+
+    ~StagingRingBuffer() override = default;
+
+    /// @brief Copies data into the ring.
+    /// An allocation is never split, so if it does not fit between the head and the end of the buffer, it starts at
+    /// the beginning of the buffer again.
+    /// @param data [in] The data to copy.
+    /// @param data_size [in] The size of the data in bytes.
+    /// @return The offset of the data in the buffer, or std::nullopt if there is not enough free space.
+    [[nodiscard]] std::optional<VkDeviceSize> allocate(const void *data, VkDeviceSize data_size);
+
+    /// @brief Returns the position after all allocations which have been made so far.
+    [[nodiscard]] std::uint64_t get_mark() const {
+        return head;
+    }
+
+    /// @brief Frees all allocations before a position which has been returned by get_mark().
+    /// Positions which have already been released are ignored.
+    /// @param mark [in] The position.
+    void release(std::uint64_t mark);
+
+    [[nodiscard]] VkDeviceSize get_size() const {
+        return size;
+    }
+
+    /// @brief Returns the number of bytes which are in use, including the padding of the allocations.
+    [[nodiscard]] VkDeviceSize get_used_size() const {
+        return head - tail;
+    }
+};
+
+} // namespace inexor::vulkan_renderer::wrapper
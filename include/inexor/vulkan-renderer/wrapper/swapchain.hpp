@@ -1,5 +1,7 @@
 #pragma once
 
+#include "inexor/vulkan-renderer/deletion_queue.hpp"
+
 #include <vulkan/vulkan_core.h>
 
 #include <stdexcept>
@@ -51,7 +53,11 @@ public:
     /// @brief The swapchain needs to be recreated if it has been invalidated.
     /// @note We must pass width and height as call by reference!
     /// This happens for example when the window gets resized.
-    void recreate(std::uint32_t window_width, std::uint32_t window_height);
+    /// @param window_width [in] The requested width of the window.
+    /// @param window_height [in] The requested height of the window.
+    /// @param deletion_queue [in] The old swapchain and its image views are destroyed through this queue, as frames
+    /// which are still in flight might use them.
+    void recreate(std::uint32_t window_width, std::uint32_t window_height, DeletionQueue &deletion_queue);
 
     [[nodiscard]] const VkSwapchainKHR *get_swapchain_ptr() const {
         return &swapchain;
@@ -82,6 +88,10 @@ public:
         return swapchain_image_views.at(index);
     }
 
+    [[nodiscard]] const std::vector<VkImage> &get_images() const {
+        return swapchain_images;
+    }
+
     [[nodiscard]] std::vector<VkImageView> get_image_views() const {
         return swapchain_image_views;
     }
@@ -1,11 +1,13 @@
 #pragma once
 
-#include "inexor/vulkan-renderer/wrapper/gpu_memory_buffer.hpp"
+#include "inexor/vulkan-renderer/io/image_file.hpp"
+#include "inexor/vulkan-renderer/io/ktx2_file.hpp"
+#include "inexor/vulkan-renderer/upload_manager.hpp"
 #include "inexor/vulkan-renderer/wrapper/image.hpp"
-#include "inexor/vulkan-renderer/wrapper/once_command_buffer.hpp"
 
 #include <vulkan/vulkan_core.h>
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -13,7 +15,6 @@ namespace inexor::vulkan_renderer::wrapper {
 
 // TODO: 3D textures and cube maps.
 // TODO: Scan asset directory automatically.
-// TODO: Create multiple textures from file and submit them in 1 command buffer for performance reasons.
 
 class Texture {
 private:
@@ -24,24 +25,22 @@ private:
     int texture_width = 0;
     int texture_height = 0;
     int texture_channels = 0;
-    int mip_levels = 0;
+    std::uint32_t mip_levels = 1;
 
     VkDevice device;
     VkSampler sampler;
     VmaAllocator vma_allocator;
-    VkQueue data_transfer_queue;
     VkPhysicalDevice graphics_card;
 
-    std::uint32_t data_transfer_queue_family_index;
-    const VkFormat texture_image_format = VK_FORMAT_R8G8B8A8_UNORM;
+    VkFormat texture_image_format = VK_FORMAT_R8G8B8A8_UNORM;
 
-    OnceCommandBuffer copy_command_buffer;
+    /// @brief Creates the image with a full mip chain and requests the upload of the texture data.
+    /// The mip levels are generated with blits on the graphics card if the texture format supports it, otherwise they
+    /// are downsampled on the CPU and uploaded together with the first level.
+    void create_texture(const void *texture_data, const std::size_t texture_size, UploadManager &upload_manager);
 
-    ///
-    void create_texture(void *texture_data, const std::size_t texture_size);
-
-    ///
-    void transition_image_layout(VkImage image, VkFormat format, VkImageLayout old_layout, VkImageLayout new_layout);
+    /// @brief Creates the image and requests the upload of all mip levels of a KTX 2.0 file.
+    void create_texture(const io::Ktx2File &ktx2_file, UploadManager &upload_manager);
 
     ///
     void create_texture_sampler();
@@ -61,11 +60,21 @@ public:
     /// @param vma_allocator [in] The Vulkan Memory Allocator library handle.
     /// @param file_name [in] The file name of the texture.
     /// @param name [in] The internal memory allocation name of the texture.
-    /// @param data_transfer_queue [in] The Vulkan data transfer queue.
-    /// @param data_transfer_queue_family_index [in] The queue family index of the data transfer queue to use.
+    /// @param upload_manager [in] The upload manager which copies the texture data into the image. The texture must
+    /// not be used before the batch of the upload is available.
+    Texture(const VkDevice device, const VkPhysicalDevice graphics_card, const VmaAllocator vma_allocator,
+            const std::string &file_name, const std::string &name, UploadManager &upload_manager);
+
+    /// @brief Creates a texture from a decoded image file.
+    /// @param device [in] The Vulkan device from which the texture will be created.
+    /// @param graphics_card [in] The graphics card.
+    /// @param vma_allocator [in] The Vulkan Memory Allocator library handle.
+    /// @param image_file [in] The decoded image file, which may have been loaded on another thread.
+    /// @param name [in] The internal memory allocation name of the texture.
+    /// @param upload_manager [in] The upload manager which copies the texture data into the image. The texture must
+    /// not be used before the batch of the upload is available.
     Texture(const VkDevice device, const VkPhysicalDevice graphics_card, const VmaAllocator vma_allocator,
-            const std::string &file_name, const std::string &name, const VkQueue data_transfer_queue,
-            const std::uint32_t data_transfer_queue_family_index);
+            const io::ImageFile &image_file, const std::string &name, UploadManager &upload_manager);
 
     /// @brief Creates a texture from memory.
     /// @param device [in] The Vulkan device from which the texture will be created.
@@ -74,14 +83,33 @@ public:
     /// @param texture_data [in] The texture data.
     /// @param texture_size [in] The size of the texture.
     /// @param name [in] The internal memory allocation name of the texture.
-    /// @param data_transfer_queue [in] The Vulkan data transfer queue.
-    /// @param data_transfer_queue_family_index [in] The queue family index of the data transfer queue to use.
+    /// @param upload_manager [in] The upload manager which copies the texture data into the image. The texture must
+    /// not be used before the batch of the upload is available.
     Texture(const VkDevice device, const VkPhysicalDevice graphics_card, const VmaAllocator vma_allocator,
             void *texture_data, const std::size_t texture_size, const std::string &name,
-            const VkQueue data_transfer_queue, const std::uint32_t data_transfer_queue_family_index);
+            UploadManager &upload_manager);
+
+    /// @brief Creates a texture from a KTX 2.0 file, whose texel data (e.g. BCn blocks) is uploaded without any
+    /// conversion.
+    /// @param device [in] The Vulkan device from which the texture will be created.
+    /// @param graphics_card [in] The graphics card.
+    /// @param vma_allocator [in] The Vulkan Memory Allocator library handle.
+    /// @param ktx2_file [in] The KTX 2.0 file, whose format must be supported, see is_format_supported().
+    /// @param name [in] The internal memory allocation name of the texture.
+    /// @param upload_manager [in] The upload manager which copies the texture data into the image. The texture must
+    /// not be used before the batch of the upload is available.
+    Texture(const VkDevice device, const VkPhysicalDevice graphics_card, const VmaAllocator vma_allocator,
+            const io::Ktx2File &ktx2_file, const std::string &name, UploadManager &upload_manager);
 
     ~Texture();
 
+    /// @brief Returns true if textures of the given format can be sampled with linear filtering.
+    /// @note Block compressed formats are only supported if textureCompressionBC is enabled, which Device does if
+    /// the graphics card supports it.
+    /// @param graphics_card [in] The graphics card.
+    /// @param format [in] The texture format.
+    [[nodiscard]] static bool is_format_supported(VkPhysicalDevice graphics_card, VkFormat format);
+
     [[nodiscard]] const std::string &get_name() const {
         return name;
     }
@@ -90,6 +118,12 @@ public:
         return file_name;
     }
 
+    /// @brief Returns the size of the device memory of the texture in bytes.
+    [[nodiscard]] VkDeviceSize get_memory_size() const {
+        assert(texture_image);
+        return texture_image->get_allocation_size();
+    }
+
     [[nodiscard]] const VkImage get_image() const {
         assert(texture_image);
         return texture_image->get();
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "inexor/vulkan-renderer/wrapper/gpu_memory_buffer.hpp"
+
+#include <vulkan/vulkan_core.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+namespace inexor::vulkan_renderer::wrapper {
+
+/// @brief A persistently mapped uniform buffer which is divided into one region per frame in flight.
+/// Uniform data of passes and draws is sub-allocated from the region of the current frame and bound with
+/// VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, using the offset returned by allocate() as dynamic offset. A frame never
+/// writes into the region of another frame which the device might still read from, and a single descriptor set can be
+/// used for any number of objects.
+class UniformRingBuffer : public GPUMemoryBuffer {
+private:
+    VkDeviceSize frame_size;
+    VkDeviceSize alignment;
+    std::uint32_t frame_count;
+
+    /// The offset of the current frame's region in the buffer.
+    VkDeviceSize frame_begin = 0;
+
+    /// The number of bytes allocated from the current frame's region.
+    std::atomic<VkDeviceSize> frame_offset = 0;
+
+public:
+    /// @brief Creates a new uniform ring buffer.
+    /// @param device [in] The Vulkan device from which the buffer will be created.
+    /// @param vma_allocator [in] The Vulkan Memory Allocator library handle.
+    /// @param name [in] The internal name of the buffer.
+    /// @param frame_size [in] The number of bytes available to every frame in flight.
+    /// @param frame_count [in] The number of frames in flight.
+    /// @param alignment [in] The alignment of every allocation, which must be a power of two. This is usually
+    /// VkPhysicalDeviceLimits::minUniformBufferOffsetAlignment.
+    UniformRingBuffer(const VkDevice &device, const VmaAllocator &vma_allocator, const std::string &name,
+                      VkDeviceSize frame_size, std::uint32_t frame_count, VkDeviceSize alignment);
+
+    /// Delete the copy constructor so uniform ring buffers are neither copyable nor movable, as other threads might
+    /// allocate from them.
+    UniformRingBuffer(const UniformRingBuffer &) = delete;
+    UniformRingBuffer(UniformRingBuffer &&) = delete;
+
+    UniformRingBuffer &operator=(const UniformRingBuffer &) = delete;
+    UniformRingBuffer &operator=(UniformRingBuffer &&) = delete;
+
+    ~UniformRingBuffer() override = default;
+
+    /// @brief Starts allocating from the region of a frame in flight. All previous allocations of that frame are
+    /// discarded.
+    /// @param frame_index [in] The index of the frame in flight.
+    /// @warning The device must have finished executing the frame's command buffers.
+    void begin_frame(std::uint32_t frame_index);
+
+    /// @brief Copies data into the current frame's region.
+    /// @param data [in] The uniform data.
+    /// @param size [in] The size of the data in bytes.
+    /// @return The dynamic offset of the data.
+    /// @throws std::runtime_error If the region of the current frame is full.
+    /// @note This may be called from several threads at the same time.
+    [[nodiscard]] std::uint32_t allocate(const void *data, std::size_t size);
+
+    template <typename T>
+    [[nodiscard]] std::uint32_t allocate(const T &data) {
+        return allocate(&data, sizeof(T));
+    }
+
+    /// @brief Makes the data of the current frame visible to the device if the memory is not host coherent.
+    /// This must be called after the last allocation of a frame, before its command buffers are submitted.
+    void flush();
+
+    [[nodiscard]] VkDeviceSize get_frame_size() const {
+        return frame_size;
+    }
+
+    /// @brief Returns the number of bytes allocated from the current frame's region.
+    [[nodiscard]] VkDeviceSize get_used_size() const {
+        return std::min(frame_offset.load(std::memory_order_relaxed), frame_size);
+    }
+};
+
+} // namespace inexor::vulkan_renderer::wrapper
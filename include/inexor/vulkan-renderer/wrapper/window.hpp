@@ -34,8 +34,8 @@ public:
 
     ~Window();
 
-    /// @brief Waits until window size is greater than 0.
-    void wait_for_focus();
+    /// @brief Queries the current size of the window's framebuffer, which is 0 x 0 while the window is minimized.
+    void update_size();
 
     /// @brief Changes the title of the window.
     /// @param title [in] The title of the window.
@@ -65,6 +65,10 @@ public:
     /// @brief Updates window messages.
     void poll();
 
+    /// @brief Sleeps until window messages arrive or the timeout has passed, and updates them.
+    /// @param timeout [in] The maximum time to wait in seconds.
+    void wait_events(double timeout);
+
     /// @brief Checks if the window has received a close message.
     bool should_close();
 
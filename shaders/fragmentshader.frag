@@ -1,12 +1,19 @@
 #version 450
 
-layout(binding = 1) uniform sampler2D texSampler;
+// The size of the texture array depends on the graphics card, so it is set when the pipeline is created.
+layout(constant_id = 0) const uint TEXTURE_ARRAY_SIZE = 1;
+
+// All textures are bound as one array, the draw selects its texture by index. The index is taken from a push constant,
+// so it is dynamically uniform within every draw and no nonuniformEXT qualifier is needed. This requires the
+// shaderSampledImageArrayDynamicIndexing feature, which the device enables.
+layout(set = 1, binding = 0) uniform sampler2D textures[TEXTURE_ARRAY_SIZE];
 
 layout(location = 0) in vec3 fragColor;
 layout(location = 1) in vec2 fragTexCoord;
+layout(location = 2) flat in uint fragTextureIndex;
 
 layout(location = 0) out vec4 outColor;
 
 void main() {
-	outColor = vec4(fragColor * texture(texSampler, fragTexCoord).rgb, 1.0);
+	outColor = vec4(fragColor * texture(textures[fragTextureIndex], fragTexCoord).rgb, 1.0);
 }
@@ -1,10 +1,16 @@
 #version 450
 
-layout(binding = 0) uniform UniformBufferObject {
-    mat4 model;
+// The uniform buffer is bound with a dynamic offset into the uniform ring buffer.
+layout(binding = 0) uniform PassUniformBufferObject {
     mat4 view;
     mat4 proj;
-} ubo;
+} pass;
+
+// The data of every draw is pushed into the command buffer.
+layout(push_constant) uniform DrawPushConstants {
+    mat4 model;
+    uint texture_index;
+} draw;
 
 layout(location = 0) in vec3 inPosition;
 layout(location = 1) in vec3 inColor;
@@ -12,9 +18,11 @@ layout(location = 2) in vec2 inTexCoord;
 
 layout(location = 0) out vec3 fragColor;
 layout(location = 1) out vec2 fragTexCoord;
+layout(location = 2) flat out uint fragTextureIndex;
 
 void main() {
-    gl_Position = ubo.proj * ubo.view * ubo.model * vec4(inPosition, 1.0);
+    gl_Position = pass.proj * pass.view * draw.model * vec4(inPosition, 1.0);
     fragColor = inColor;
     fragTexCoord = inTexCoord;
+    fragTextureIndex = draw.texture_index;
 }
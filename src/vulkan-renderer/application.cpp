@@ -2,8 +2,12 @@
 
 #include "inexor/vulkan-renderer/debug_callback.hpp"
 #include "inexor/vulkan-renderer/error_handling.hpp"
+#include "inexor/vulkan-renderer/frame_arena.hpp"
 #include "inexor/vulkan-renderer/octree_vertex.hpp"
 #include "inexor/vulkan-renderer/standard_ubo.hpp"
+#ifdef INEXOR_USE_COROUTINES
+#include "inexor/vulkan-renderer/task.hpp"
+#endif
 #include "inexor/vulkan-renderer/tools/cla_parser.hpp"
 #include "inexor/vulkan-renderer/world/cube.hpp"
 
@@ -11,8 +15,89 @@
 #include <spdlog/spdlog.h>
 #include <toml11/toml.hpp>
 
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <deque>
+#include <filesystem>
+#include <future>
+#include <numeric>
+#include <variant>
+
+namespace {
+
+/// @brief Logs the average, median, 95th percentile and maximum of a list of frame times.
+/// @param name [in] The name of the measurement.
+/// @param frame_times [in] The frame times in milliseconds.
+void log_frame_times(const std::string &name, std::vector<double> frame_times) {
+    if (frame_times.empty()) {
+        spdlog::warn("No {} frame times available.", name);
+        return;
+    }
+
+    std::sort(frame_times.begin(), frame_times.end());
+
+    const double average = std::accumulate(frame_times.begin(), frame_times.end(), 0.0) / frame_times.size();
+    const double median = frame_times[frame_times.size() / 2];
+    const double percentile_95 = frame_times[std::min(frame_times.size() - 1, frame_times.size() * 95 / 100)];
+
+    spdlog::info("{} frame times over {} frames: avg {:.3f} ms, min {:.3f} ms, median {:.3f} ms, 95th percentile "
+                 "{:.3f} ms, max {:.3f} ms.",
+                 name, frame_times.size(), average, frame_times.front(), median, percentile_95, frame_times.back());
+}
+
+} // namespace
+
 namespace inexor::vulkan_renderer {
 
+namespace {
+
+/// The distance between the octree chunks of the world.
+constexpr float OCTREE_CHUNK_SPACING = 3.0f;
+
+/// The maximum number of texture files which are decoded on the threadpool at the same time. This limits the memory
+/// used by decoded textures whose upload has not been recorded yet.
+constexpr std::size_t MAX_PENDING_TEXTURE_DECODES = 16;
+
+/// A decoded texture file, which is either a KTX 2.0 file or an image file decoded by stb_image.
+using TextureFile = std::variant<io::Ktx2File, io::ImageFile>;
+
+/// @brief Reads and decodes a texture file. This is thread safe, so it can run on the threadpool.
+/// A KTX 2.0 file next to the texture file is created by the texture converter tool. Its block compressed texel data
+/// is preferred if the graphics card supports it, which saves decoding the file and generating the mip levels.
+/// Otherwise the decoded and mipmapped texture is taken from the texture cache, if it is enabled.
+/// @param graphics_card [in] The graphics card.
+/// @param texture_cache [in] The texture cache, or nullptr to decode the texture file directly.
+/// @param texture_file [in] The name of the texture file.
+TextureFile load_texture_file(const VkPhysicalDevice graphics_card, io::TextureCache *texture_cache,
+                              const std::string &texture_file) {
+    const auto ktx2_file_name = std::filesystem::path(texture_file).replace_extension(".ktx2");
+
+    if (std::filesystem::exists(ktx2_file_name)) {
+        io::Ktx2File ktx2_file(ktx2_file_name);
+
+        if (wrapper::Texture::is_format_supported(graphics_card, ktx2_file.get_format())) {
+            return ktx2_file;
+        }
+
+        spdlog::warn("Format {} of texture {} is not supported, using {} instead.", ktx2_file.get_format(),
+                     ktx2_file_name.string(), texture_file);
+    }
+
+    if (texture_cache != nullptr) {
+        try {
+            return texture_cache->load(texture_file);
+        } catch (const std::runtime_error &exception) {
+            spdlog::warn("{} Loading texture {} without the texture cache.", exception.what(), texture_file);
+        }
+    }
+
+    return io::ImageFile(texture_file);
+}
+
+} // namespace
+
 /// @brief Static callback for window resize events.
 /// @note Because GLFW is a C-style API, we can't pass a poiner to a class method, so we have to do it this way!
 /// @param window The GLFW window.
@@ -122,10 +207,83 @@ VkResult Application::load_textures() {
     // Insert the new texture into the list of textures.
     std::string texture_name = "unnamed texture";
 
-    for (const auto &texture_file : texture_files) {
-        textures.emplace_back(vkdevice->get_device(), vkdevice->get_physical_device(), vma->get_allocator(),
-                              texture_file, texture_name, vkdevice->get_graphics_queue(),
-                              vkdevice->get_graphics_queue_family_index());
+    // For measuring the load time of a large number of textures, the configured textures are repeated until
+    // --texture-count textures have been loaded.
+    std::vector<std::string> files_to_load = texture_files;
+
+    if (texture_count > 0 && !texture_files.empty()) {
+        files_to_load.resize(texture_count);
+        for (std::size_t i = texture_files.size(); i < files_to_load.size(); i++) {
+            files_to_load[i] = texture_files[i % texture_files.size()];
+        }
+    }
+
+    const VkPhysicalDevice graphics_card = vkdevice->get_physical_device();
+
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t ktx2_texture_count = 0;
+
+    // Decoding the texture files is the expensive part, so it runs on the threadpool. The uploads are recorded on this
+    // thread as soon as the decoded textures arrive, in the order of the configuration.
+    std::deque<std::future<TextureFile>> pending_decodes;
+    std::size_t next_decode = 0;
+
+    textures.reserve(textures.size() + files_to_load.size());
+
+    for (std::size_t i = 0; i < files_to_load.size(); i++) {
+        while (parallel_texture_decoding && next_decode < files_to_load.size() &&
+               next_decode < i + MAX_PENDING_TEXTURE_DECODES) {
+            pending_decodes.push_back(thread_pool->execute(load_texture_file, graphics_card, texture_cache.get(),
+                                                           files_to_load[next_decode]));
+            next_decode++;
+        }
+
+        // Exceptions from loading a texture file are rethrown here.
+        const TextureFile texture_file = parallel_texture_decoding
+                                             ? pending_decodes.front().get()
+                                             : load_texture_file(graphics_card, texture_cache.get(), files_to_load[i]);
+
+        if (parallel_texture_decoding) {
+            pending_decodes.pop_front();
+        }
+
+        if (std::holds_alternative<io::Ktx2File>(texture_file)) {
+            ktx2_texture_count++;
+        }
+
+        std::visit(
+            [&](const auto &file) {
+                textures.emplace_back(vkdevice->get_device(), graphics_card, vma->get_allocator(), file, texture_name,
+                                      *upload_manager);
+            },
+            texture_file);
+    }
+
+    const std::chrono::duration<double, std::milli> load_time = std::chrono::steady_clock::now() - start;
+
+    // Draws select their texture by its index in the texture array.
+    for (const auto &texture : textures) {
+        if (texture_array->get_size() == texture_array->get_capacity()) {
+            spdlog::warn("The texture array is full, only {} of {} textures can be used by the shaders.",
+                         texture_array->get_size(), textures.size());
+            break;
+        }
+        texture_array->add(texture);
+    }
+
+    VkDeviceSize texture_memory_size = 0;
+    for (const auto &texture : textures) {
+        texture_memory_size += texture.get_memory_size();
+    }
+
+    spdlog::info("Loaded {} textures ({} of them from KTX 2.0 files) with {} decoding in {:.2f} ms, using {:.2f} MB of "
+                 "device memory.",
+                 textures.size(), ktx2_texture_count, parallel_texture_decoding ? "parallel" : "serial",
+                 load_time.count(), static_cast<double>(texture_memory_size) / (1024 * 1024));
+
+    if (texture_cache) {
+        spdlog::info("Texture cache: {} hits, {} misses.", texture_cache->get_hit_count(),
+                     texture_cache->get_miss_count());
     }
 
     return VK_SUCCESS;
@@ -180,6 +338,25 @@ VkResult Application::render_frame() {
 
     in_flight_fences[current_frame].block();
 
+    // Everything which was retired until this frame in flight was submitted last is no longer used by the device.
+    deletion_queue.release(in_flight_frame_numbers[current_frame]);
+
+    // Transient per-frame allocations of the previous frame are no longer needed.
+    FrameArena::begin_frame();
+
+#ifdef INEXOR_USE_COROUTINES
+    // Resume the coroutines whose fences have been signaled since the last frame.
+    fence_waiter->update();
+#endif
+
+    // Nothing is rendered while the window is minimized, but the application keeps running.
+    if (swapchain_recreation_pending) {
+        const VkResult result = recreate_swapchain();
+        if (result != VK_SUCCESS || swapchain_recreation_pending) {
+            return result;
+        }
+    }
+
     std::uint32_t image_index = 0;
     VkResult result =
         vkAcquireNextImageKHR(vkdevice->get_device(), swapchain->get_swapchain(), UINT64_MAX,
@@ -204,6 +381,9 @@ VkResult Application::render_frame() {
         exit(-1);
     }
 
+    result = record_command_buffer(static_cast<std::uint32_t>(current_frame), image_index);
+    vulkan_error_check(result);
+
     const VkPipelineStageFlags wait_stage_mask[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
 
     submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
@@ -211,7 +391,7 @@ VkResult Application::render_frame() {
     submit_info.waitSemaphoreCount = 1;
     submit_info.pWaitDstStageMask = wait_stage_mask;
     submit_info.commandBufferCount = 1;
-    submit_info.pCommandBuffers = command_buffers[image_index].get_ptr();
+    submit_info.pCommandBuffers = command_buffers[current_frame].get_ptr();
     submit_info.signalSemaphoreCount = 1;
     submit_info.pWaitSemaphores = image_available_semaphores[current_frame].get_ptr();
     submit_info.pSignalSemaphores = rendering_finished_semaphores[current_frame].get_ptr();
@@ -223,6 +403,8 @@ VkResult Application::render_frame() {
         return result;
     }
 
+    in_flight_frame_numbers[current_frame] = deletion_queue.end_frame();
+
     present_info.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
     present_info.pNext = nullptr;
     present_info.waitSemaphoreCount = 1;
@@ -239,7 +421,10 @@ VkResult Application::render_frame() {
     // in a consistent state, otherwise a signalled semaphore may never be properly waited upon.
     if (result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || frame_buffer_resized) {
         frame_buffer_resized = false;
-        recreate_swapchain();
+        result = recreate_swapchain();
+        if (result != VK_SUCCESS) {
+            return result;
+        }
     }
 
     current_frame = (current_frame + 1) % MAX_FRAMES_IN_FLIGHT;
@@ -249,11 +434,61 @@ VkResult Application::render_frame() {
     if (fps_value) {
         window->set_title("Inexor Vulkan API renderer demo - " + std::to_string(*fps_value) + " FPS");
         spdlog::debug("FPS: {}, window size: {} x {}.", *fps_value, window->get_width(), window->get_height());
+
+        if (chunk_culling_stats) {
+            spdlog::debug("Chunks drawn in last frame: {}, culled: {}.", chunk_culling_stats->drawn_count,
+                          chunk_culling_stats->culled_count);
+        }
+
+        const auto frame_arena_stats = FrameArena::get_last_frame_stats();
+        spdlog::debug("Frame arena allocations in last frame: {} ({} bytes).", frame_arena_stats.allocation_count,
+                      frame_arena_stats.allocated_bytes);
+
+        if (thread_pool->is_instrumentation_enabled()) {
+            log_thread_pool_stats();
+        }
     }
 
     return VK_SUCCESS;
 }
 
+void Application::log_thread_pool_stats() {
+    const auto stats = thread_pool->get_stats();
+
+    for (const auto priority : {TaskPriority::FRAME_CRITICAL, TaskPriority::BACKGROUND}) {
+        const auto index = static_cast<std::size_t>(priority);
+        const auto &queue_latency = thread_pool->get_queue_latency_histogram(priority);
+        const auto &execution_time = thread_pool->get_execution_time_histogram(priority);
+
+        spdlog::debug("Threadpool {} tasks: {} enqueued, {} completed, {} queued, wait avg {} us max {} us, execution "
+                      "avg {} us max {} us.",
+                      priority == TaskPriority::FRAME_CRITICAL ? "frame-critical" : "background",
+                      stats.enqueued_tasks[index], stats.completed_tasks[index], stats.queue_depth[index],
+                      queue_latency.get_average().count(), queue_latency.get_max().count(),
+                      execution_time.get_average().count(), execution_time.get_max().count());
+    }
+
+    std::string utilization;
+    for (const auto worker_utilization : stats.worker_utilization) {
+        utilization += std::to_string(static_cast<int>(worker_utilization * 100.0f)) + "% ";
+    }
+    spdlog::debug("Threadpool worker utilization: {}", utilization);
+
+    thread_pool->reset_stats();
+}
+
+void Application::log_upload_stats(const std::chrono::duration<double> load_time) {
+    const auto &stats = upload_manager->get_stats();
+    const double megabytes = static_cast<double>(stats.uploaded_bytes) / (1024.0 * 1024.0);
+
+    spdlog::info("Uploaded {} resources ({:.2f} MB) in {:.2f} ms ({:.2f} MB/s) using the staging ring, {} additional "
+                 "staging buffer allocations and {} stalls on the full staging ring.",
+                 stats.upload_count, megabytes, load_time.count() * 1000.0, megabytes / load_time.count(),
+                 stats.staging_allocation_count, stats.staging_ring_stall_count);
+
+    upload_manager->reset_stats();
+}
+
 VkResult Application::load_octree_geometry() {
     spdlog::debug("Creating octree geometry.");
 
@@ -266,26 +501,58 @@ VkResult Application::load_octree_geometry() {
         child->indent(1, false, 2);
     }
 
-    std::vector<OctreeVertex> octree_vertices;
+    std::pmr::vector<glm::vec3> octree_positions(&FrameArena::get());
     for (const auto &polygons : cube->polygons(true)) {
         for (const auto &triangle : *polygons) {
-            for (const auto &vertex : triangle) {
-                glm::vec3 color = {
-                    static_cast<float>(rand()) / static_cast<float>(RAND_MAX),
-                    static_cast<float>(rand()) / static_cast<float>(RAND_MAX),
-                    static_cast<float>(rand()) / static_cast<float>(RAND_MAX),
-                };
-                octree_vertices.emplace_back(vertex, color);
-            }
+            octree_positions.insert(octree_positions.end(), triangle.begin(), triangle.end());
         }
     }
 
-    const std::string octree_mesh_name = "unnamed octree";
+    const auto vertex_count = static_cast<std::uint32_t>(octree_positions.size());
+
+    // The bounding box of the octree, which the chunk culler tests every chunk with.
+    wrapper::ChunkMeshBuffer::Bounds octree_bounds{octree_positions.front(), octree_positions.front()};
+    for (const auto &position : octree_positions) {
+        octree_bounds.min = glm::min(octree_bounds.min, position);
+        octree_bounds.max = glm::max(octree_bounds.max, position);
+    }
+
+    // The world consists of one copy of the octree for every chunk, laid out on a square grid.
+    const auto grid_size = static_cast<std::uint32_t>(std::ceil(std::sqrt(static_cast<double>(octree_draw_count))));
+
+    chunk_meshes = std::make_unique<wrapper::ChunkMeshBuffer>(vkdevice->get_device(), vma->get_allocator(),
+                                                              "octree chunks", sizeof(OctreeVertex),
+                                                              vertex_count * octree_draw_count,
+                                                              vertex_count * octree_draw_count);
+
+    // The octree does not share vertices between triangles yet, so every vertex is indexed once.
+    std::pmr::vector<std::uint32_t> chunk_indices(vertex_count, &FrameArena::get());
+    std::iota(chunk_indices.begin(), chunk_indices.end(), 0);
+
+    // The vertices are only needed until they have been uploaded into the chunk mesh buffer.
+    std::pmr::vector<OctreeVertex> chunk_vertices(&FrameArena::get());
+    chunk_vertices.reserve(vertex_count);
+
+    for (std::uint32_t chunk = 0; chunk < octree_draw_count; chunk++) {
+        const glm::vec3 chunk_offset{OCTREE_CHUNK_SPACING * static_cast<float>(chunk % grid_size), 0.0f,
+                                     -OCTREE_CHUNK_SPACING * static_cast<float>(chunk / grid_size)};
+
+        chunk_vertices.clear();
+        for (const auto &position : octree_positions) {
+            glm::vec3 color = {
+                static_cast<float>(rand()) / static_cast<float>(RAND_MAX),
+                static_cast<float>(rand()) / static_cast<float>(RAND_MAX),
+                static_cast<float>(rand()) / static_cast<float>(RAND_MAX),
+            };
+            chunk_vertices.emplace_back(position + chunk_offset, color);
+        }
+
+        chunk_meshes->add_chunk(*upload_manager, chunk_vertices.data(), vertex_count, chunk_indices.data(),
+                                vertex_count, {octree_bounds.min + chunk_offset, octree_bounds.max + chunk_offset});
+    }
 
-    // Create a mesh buffer for octree vertex geometry.
-    mesh_buffers.emplace_back(vkdevice->get_device(), vkdevice->get_transfer_queue(),
-                              vkdevice->get_transfer_queue_family_index(), vma->get_allocator(), octree_mesh_name,
-                              sizeof(OctreeVertex), octree_vertices.size(), octree_vertices.data());
+    chunk_draw_buffer = std::make_unique<wrapper::IndirectDrawBuffer>(
+        vkdevice->get_device(), vma->get_allocator(), "octree chunk draws", octree_draw_count, MAX_FRAMES_IN_FLIGHT);
 
     return VK_SUCCESS;
 }
@@ -322,6 +589,8 @@ VkResult Application::check_application_specific_features() {
 
 VkResult Application::init(int argc, char **argv) {
     spdlog::debug("Initialising vulkan-renderer.");
+
+    const auto init_start = std::chrono::steady_clock::now();
     spdlog::debug("Initialising thread-pool with {} threads.", std::thread::hardware_concurrency());
 
     tools::CommandLineArgumentParser cla_parser;
@@ -329,6 +598,53 @@ VkResult Application::init(int argc, char **argv) {
 
     // Initialise Inexor thread-pool.
     thread_pool = std::make_shared<ThreadPool>();
+#ifdef INEXOR_USE_COROUTINES
+    fence_waiter.reset(new FenceWaiter(*thread_pool));
+#endif
+
+    // If the user specified command line argument "--headless", no window will be created. The renderer draws a fixed
+    // number of frames (--frames <number>) into offscreen images and reports the frame times.
+    auto enable_headless = cla_parser.get_arg<bool>("--headless");
+    if (enable_headless.value_or(false)) {
+        headless = true;
+        headless_frame_count = cla_parser.get_arg<std::uint32_t>("--frames").value_or(headless_frame_count);
+        spdlog::debug("--headless specified, rendering {} frames without a window.", headless_frame_count);
+    }
+
+    // The octree stage is recorded on up to --record-threads threads. For benchmarking the number of draws, the octree
+    // world can be built from --draws chunks, every chunk is one draw. The chunks are drawn with indirect draw calls
+    // unless --no-indirect-draws is specified, which records one draw call per chunk instead.
+    recording_thread_count = std::max(
+        1u, cla_parser.get_arg<std::uint32_t>("--record-threads").value_or(DEFAULT_RECORDING_THREAD_COUNT));
+    octree_draw_count = std::max(1u, cla_parser.get_arg<std::uint32_t>("--draws").value_or(octree_draw_count));
+    indirect_drawing_enabled = !cla_parser.get_arg<bool>("--no-indirect-draws").value_or(false);
+
+    spdlog::debug("Drawing {} octree chunks with {} draw calls on up to {} threads.", octree_draw_count,
+                  indirect_drawing_enabled ? "indirect" : "direct", recording_thread_count);
+
+    // Indirectly drawn chunks are culled against the view frustum and the depth buffer of the previous frame on the
+    // device. --no-gpu-culling draws all chunks, --no-occlusion-culling only culls against the view frustum.
+    gpu_culling_enabled = !cla_parser.get_arg<bool>("--no-gpu-culling").value_or(false);
+    occlusion_culling_enabled = !cla_parser.get_arg<bool>("--no-occlusion-culling").value_or(false);
+
+    if (indirect_drawing_enabled && gpu_culling_enabled) {
+        spdlog::debug("Culling the octree chunks on the device {} occlusion culling.",
+                      occlusion_culling_enabled ? "with" : "without");
+    }
+
+    // The textures are decoded on the threadpool unless --serial-texture-decoding is specified. For measuring the load
+    // time, --texture-count <number> loads the configured textures repeatedly.
+    parallel_texture_decoding = !cla_parser.get_arg<bool>("--serial-texture-decoding").value_or(false);
+    texture_count = cla_parser.get_arg<std::uint32_t>("--texture-count").value_or(texture_count);
+
+    // Decoded and mipmapped textures are cached on disk unless --no-texture-cache is specified.
+    texture_cache_enabled = !cla_parser.get_arg<bool>("--no-texture-cache").value_or(false);
+
+    auto enable_threadpool_stats = cla_parser.get_arg<bool>("--threadpool-stats");
+    if (enable_threadpool_stats.value_or(false)) {
+        spdlog::debug("--threadpool-stats specified, enabling threadpool instrumentation.");
+        thread_pool->set_instrumentation_enabled(true);
+    }
 
     // Load the configuration from the TOML file.
     VkResult result = load_toml_configuration_file("configuration/renderer.toml");
@@ -361,22 +677,28 @@ VkResult Application::init(int argc, char **argv) {
 
     spdlog::debug("Creating Vulkan instance.");
 
-    glfw_context = std::make_unique<wrapper::GLFWContext>();
+    if (headless) {
+        vkinstance = std::make_unique<wrapper::Instance>(application_name, engine_name, application_version,
+                                                         engine_version, VK_API_VERSION_1_1, std::vector<std::string>{},
+                                                         std::vector<std::string>{}, true, false, false);
+    } else {
+        glfw_context = std::make_unique<wrapper::GLFWContext>();
 
-    vkinstance = std::make_unique<wrapper::Instance>(application_name, engine_name, application_version, engine_version,
-                                                     VK_API_VERSION_1_1);
+        vkinstance = std::make_unique<wrapper::Instance>(application_name, engine_name, application_version,
+                                                         engine_version, VK_API_VERSION_1_1);
 
-    window = std::make_unique<wrapper::Window>(window_title, window_width, window_height, true, true);
+        window = std::make_unique<wrapper::Window>(window_title, window_width, window_height, true, true);
 
-    surface = std::make_unique<wrapper::WindowSurface>(vkinstance->get_instance(), window->get());
+        surface = std::make_unique<wrapper::WindowSurface>(vkinstance->get_instance(), window->get());
 
-    spdlog::debug("Storing GLFW window user pointer.");
+        spdlog::debug("Storing GLFW window user pointer.");
 
-    window->set_user_ptr(this);
+        window->set_user_ptr(this);
 
-    spdlog::debug("Setting up framebuffer resize callback.");
+        spdlog::debug("Setting up framebuffer resize callback.");
 
-    window->set_resize_callback(frame_buffer_resize_callback);
+        window->set_resize_callback(frame_buffer_resize_callback);
+    }
 
 #ifndef NDEBUG
     // Check if validation is enabled check for availabiliy of VK_EXT_debug_utils.
@@ -484,9 +806,21 @@ VkResult Application::init(int argc, char **argv) {
         enable_debug_marker_device_extension = false;
     }
 
-    vkdevice =
-        std::make_unique<wrapper::Device>(vkinstance->get_instance(), surface->get(),
-                                          enable_debug_marker_device_extension, use_distinct_data_transfer_queue);
+    // Bind all textures as one partially bound array unless --no-descriptor-indexing is specified.
+    auto forbid_descriptor_indexing = cla_parser.get_arg<bool>("--no-descriptor-indexing");
+    if (forbid_descriptor_indexing.value_or(false)) {
+        spdlog::warn("--no-descriptor-indexing specified, textures are bound as a small fallback array.");
+    }
+
+    vkdevice = std::make_unique<wrapper::Device>(vkinstance->get_instance(), headless ? VK_NULL_HANDLE : surface->get(),
+                                                 enable_debug_marker_device_extension,
+                                                 use_distinct_data_transfer_queue,
+                                                 !forbid_descriptor_indexing.value_or(false));
+
+    // The number of indirect draws is read from the indirect draw buffer if the graphics card supports it, unless
+    // --no-draw-indirect-count is specified.
+    draw_indirect_count_enabled = vkdevice->is_draw_indirect_count_enabled() &&
+                                  !cla_parser.get_arg<bool>("--no-draw-indirect-count").value_or(false);
 
     result = check_application_specific_features();
     vulkan_error_check(result);
@@ -494,83 +828,126 @@ VkResult Application::init(int argc, char **argv) {
     vma = std::make_unique<wrapper::VulkanMemoryAllocator>(vkinstance->get_instance(), vkdevice->get_device(),
                                                            vkdevice->get_physical_device());
 
-    swapchain = std::make_unique<wrapper::Swapchain>(vkdevice->get_device(), vkdevice->get_physical_device(),
-                                                     surface->get(), window->get_width(), window->get_height(),
-                                                     vsync_enabled, "Standard swapchain.");
+    upload_manager = std::make_unique<UploadManager>(vkdevice->get_device(), vma->get_allocator(),
+                                                     vkdevice->get_transfer_queue(),
+                                                     vkdevice->get_transfer_queue_family_index(),
+                                                     vkdevice->get_graphics_queue_family_index(),
+                                                     STAGING_RING_BUFFER_SIZE);
 
-    result = create_depth_buffer();
-    vulkan_error_check(result);
+    pipeline_cache = std::make_unique<wrapper::PipelineCache>(vkdevice->get_device(), vkdevice->get_physical_device(),
+                                                              PIPELINE_CACHE_FILE_NAME);
+
+    if (texture_cache_enabled) {
+        texture_cache = std::make_unique<io::TextureCache>(TEXTURE_CACHE_DIRECTORY);
+    }
 
-    spdlog::debug("Starting to load textures using threadpool.");
+    texture_array = std::make_unique<wrapper::BindlessTextureArray>(
+        vkdevice->get_device(), vkdevice->get_physical_device(), vkdevice->is_descriptor_indexing_enabled(),
+        "Texture array");
+
+    if (headless) {
+        result = create_offscreen_images();
+        vulkan_error_check(result);
+    } else {
+        swapchain = std::make_unique<wrapper::Swapchain>(vkdevice->get_device(), vkdevice->get_physical_device(),
+                                                         surface->get(), window->get_width(), window->get_height(),
+                                                         vsync_enabled, "Standard swapchain.");
+    }
+
+    spdlog::debug("Starting to load textures using {}.", parallel_texture_decoding ? "threadpool" : "main thread");
+
+    const auto load_start = std::chrono::steady_clock::now();
 
     result = load_textures();
     vulkan_error_check(result);
 
-    result = load_shaders();
+    result = load_models();
     vulkan_error_check(result);
 
-    result = create_descriptor_pool();
+    result = load_octree_geometry();
     vulkan_error_check(result);
 
-    result = create_descriptor_set_layouts();
-    vulkan_error_check(result);
+    // All textures and meshes have been recorded into one batch, so this is the only time loading waits for the
+    // device. The first frame acquires the uploaded resources on the graphics queue.
+    upload_manager->wait(upload_manager->submit());
 
-    result = create_pipeline();
+    log_upload_stats(std::chrono::steady_clock::now() - load_start);
+
+    result = load_shaders();
     vulkan_error_check(result);
 
-    result = create_frame_buffers();
+    result = create_descriptor_allocators();
     vulkan_error_check(result);
 
-    command_pool =
-        std::make_unique<wrapper::CommandPool>(vkdevice->get_device(), vkdevice->get_graphics_queue_family_index());
+    result = create_descriptor_set_layouts();
+    vulkan_error_check(result);
 
-    result = create_uniform_buffers();
+    result = setup_render_graph();
     vulkan_error_check(result);
 
-    result = create_descriptor_writes();
+    result = create_pipeline();
     vulkan_error_check(result);
 
-    result = create_command_buffers();
+    result = create_uniform_buffers();
     vulkan_error_check(result);
 
-    result = load_models();
+    result = create_descriptor_sets();
     vulkan_error_check(result);
 
-    result = load_octree_geometry();
+    result = create_chunk_culler();
     vulkan_error_check(result);
 
-    result = record_command_buffers();
+    result = create_command_buffers();
     vulkan_error_check(result);
 
+    if (headless) {
+        result = create_timestamp_queries();
+        vulkan_error_check(result);
+    }
+
     result = create_synchronisation_objects();
     vulkan_error_check(result);
 
     spdlog::debug("Vulkan initialisation finished.");
 
-    spdlog::debug("Showing window.");
+    if (!headless) {
+        spdlog::debug("Showing window.");
+
+        window->show();
+
+        // We must store the window user pointer to be able to call the window resize callback.
+        window->set_user_ptr(this);
+    }
+
+    result = recreate_swapchain();
 
-    window->show();
+    const std::chrono::duration<double, std::milli> init_time = std::chrono::steady_clock::now() - init_start;
 
-    // We must store the window user pointer to be able to call the window resize callback.
-    window->set_user_ptr(this);
+    // Compare the startup time of a run without pipeline cache file (cold) with a second run (warm).
+    spdlog::info("Initialisation took {:.2f} ms with a {} pipeline cache.", init_time.count(),
+                 pipeline_cache->is_loaded_from_file() ? "warm" : "cold");
 
-    return recreate_swapchain();
+    return result;
 }
 
 VkResult Application::update_uniform_buffers(const std::size_t current_image) {
     float time = time_step.get_time_step_since_initialisation();
 
-    UniformBufferObject ubo = {};
+    // The uniform data of the previous use of this frame in flight is no longer needed.
+    uniform_ring_buffer->begin_frame(static_cast<std::uint32_t>(current_image));
 
-    // Rotate the model as a function of time.
-    ubo.model = glm::rotate(glm::mat4(1.0f), /*time */ glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+    PassUniformBufferObject pass_ubo = {};
+
+    pass_ubo.view = game_camera.matrices.view;
+    pass_ubo.proj = game_camera.matrices.perspective;
+    pass_ubo.proj[1][1] *= -1;
 
-    ubo.view = game_camera.matrices.view;
-    ubo.proj = game_camera.matrices.perspective;
-    ubo.proj[1][1] *= -1;
+    pass_uniform_offset = uniform_ring_buffer->allocate(pass_ubo);
+    view_projection = pass_ubo.proj * pass_ubo.view;
 
-    // TODO: Don't use vector of uniform buffers.
-    uniform_buffers[0].update(&ubo, sizeof(ubo));
+    // Rotate the model as a function of time.
+    // The draws push the model matrix into their command buffers while they are recorded.
+    octree_model_matrix = glm::rotate(glm::mat4(1.0f), /*time */ glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f));
 
     return VK_SUCCESS;
 }
@@ -609,9 +986,22 @@ VkResult Application::update_keyboard_input() {
 void Application::run() {
     spdlog::debug("Running Application.");
 
+    if (headless) {
+        run_headless();
+        return;
+    }
+
     while (!window->should_close()) {
-        window->poll();
-        render_frame();
+        // Nothing is rendered while the window is minimized, so sleep until the window is restored instead of spinning.
+        // The timeout keeps the rest of the main loop running.
+        if (swapchain_recreation_pending) {
+            window->wait_events(MINIMIZED_WINDOW_EVENT_TIMEOUT);
+        } else {
+            window->poll();
+        }
+
+        const VkResult result = render_frame();
+        vulkan_error_check(result);
 
         // TODO: Run this in a separated thread?
         // TODO: Merge into one update_game_data() method?
@@ -623,6 +1013,124 @@ void Application::run() {
     }
 }
 
+void Application::run_headless() {
+    assert(headless);
+    assert(headless_frame_count > 0);
+
+    spdlog::debug("Rendering {} frames in headless mode.", headless_frame_count);
+
+    std::vector<double> cpu_frame_times;
+    std::vector<double> gpu_frame_times;
+    std::vector<double> recording_times;
+    cpu_frame_times.reserve(headless_frame_count);
+    gpu_frame_times.reserve(headless_frame_count);
+    recording_times.reserve(headless_frame_count);
+
+    // The timestamps of a command buffer can only be read once it has been submitted at least once.
+    std::array<bool, MAX_FRAMES_IN_FLIGHT> submitted{};
+
+    // The number of chunks the device drew and culled, summed over all frames whose statistics have been read.
+    std::uint64_t drawn_chunk_count = 0;
+    std::uint64_t culled_chunk_count = 0;
+    std::uint32_t culling_stats_frame_count = 0;
+
+    const VkPipelineStageFlags wait_stage_mask[] = {VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT};
+
+    for (std::uint32_t frame = 0; frame < headless_frame_count; frame++) {
+        in_flight_fences[current_frame].block();
+
+        deletion_queue.release(in_flight_frame_numbers[current_frame]);
+
+        if (submitted[current_frame]) {
+            if (auto gpu_frame_time = get_gpu_frame_time(static_cast<std::uint32_t>(current_frame))) {
+                gpu_frame_times.push_back(*gpu_frame_time);
+            }
+        }
+
+        // Waiting for the GPU is not part of the CPU frame time.
+        const auto cpu_frame_start = std::chrono::steady_clock::now();
+
+        FrameArena::begin_frame();
+
+#ifdef INEXOR_USE_COROUTINES
+        fence_waiter->update();
+#endif
+
+        update_cameras();
+        update_uniform_buffers(current_frame);
+
+        // Without a swapchain, there is one offscreen image per frame in flight.
+        const auto recording_start = std::chrono::steady_clock::now();
+
+        VkResult result = record_command_buffer(static_cast<std::uint32_t>(current_frame),
+                                                static_cast<std::uint32_t>(current_frame));
+        vulkan_error_check(result);
+
+        recording_times.push_back(
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - recording_start).count());
+
+        // Recording has read the statistics of the frame which has finished last on this frame in flight.
+        if (chunk_culling_stats) {
+            drawn_chunk_count += chunk_culling_stats->drawn_count;
+            culled_chunk_count += chunk_culling_stats->culled_count;
+            culling_stats_frame_count++;
+        }
+
+        // There is no swapchain, so there are no semaphores to wait for or to signal.
+        submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submit_info.pNext = nullptr;
+        submit_info.waitSemaphoreCount = 0;
+        submit_info.pWaitSemaphores = nullptr;
+        submit_info.pWaitDstStageMask = wait_stage_mask;
+        submit_info.commandBufferCount = 1;
+        submit_info.pCommandBuffers = command_buffers[current_frame].get_ptr();
+        submit_info.signalSemaphoreCount = 0;
+        submit_info.pSignalSemaphores = nullptr;
+
+        in_flight_fences[current_frame].reset();
+
+        result = vkQueueSubmit(vkdevice->get_graphics_queue(), 1, &submit_info, in_flight_fences[current_frame].get());
+        vulkan_error_check(result);
+
+        submitted[current_frame] = true;
+        in_flight_frame_numbers[current_frame] = deletion_queue.end_frame();
+
+        cpu_frame_times.push_back(
+            std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - cpu_frame_start).count());
+
+        current_frame = (current_frame + 1) % MAX_FRAMES_IN_FLIGHT;
+
+        time_passed = stopwatch.get_time_step();
+    }
+
+    vkDeviceWaitIdle(vkdevice->get_device());
+
+    // Collect the timestamps of the last frames which are still in flight, in submission order.
+    for (std::size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+        const auto command_buffer_index = static_cast<std::uint32_t>((current_frame + i) % MAX_FRAMES_IN_FLIGHT);
+        if (submitted[command_buffer_index]) {
+            if (auto gpu_frame_time = get_gpu_frame_time(command_buffer_index)) {
+                gpu_frame_times.push_back(*gpu_frame_time);
+            }
+        }
+    }
+
+    spdlog::info("Drew {} octree chunks with {} on up to {} threads.", chunk_meshes->get_chunk_count(),
+                 get_chunk_draw_call_name(), recording_thread_count);
+
+    if (culling_stats_frame_count > 0) {
+        spdlog::info("Culled octree chunks on the device {} occlusion culling: avg {:.1f} drawn, {:.1f} culled per "
+                     "frame over {} frames.",
+                     chunk_culler->is_occlusion_culling_enabled() ? "with" : "without",
+                     static_cast<double>(drawn_chunk_count) / culling_stats_frame_count,
+                     static_cast<double>(culled_chunk_count) / culling_stats_frame_count, culling_stats_frame_count);
+    }
+
+    log_frame_times("Command buffer recording", recording_times);
+    log_frame_times("CPU", cpu_frame_times);
+    log_frame_times("GPU", gpu_frame_times);
+}
+
 void Application::cleanup() {
     spdlog::debug("Cleaning up Application.");
 
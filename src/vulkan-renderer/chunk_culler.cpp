@@ -0,0 +1,435 @@
+#include "inexor/vulkan-renderer/chunk_culler.hpp"
+
+#include "inexor/vulkan-renderer/frame_arena.hpp"
+#include "inexor/vulkan-renderer/frustum.hpp"
+#include "inexor/vulkan-renderer/standard_ubo.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <memory_resource>
+#include <stdexcept>
+
+namespace inexor::vulkan_renderer {
+
+namespace {
+
+/// The number of chunks one workgroup of the culling shader culls, which must match its local_size_x.
+constexpr std::uint32_t CULLING_GROUP_SIZE = 64;
+
+/// The width and the height of the workgroups of the depth pyramid shaders, which must match their local size.
+constexpr std::uint32_t DEPTH_PYRAMID_GROUP_SIZE = 8;
+
+/// The alignment of the chunk regions, which is the largest minStorageBufferOffsetAlignment the specification allows.
+constexpr VkDeviceSize CHUNK_REGION_ALIGNMENT = 256;
+
+static_assert(sizeof(ChunkCuller::ChunkCullData) == 64, "The chunk data must match the layout of the shader!");
+
+VkDeviceSize get_chunk_frame_size(const std::uint32_t max_chunk_count) {
+    const VkDeviceSize size = sizeof(ChunkCuller::ChunkCullData) * VkDeviceSize{max_chunk_count};
+    return (size + CHUNK_REGION_ALIGNMENT - 1) & ~(CHUNK_REGION_ALIGNMENT - 1);
+}
+
+VkDescriptorSetLayoutBinding make_compute_binding(const std::uint32_t binding, const VkDescriptorType type) {
+    VkDescriptorSetLayoutBinding layout_binding = {};
+    layout_binding.binding = binding;
+    layout_binding.descriptorType = type;
+    layout_binding.descriptorCount = 1;
+    layout_binding.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    layout_binding.pImmutableSamplers = nullptr;
+    return layout_binding;
+}
+
+VkWriteDescriptorSet make_descriptor_write(const VkDescriptorSet descriptor_set, const std::uint32_t binding,
+                                           const VkDescriptorType type) {
+    VkWriteDescriptorSet descriptor_write = {};
+    descriptor_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptor_write.dstSet = descriptor_set;
+    descriptor_write.dstBinding = binding;
+    descriptor_write.dstArrayElement = 0;
+    descriptor_write.descriptorType = type;
+    descriptor_write.descriptorCount = 1;
+    return descriptor_write;
+}
+
+} // namespace
+
+ChunkCuller::ChunkCuller(const VkDevice device, const VkPhysicalDevice graphics_card, const VmaAllocator vma_allocator,
+                         const VkPipelineCache pipeline_cache, wrapper::DescriptorLayoutCache &descriptor_layout_cache,
+                         const std::uint32_t max_chunk_count, const std::uint32_t frame_count,
+                         const bool compact_draws, const bool occlusion_culling_enabled,
+                         const VkExtent2D depth_extent, const VkSampleCountFlagBits depth_sample_count)
+    : device(device), graphics_card(graphics_card), vma_allocator(vma_allocator), max_chunk_count(max_chunk_count),
+      frame_count(frame_count), compact_draws(compact_draws), occlusion_culling_enabled(occlusion_culling_enabled),
+      depth_sample_count(depth_sample_count), chunk_frame_size(get_chunk_frame_size(max_chunk_count)),
+      chunk_buffer(device, vma_allocator, "chunk culling data", chunk_frame_size * frame_count,
+                   VK_BUFFER_USAGE_STORAGE_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU),
+      frame_chunk_counts(frame_count, 0), depth_extent(depth_extent) {
+    assert(device);
+    assert(graphics_card);
+    assert(vma_allocator);
+    assert(pipeline_cache);
+    assert(max_chunk_count > 0);
+    assert(frame_count > 0);
+
+    culling_descriptor_set_layout = descriptor_layout_cache.get({
+        make_compute_binding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER),
+        make_compute_binding(1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER),
+        make_compute_binding(2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER),
+        make_compute_binding(3, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER),
+    });
+
+    depth_pyramid_descriptor_set_layout = descriptor_layout_cache.get({
+        make_compute_binding(0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER),
+        make_compute_binding(1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE),
+    });
+
+    culling_pipeline_layout = std::make_unique<wrapper::PipelineLayout>(
+        device, std::vector<VkDescriptorSetLayout>{culling_descriptor_set_layout}, std::vector<VkPushConstantRange>{},
+        "Chunk culling pipeline layout");
+
+    culling_pipeline =
+        create_pipeline(pipeline_cache, culling_pipeline_layout->get(), CULLING_SHADER_FILE, "Chunk culling pipeline");
+
+    VkSamplerCreateInfo sampler_ci = {};
+    sampler_ci.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    sampler_ci.magFilter = VK_FILTER_NEAREST;
+    sampler_ci.minFilter = VK_FILTER_NEAREST;
+    sampler_ci.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    sampler_ci.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler_ci.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler_ci.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler_ci.minLod = 0.0f;
+    sampler_ci.maxLod = VK_LOD_CLAMP_NONE;
+    sampler_ci.maxAnisotropy = 1.0f;
+
+    if (vkCreateSampler(device, &sampler_ci, nullptr, &sampler) != VK_SUCCESS) {
+        throw std::runtime_error("Error: vkCreateSampler failed for the chunk culler!");
+    }
+
+    // The culling shader always binds a depth pyramid. Without occlusion culling, it is never built or read.
+    if (!occlusion_culling_enabled) {
+        depth_pyramid = std::make_unique<wrapper::DepthPyramid>(device, graphics_card, vma_allocator, VkExtent2D{1, 1},
+                                                                "Unused depth pyramid");
+
+        spdlog::debug("Created chunk culler for {} chunks with frustum culling.", max_chunk_count);
+        return;
+    }
+
+    std::vector<VkPushConstantRange> push_constant_ranges(1);
+    push_constant_ranges[0].stageFlags = VK_SHADER_STAGE_COMPUTE_BIT;
+    push_constant_ranges[0].offset = 0;
+    push_constant_ranges[0].size = sizeof(DepthPyramidPushConstants);
+
+    depth_pyramid_pipeline_layout = std::make_unique<wrapper::PipelineLayout>(
+        device, std::vector<VkDescriptorSetLayout>{depth_pyramid_descriptor_set_layout}, push_constant_ranges,
+        "Depth pyramid pipeline layout");
+
+    // A multisampled depth buffer is read by a shader which takes the maximum of all samples.
+    const bool multisampled = depth_sample_count != VK_SAMPLE_COUNT_1_BIT;
+
+    first_depth_pyramid_pipeline =
+        create_pipeline(pipeline_cache, depth_pyramid_pipeline_layout->get(),
+                        multisampled ? MULTISAMPLED_DEPTH_PYRAMID_SHADER_FILE : DEPTH_PYRAMID_SHADER_FILE,
+                        "First depth pyramid pipeline");
+
+    depth_pyramid_pipeline = create_pipeline(pipeline_cache, depth_pyramid_pipeline_layout->get(),
+                                             DEPTH_PYRAMID_SHADER_FILE, "Depth pyramid pipeline");
+
+    depth_pyramid =
+        std::make_unique<wrapper::DepthPyramid>(device, graphics_card, vma_allocator, depth_extent, "Depth pyramid");
+
+    spdlog::debug("Created chunk culler for {} chunks with frustum and occlusion culling.", max_chunk_count);
+}
+
+ChunkCuller::~ChunkCuller() {
+    vkDestroySampler(device, sampler, nullptr);
+}
+
+std::unique_ptr<wrapper::ComputePipeline> ChunkCuller::create_pipeline(const VkPipelineCache pipeline_cache,
+                                                                       const VkPipelineLayout pipeline_layout,
+                                                                       const char *file_name,
+                                                                       const std::string &name) const {
+    // The shader module is only needed until the pipeline has been created.
+    const wrapper::Shader shader(device, VK_SHADER_STAGE_COMPUTE_BIT, name + " shader", file_name);
+
+    VkPipelineShaderStageCreateInfo shader_stage_ci = {};
+    shader_stage_ci.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+    shader_stage_ci.stage = shader.get_type();
+    shader_stage_ci.module = shader.get_module();
+    shader_stage_ci.pName = shader.get_entry_point().c_str();
+
+    return std::make_unique<wrapper::ComputePipeline>(device, pipeline_cache, pipeline_layout, shader_stage_ci, name);
+}
+
+void ChunkCuller::record_depth_pyramid_barrier(const VkCommandBuffer command_buffer,
+                                               const VkPipelineStageFlags src_stage_mask,
+                                               const VkAccessFlags src_access_mask, const VkAccessFlags dst_access_mask,
+                                               const std::uint32_t base_mip_level, const std::uint32_t mip_count) {
+    VkImageMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = src_access_mask;
+    barrier.dstAccessMask = dst_access_mask;
+
+    // The content is undefined until the pyramid has been built, so the first barrier discards it.
+    barrier.oldLayout = depth_pyramid_initialized ? VK_IMAGE_LAYOUT_GENERAL : VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_GENERAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = depth_pyramid->get_image();
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseMipLevel = base_mip_level;
+    barrier.subresourceRange.levelCount = mip_count;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = 1;
+
+    vkCmdPipelineBarrier(command_buffer, src_stage_mask, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, 0, nullptr, 0,
+                         nullptr, 1, &barrier);
+
+    depth_pyramid_initialized = true;
+}
+
+void ChunkCuller::resize(const VkExtent2D depth_extent, DeletionQueue &deletion_queue) {
+    this->depth_extent = depth_extent;
+
+    if (!occlusion_culling_enabled) {
+        return;
+    }
+
+    deletion_queue.retire(std::move(depth_pyramid));
+
+    depth_pyramid =
+        std::make_unique<wrapper::DepthPyramid>(device, graphics_card, vma_allocator, depth_extent, "Depth pyramid");
+
+    depth_pyramid_initialized = false;
+    depth_pyramid_valid = false;
+}
+
+std::optional<ChunkCuller::Stats> ChunkCuller::read_stats(const std::uint32_t frame_index,
+                                                          const wrapper::IndirectDrawBuffer &draw_buffer) const {
+    assert(frame_index < frame_count);
+
+    const std::uint32_t chunk_count = frame_chunk_counts[frame_index];
+    if (chunk_count == 0) {
+        return std::nullopt;
+    }
+
+    Stats stats;
+    stats.drawn_count = std::min(draw_buffer.read_device_draw_count(), chunk_count);
+    stats.culled_count = chunk_count - stats.drawn_count;
+    return stats;
+}
+
+void ChunkCuller::record_culling(const VkCommandBuffer command_buffer, const std::uint32_t frame_index,
+                                 wrapper::DescriptorAllocator &descriptor_allocator,
+                                 wrapper::UniformRingBuffer &uniform_ring_buffer,
+                                 const wrapper::ChunkMeshBuffer &chunk_meshes, wrapper::IndirectDrawBuffer &draw_buffer,
+                                 const glm::mat4 &view_projection) {
+    assert(command_buffer);
+    assert(frame_index < frame_count);
+
+    const auto &draw_commands = chunk_meshes.get_draw_commands();
+    const auto &draw_bounds = chunk_meshes.get_draw_bounds();
+    const std::uint32_t chunk_count = chunk_meshes.get_chunk_count();
+
+    if (chunk_count > max_chunk_count) {
+        throw std::runtime_error("Error: The chunk culler can only cull " + std::to_string(max_chunk_count) +
+                                 " chunks per frame, but there are " + std::to_string(chunk_count) + " chunks!");
+    }
+
+    // The chunks are copied into the region of this frame in flight, which the device does not read anymore.
+    const VkDeviceSize chunk_frame_begin = chunk_frame_size * frame_index;
+    auto *chunk_data = reinterpret_cast<ChunkCullData *>(
+        static_cast<std::byte *>(chunk_buffer.get_allocation_info().pMappedData) + chunk_frame_begin);
+
+    for (std::uint32_t chunk = 0; chunk < chunk_count; chunk++) {
+        chunk_data[chunk].bounds_min = glm::vec4(draw_bounds[chunk].min, 0.0f);
+        chunk_data[chunk].bounds_max = glm::vec4(draw_bounds[chunk].max, 0.0f);
+        chunk_data[chunk].command = draw_commands[chunk];
+    }
+
+    // This does nothing if the memory is host coherent.
+    vmaFlushAllocation(vma_allocator, chunk_buffer.get_allocation(), chunk_frame_begin,
+                       sizeof(ChunkCullData) * VkDeviceSize{chunk_count});
+
+    draw_buffer.begin_device_write(chunk_count);
+    draw_buffer.flush();
+    frame_chunk_counts[frame_index] = chunk_count;
+
+    CullingUniformBufferObject culling_ubo = {};
+    culling_ubo.frustum_planes = Frustum(view_projection).planes;
+    culling_ubo.occlusion_view_projection = depth_pyramid_view_projection;
+    culling_ubo.chunk_count = chunk_count;
+    culling_ubo.compact_draws = compact_draws ? 1 : 0;
+
+    // The depth pyramid of the previous frame can only be used if it has been built for the current size.
+    if (occlusion_culling_enabled && depth_pyramid_valid) {
+        const VkExtent2D depth_pyramid_extent = depth_pyramid->get_extent();
+        culling_ubo.depth_pyramid_size = {depth_pyramid_extent.width, depth_pyramid_extent.height};
+        culling_ubo.depth_pyramid_mip_count = depth_pyramid->get_mip_count();
+        culling_ubo.occlusion_culling_enabled = 1;
+    }
+
+    const std::uint32_t culling_ubo_offset = uniform_ring_buffer.allocate(culling_ubo);
+    current_view_projection = view_projection;
+
+    if (!depth_pyramid_initialized) {
+        record_depth_pyramid_barrier(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, 0, VK_ACCESS_SHADER_READ_BIT,
+                                     0, depth_pyramid->get_mip_count());
+    }
+
+    const VkDescriptorSet descriptor_set = descriptor_allocator.allocate(culling_descriptor_set_layout);
+
+    VkDescriptorBufferInfo uniform_buffer_info = {};
+    uniform_buffer_info.buffer = uniform_ring_buffer.get_buffer();
+    uniform_buffer_info.offset = culling_ubo_offset;
+    uniform_buffer_info.range = sizeof(CullingUniformBufferObject);
+
+    VkDescriptorBufferInfo chunk_buffer_info = {};
+    chunk_buffer_info.buffer = chunk_buffer.get_buffer();
+    chunk_buffer_info.offset = chunk_frame_begin;
+    chunk_buffer_info.range = chunk_frame_size;
+
+    VkDescriptorBufferInfo draw_buffer_info = {};
+    draw_buffer_info.buffer = draw_buffer.get_buffer();
+    draw_buffer_info.offset = draw_buffer.get_count_offset();
+    draw_buffer_info.range = draw_buffer.get_region_size();
+
+    VkDescriptorImageInfo depth_pyramid_info = {};
+    depth_pyramid_info.sampler = sampler;
+    depth_pyramid_info.imageView = depth_pyramid->get_image_view();
+    depth_pyramid_info.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+    std::array<VkWriteDescriptorSet, 4> descriptor_writes = {
+        make_descriptor_write(descriptor_set, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER),
+        make_descriptor_write(descriptor_set, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER),
+        make_descriptor_write(descriptor_set, 2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER),
+        make_descriptor_write(descriptor_set, 3, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER),
+    };
+    descriptor_writes[0].pBufferInfo = &uniform_buffer_info;
+    descriptor_writes[1].pBufferInfo = &chunk_buffer_info;
+    descriptor_writes[2].pBufferInfo = &draw_buffer_info;
+    descriptor_writes[3].pImageInfo = &depth_pyramid_info;
+
+    vkUpdateDescriptorSets(device, static_cast<std::uint32_t>(descriptor_writes.size()), descriptor_writes.data(), 0,
+                           nullptr);
+
+    if (chunk_count > 0) {
+        vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, culling_pipeline->get());
+        vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, culling_pipeline_layout->get(), 0, 1,
+                                &descriptor_set, 0, nullptr);
+        vkCmdDispatch(command_buffer, (chunk_count + CULLING_GROUP_SIZE - 1) / CULLING_GROUP_SIZE, 1, 1);
+    }
+
+    // The draw commands are read by the indirect draw calls, and the draw count by read_stats().
+    VkBufferMemoryBarrier draw_buffer_barrier = {};
+    draw_buffer_barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    draw_buffer_barrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+    draw_buffer_barrier.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_HOST_READ_BIT;
+    draw_buffer_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    draw_buffer_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    draw_buffer_barrier.buffer = draw_buffer.get_buffer();
+    draw_buffer_barrier.offset = draw_buffer.get_count_offset();
+    draw_buffer_barrier.size = draw_buffer.get_region_size();
+
+    vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                         VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_HOST_BIT, 0, 0, nullptr, 1,
+                         &draw_buffer_barrier, 0, nullptr);
+}
+
+void ChunkCuller::record_depth_pyramid(const VkCommandBuffer command_buffer,
+                                       wrapper::DescriptorAllocator &descriptor_allocator,
+                                       const VkImageView depth_buffer_view) {
+    assert(command_buffer);
+    assert(depth_buffer_view);
+
+    if (!occlusion_culling_enabled) {
+        return;
+    }
+
+    const std::uint32_t mip_count = depth_pyramid->get_mip_count();
+
+    // The culling shader of this frame has read the pyramid of the previous frame.
+    record_depth_pyramid_barrier(command_buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, 0, VK_ACCESS_SHADER_WRITE_BIT,
+                                 0, mip_count);
+
+    // The descriptor sets of all mip levels are written with one call. The arrays only live for this frame.
+    std::pmr::vector<VkDescriptorSet> descriptor_sets(mip_count, &FrameArena::get());
+    std::pmr::vector<VkDescriptorImageInfo> image_infos(2 * mip_count, &FrameArena::get());
+    std::pmr::vector<VkWriteDescriptorSet> descriptor_writes(&FrameArena::get());
+    descriptor_writes.reserve(2 * mip_count);
+
+    for (std::uint32_t mip_level = 0; mip_level < mip_count; mip_level++) {
+        const bool is_first_mip = mip_level == 0;
+
+        descriptor_sets[mip_level] = descriptor_allocator.allocate(depth_pyramid_descriptor_set_layout);
+
+        VkDescriptorImageInfo &source_info = image_infos[2 * mip_level];
+        source_info.sampler = sampler;
+        source_info.imageView = is_first_mip ? depth_buffer_view : depth_pyramid->get_mip_view(mip_level - 1);
+        source_info.imageLayout = is_first_mip ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_GENERAL;
+
+        VkDescriptorImageInfo &destination_info = image_infos[2 * mip_level + 1];
+        destination_info.imageView = depth_pyramid->get_mip_view(mip_level);
+        destination_info.imageLayout = VK_IMAGE_LAYOUT_GENERAL;
+
+        descriptor_writes.push_back(
+            make_descriptor_write(descriptor_sets[mip_level], 0, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER));
+        descriptor_writes.back().pImageInfo = &source_info;
+
+        descriptor_writes.push_back(
+            make_descriptor_write(descriptor_sets[mip_level], 1, VK_DESCRIPTOR_TYPE_STORAGE_IMAGE));
+        descriptor_writes.back().pImageInfo = &destination_info;
+    }
+
+    vkUpdateDescriptorSets(device, static_cast<std::uint32_t>(descriptor_writes.size()), descriptor_writes.data(), 0,
+                           nullptr);
+
+    for (std::uint32_t mip_level = 0; mip_level < mip_count; mip_level++) {
+        const bool is_first_mip = mip_level == 0;
+
+        if (is_first_mip) {
+            vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, first_depth_pyramid_pipeline->get());
+        } else {
+            // The mip level below has to be written completely before it is read.
+            record_depth_pyramid_barrier(command_buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                                         VK_ACCESS_SHADER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT, mip_level - 1, 1);
+
+            if (mip_level == 1) {
+                vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, depth_pyramid_pipeline->get());
+            }
+        }
+
+        vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_COMPUTE, depth_pyramid_pipeline_layout->get(),
+                                0, 1, &descriptor_sets[mip_level], 0, nullptr);
+
+        const VkExtent2D source_extent = is_first_mip ? depth_extent : depth_pyramid->get_mip_extent(mip_level - 1);
+        const VkExtent2D destination_extent = depth_pyramid->get_mip_extent(mip_level);
+
+        DepthPyramidPushConstants push_constants = {};
+        push_constants.source_size = {source_extent.width, source_extent.height};
+        push_constants.destination_size = {destination_extent.width, destination_extent.height};
+
+        vkCmdPushConstants(command_buffer, depth_pyramid_pipeline_layout->get(), VK_SHADER_STAGE_COMPUTE_BIT, 0,
+                           sizeof(push_constants), &push_constants);
+
+        const std::uint32_t group_count_x =
+            (destination_extent.width + DEPTH_PYRAMID_GROUP_SIZE - 1) / DEPTH_PYRAMID_GROUP_SIZE;
+        const std::uint32_t group_count_y =
+            (destination_extent.height + DEPTH_PYRAMID_GROUP_SIZE - 1) / DEPTH_PYRAMID_GROUP_SIZE;
+
+        vkCmdDispatch(command_buffer, group_count_x, group_count_y, 1);
+    }
+
+    // The culling shader of the next frame reads all mip levels.
+    record_depth_pyramid_barrier(command_buffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_WRITE_BIT,
+                                 VK_ACCESS_SHADER_READ_BIT, 0, mip_count);
+
+    depth_pyramid_view_projection = current_view_projection;
+    depth_pyramid_valid = true;
+}
+
+} // namespace inexor::vulkan_renderer
@@ -0,0 +1,45 @@
+#include "inexor/vulkan-renderer/deletion_queue.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <cassert>
+
+namespace inexor::vulkan_renderer {
+
+DeletionQueue::~DeletionQueue() {
+    flush();
+}
+
+void DeletionQueue::push(std::function<void()> deleter) {
+    assert(deleter);
+    entries.push_back({current_frame, std::move(deleter)});
+}
+
+std::uint64_t DeletionQueue::end_frame() {
+    return current_frame++;
+}
+
+void DeletionQueue::release(const std::uint64_t finished_frame) {
+    assert(finished_frame < current_frame);
+
+    // The entries are ordered by their frame, and objects are destroyed in the order in which they were pushed.
+    while (!entries.empty() && entries.front().frame <= finished_frame) {
+        auto deleter = std::move(entries.front().deleter);
+        entries.pop_front();
+        deleter();
+    }
+}
+
+void DeletionQueue::flush() {
+    if (!entries.empty()) {
+        spdlog::trace("Destroying {} objects in deletion queue.", entries.size());
+    }
+
+    while (!entries.empty()) {
+        auto deleter = std::move(entries.front().deleter);
+        entries.pop_front();
+        deleter();
+    }
+}
+
+} // namespace inexor::vulkan_renderer
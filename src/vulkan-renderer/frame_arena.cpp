@@ -0,0 +1,111 @@
+#include "inexor/vulkan-renderer/frame_arena.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cassert>
+#include <new>
+
+namespace inexor::vulkan_renderer {
+
+std::atomic<std::uint64_t> FrameArena::global_frame_index = 0;
+std::atomic<std::size_t> FrameArena::frame_allocation_count = 0;
+std::atomic<std::size_t> FrameArena::frame_allocated_bytes = 0;
+std::atomic<std::size_t> FrameArena::last_frame_allocation_count = 0;
+std::atomic<std::size_t> FrameArena::last_frame_allocated_bytes = 0;
+
+FrameArena::FrameArena(const std::size_t block_size) {
+    assert(block_size > 0);
+    add_block(block_size);
+}
+
+void FrameArena::add_block(const std::size_t minimum_size) {
+    // Grow geometrically so a frame which needs a lot of memory only adds a few blocks.
+    const std::size_t block_size = std::max(minimum_size, blocks.empty() ? minimum_size : 2 * blocks.back().size);
+
+    spdlog::trace("Adding frame arena block of {} bytes.", block_size);
+
+    blocks.push_back({std::make_unique<std::byte[]>(block_size), block_size});
+}
+
+void *FrameArena::do_allocate(const std::size_t bytes, const std::size_t alignment) {
+    assert(!blocks.empty());
+
+    frame_allocation_count.fetch_add(1, std::memory_order_relaxed);
+    frame_allocated_bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+    while (true) {
+        Block &block = blocks[current_block];
+
+        void *pointer = block.data.get() + current_offset;
+        std::size_t space = block.size - current_offset;
+
+        if (std::align(alignment, bytes, pointer, space) != nullptr) {
+            current_offset = block.size - space + bytes;
+            used_bytes += bytes;
+            return pointer;
+        }
+
+        // The allocation does not fit into the current block, so continue with the next one.
+        current_block++;
+        current_offset = 0;
+
+        if (current_block == blocks.size()) {
+            add_block(bytes + alignment);
+        }
+    }
+}
+
+void FrameArena::reset() {
+    const std::size_t capacity = get_capacity();
+
+    // Memory which only an oversized frame needed is not kept for the lifetime of the thread.
+    const std::size_t retained_capacity =
+        capacity > MAX_RETAINED_CAPACITY && used_bytes <= MAX_RETAINED_CAPACITY ? MAX_RETAINED_CAPACITY : capacity;
+
+    if (blocks.size() > 1 || retained_capacity < capacity) {
+        spdlog::trace("Resizing frame arena from {} to {} bytes.", capacity, retained_capacity);
+        blocks.clear();
+        add_block(retained_capacity);
+    }
+
+    current_block = 0;
+    current_offset = 0;
+    used_bytes = 0;
+}
+
+std::size_t FrameArena::get_capacity() const {
+    std::size_t capacity = 0;
+    for (const auto &block : blocks) {
+        capacity += block.size;
+    }
+    return capacity;
+}
+
+FrameArena &FrameArena::get() {
+    thread_local FrameArena arena;
+
+    const std::uint64_t current_frame_index = global_frame_index.load(std::memory_order_acquire);
+    if (arena.frame_index != current_frame_index) {
+        arena.reset();
+        arena.frame_index = current_frame_index;
+    }
+
+    return arena;
+}
+
+void FrameArena::begin_frame() {
+    last_frame_allocation_count.store(frame_allocation_count.exchange(0, std::memory_order_relaxed),
+                                      std::memory_order_relaxed);
+    last_frame_allocated_bytes.store(frame_allocated_bytes.exchange(0, std::memory_order_relaxed),
+                                     std::memory_order_relaxed);
+
+    global_frame_index.fetch_add(1, std::memory_order_release);
+}
+
+FrameArenaStats FrameArena::get_last_frame_stats() {
+    return {last_frame_allocation_count.load(std::memory_order_relaxed),
+            last_frame_allocated_bytes.load(std::memory_order_relaxed)};
+}
+
+} // namespace inexor::vulkan_renderer
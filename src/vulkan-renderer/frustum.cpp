@@ -0,0 +1,130 @@
+#include "inexor/vulkan-renderer/frustum.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define INEXOR_FRUSTUM_USE_SSE2
+#include <emmintrin.h>
+#endif
+
+#include <cstddef>
+
+namespace inexor::vulkan_renderer {
+
+namespace {
+
+/// @brief Returns the signed distance of a point to a plane.
+/// The terms are summed in the same order as in the SSE2 path of test_box(), so both round in the same way.
+float get_signed_distance(const glm::vec4 &plane, const glm::vec3 &point) {
+    return (plane.x * point.x + plane.y * point.y) + (plane.z * point.z + plane.w);
+}
+
+} // namespace
+
+Frustum::Frustum(const glm::mat4 &view_projection) {
+    // GLM matrices are column major, so the rows have to be gathered from the columns.
+    std::array<glm::vec4, 4> rows;
+    for (int row = 0; row < 4; row++) {
+        rows[row] = {view_projection[0][row], view_projection[1][row], view_projection[2][row],
+                     view_projection[3][row]};
+    }
+
+    planes[0] = rows[3] + rows[0];
+    planes[1] = rows[3] - rows[0];
+    planes[2] = rows[3] + rows[1];
+    planes[3] = rows[3] - rows[1];
+    planes[4] = rows[2];
+    planes[5] = rows[3] - rows[2];
+
+    for (auto &plane : planes) {
+        plane /= glm::length(glm::vec3(plane));
+    }
+
+    for (std::size_t i = 0; i < planes.size(); i++) {
+        normals_x[i] = planes[i].x;
+        normals_y[i] = planes[i].y;
+        normals_z[i] = planes[i].z;
+        distances[i] = planes[i].w;
+    }
+
+    // The padding planes have no normal, so every point has a positive distance to them.
+    for (std::size_t i = planes.size(); i < distances.size(); i++) {
+        distances[i] = 1.0f;
+    }
+}
+
+Frustum::Visibility Frustum::test_box(const glm::vec3 &min, const glm::vec3 &max) const {
+#ifdef INEXOR_FRUSTUM_USE_SSE2
+    // This is the same test as in test_box_scalar(), but for four planes at once.
+    bool intersecting = false;
+
+    const __m128 min_x = _mm_set1_ps(min.x);
+    const __m128 min_y = _mm_set1_ps(min.y);
+    const __m128 min_z = _mm_set1_ps(min.z);
+    const __m128 max_x = _mm_set1_ps(max.x);
+    const __m128 max_y = _mm_set1_ps(max.y);
+    const __m128 max_z = _mm_set1_ps(max.z);
+    const __m128 zero = _mm_setzero_ps();
+
+    for (std::size_t i = 0; i < distances.size(); i += 4) {
+        const __m128 normal_x = _mm_load_ps(&normals_x[i]);
+        const __m128 normal_y = _mm_load_ps(&normals_y[i]);
+        const __m128 normal_z = _mm_load_ps(&normals_z[i]);
+        const __m128 distance = _mm_load_ps(&distances[i]);
+
+        const __m128 positive_x = _mm_cmpge_ps(normal_x, zero);
+        const __m128 positive_y = _mm_cmpge_ps(normal_y, zero);
+        const __m128 positive_z = _mm_cmpge_ps(normal_z, zero);
+
+        // Select the corners without branches, as SSE2 has no blend instruction.
+        const auto select = [](const __m128 mask, const __m128 a, const __m128 b) {
+            return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+        };
+
+        const __m128 positive_distance = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(normal_x, select(positive_x, max_x, min_x)),
+                       _mm_mul_ps(normal_y, select(positive_y, max_y, min_y))),
+            _mm_add_ps(_mm_mul_ps(normal_z, select(positive_z, max_z, min_z)), distance));
+
+        if (_mm_movemask_ps(_mm_cmplt_ps(positive_distance, zero)) != 0) {
+            return Visibility::OUTSIDE;
+        }
+
+        const __m128 negative_distance = _mm_add_ps(
+            _mm_add_ps(_mm_mul_ps(normal_x, select(positive_x, min_x, max_x)),
+                       _mm_mul_ps(normal_y, select(positive_y, min_y, max_y))),
+            _mm_add_ps(_mm_mul_ps(normal_z, select(positive_z, min_z, max_z)), distance));
+
+        if (_mm_movemask_ps(_mm_cmplt_ps(negative_distance, zero)) != 0) {
+            intersecting = true;
+        }
+    }
+
+    return intersecting ? Visibility::INTERSECTING : Visibility::INSIDE;
+#else
+    return test_box_scalar(min, max);
+#endif
+}
+
+Frustum::Visibility Frustum::test_box_scalar(const glm::vec3 &min, const glm::vec3 &max) const {
+    // For every plane, the corner furthest along the normal (the positive vertex) decides whether the box is outside,
+    // and the opposite corner (the negative vertex) decides whether it is inside.
+    bool intersecting = false;
+
+    for (const auto &plane : planes) {
+        const glm::vec3 normal(plane);
+        const glm::vec3 positive_vertex{normal.x >= 0.0f ? max.x : min.x, normal.y >= 0.0f ? max.y : min.y,
+                                        normal.z >= 0.0f ? max.z : min.z};
+        const glm::vec3 negative_vertex{normal.x >= 0.0f ? min.x : max.x, normal.y >= 0.0f ? min.y : max.y,
+                                        normal.z >= 0.0f ? min.z : max.z};
+
+        if (get_signed_distance(plane, positive_vertex) < 0.0f) {
+            return Visibility::OUTSIDE;
+        }
+        if (get_signed_distance(plane, negative_vertex) < 0.0f) {
+            intersecting = true;
+        }
+    }
+
+    return intersecting ? Visibility::INTERSECTING : Visibility::INSIDE;
+}
+
+} // namespace inexor::vulkan_renderer
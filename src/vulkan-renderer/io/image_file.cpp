@@ -0,0 +1,62 @@
+#include "inexor/vulkan-renderer/io/image_file.hpp"
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <spdlog/spdlog.h>
+#include <stb_image.h>
+
+#include <cassert>
+#include <stdexcept>
+
+namespace inexor::vulkan_renderer::io {
+
+void ImageFile::StbImageDeleter::operator()(std::uint8_t *texel_data) const {
+    stbi_image_free(texel_data);
+}
+
+ImageFile::ImageFile(const std::filesystem::path &file_name) : file_name(file_name.string()) {
+    spdlog::debug("Loading texture file {}.", this->file_name);
+
+    int image_width = 0;
+    int image_height = 0;
+    int image_channels = 0;
+
+    // Force stb_image to load an alpha channel as well.
+    stbi_uc *data = stbi_load(this->file_name.c_str(), &image_width, &image_height, &image_channels, STBI_rgb_alpha);
+
+    if (data == nullptr) {
+        throw std::runtime_error("Error: Could not load texture file " + this->file_name + " using stbi_load!");
+    }
+
+    set_texel_data(data, image_width, image_height, image_channels);
+}
+
+ImageFile::ImageFile(const std::uint8_t *file_data, const std::size_t file_size, const std::string &file_name)
+    : file_name(file_name) {
+    assert(file_data);
+
+    int image_width = 0;
+    int image_height = 0;
+    int image_channels = 0;
+
+    stbi_uc *data = stbi_load_from_memory(file_data, static_cast<int>(file_size), &image_width, &image_height,
+                                          &image_channels, STBI_rgb_alpha);
+
+    if (data == nullptr) {
+        throw std::runtime_error("Error: Could not decode texture file " + file_name +
+                                 " using stbi_load_from_memory!");
+    }
+
+    set_texel_data(data, image_width, image_height, image_channels);
+}
+
+void ImageFile::set_texel_data(std::uint8_t *data, const int image_width, const int image_height,
+                               const int image_channels) {
+    texel_data.reset(data);
+    width = static_cast<std::uint32_t>(image_width);
+    height = static_cast<std::uint32_t>(image_height);
+    channels = static_cast<std::uint32_t>(image_channels);
+
+    spdlog::debug("Texture dimensions: width: {}, height: {}, channels: {}.", width, height, channels);
+}
+
+} // namespace inexor::vulkan_renderer::io
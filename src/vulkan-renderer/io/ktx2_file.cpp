@@ -0,0 +1,278 @@
+#include "inexor/vulkan-renderer/io/ktx2_file.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace inexor::vulkan_renderer::io {
+
+namespace {
+
+constexpr std::array<std::uint8_t, 12> KTX2_IDENTIFIER = {0xAB, 0x4B, 0x54, 0x58, 0x20, 0x32,
+                                                          0x30, 0xBB, 0x0D, 0x0A, 0x1A, 0x0A};
+
+/// @brief The header at the beginning of every KTX 2.0 file, including the index.
+struct Ktx2Header {
+    std::uint8_t identifier[12];
+    std::uint32_t vk_format;
+    std::uint32_t type_size;
+    std::uint32_t pixel_width;
+    std::uint32_t pixel_height;
+    std::uint32_t pixel_depth;
+    std::uint32_t layer_count;
+    std::uint32_t face_count;
+    std::uint32_t level_count;
+    std::uint32_t supercompression_scheme;
+    std::uint32_t dfd_byte_offset;
+    std::uint32_t dfd_byte_length;
+    std::uint32_t kvd_byte_offset;
+    std::uint32_t kvd_byte_length;
+    std::uint64_t sgd_byte_offset;
+    std::uint64_t sgd_byte_length;
+};
+
+/// @brief An entry of the level index, which follows the header.
+struct Ktx2LevelIndexEntry {
+    std::uint64_t byte_offset;
+    std::uint64_t byte_length;
+    std::uint64_t uncompressed_byte_length;
+};
+
+// The structures are copied from and to the file with memcpy, so they must not contain any padding.
+static_assert(sizeof(Ktx2Header) == 80);
+static_assert(sizeof(Ktx2LevelIndexEntry) == 24);
+
+/// @brief Returns the width and height of the blocks of a format, which is 1 for uncompressed formats.
+std::uint32_t get_block_extent(const VkFormat format) {
+    return format == VK_FORMAT_R8G8B8A8_UNORM ? 1 : 4;
+}
+
+/// @brief Returns the size of a mip level of a format in bytes.
+VkDeviceSize get_level_size(const VkFormat format, const std::uint32_t width, const std::uint32_t height,
+                            const std::uint32_t level) {
+    const std::uint32_t block_extent = get_block_extent(format);
+    const VkDeviceSize blocks_x = (std::max(width >> level, 1u) + block_extent - 1) / block_extent;
+    const VkDeviceSize blocks_y = (std::max(height >> level, 1u) + block_extent - 1) / block_extent;
+    return blocks_x * blocks_y * get_ktx2_block_size(format);
+}
+
+/// @brief Creates the data format descriptor of a format, which KTX 2.0 requires to describe the texel data.
+/// See the Khronos Data Format Specification for the meaning of the fields.
+std::vector<std::uint8_t> make_data_format_descriptor(const VkFormat format) {
+    struct Sample {
+        std::uint16_t bit_offset;
+        std::uint8_t bit_length;
+        std::uint8_t channel_type;
+        std::uint32_t upper;
+    };
+
+    std::uint8_t color_model = 0;
+    std::vector<Sample> samples;
+
+    switch (format) {
+    case VK_FORMAT_R8G8B8A8_UNORM:
+        color_model = 1; // KHR_DF_MODEL_RGBSDA
+        samples = {{0, 7, 0, 255}, {8, 7, 1, 255}, {16, 7, 2, 255}, {24, 7, 15, 255}};
+        break;
+    case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+        color_model = 128; // KHR_DF_MODEL_BC1A
+        samples = {{0, 63, 0, 0xFFFFFFFF}};
+        break;
+    case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+        color_model = 128; // KHR_DF_MODEL_BC1A with KHR_DF_CHANNEL_BC1A_ALPHAPRESENT
+        samples = {{0, 63, 1, 0xFFFFFFFF}};
+        break;
+    case VK_FORMAT_BC3_UNORM_BLOCK:
+        color_model = 130; // KHR_DF_MODEL_BC3 with KHR_DF_CHANNEL_BC3_ALPHA and KHR_DF_CHANNEL_BC3_COLOR
+        samples = {{0, 63, 15, 0xFFFFFFFF}, {64, 63, 0, 0xFFFFFFFF}};
+        break;
+    case VK_FORMAT_BC7_UNORM_BLOCK:
+        color_model = 136; // KHR_DF_MODEL_BPTC
+        samples = {{0, 127, 0, 0xFFFFFFFF}};
+        break;
+    default:
+        assert(false);
+    }
+
+    const auto block_size = static_cast<std::uint32_t>(24 + 16 * samples.size());
+    const std::uint8_t block_dimension = format == VK_FORMAT_R8G8B8A8_UNORM ? 0 : 3;
+
+    std::vector<std::uint8_t> descriptor(4 + block_size);
+    std::uint8_t *data = descriptor.data();
+
+    const std::uint32_t total_size = 4 + block_size;
+    const std::uint32_t version_and_size = 2 | (block_size << 16);
+    std::memcpy(data, &total_size, 4);
+    std::memcpy(data + 8, &version_and_size, 4);
+
+    data[12] = color_model;
+    data[13] = 1; // KHR_DF_PRIMARIES_BT709
+    data[14] = 1; // KHR_DF_TRANSFER_LINEAR
+    data[15] = 0; // KHR_DF_FLAG_ALPHA_STRAIGHT
+    data[16] = block_dimension;
+    data[17] = block_dimension;
+    data[20] = static_cast<std::uint8_t>(get_ktx2_block_size(format));
+
+    for (std::size_t i = 0; i < samples.size(); i++) {
+        std::uint8_t *sample = data + 28 + 16 * i;
+        std::memcpy(sample, &samples[i].bit_offset, 2);
+        sample[2] = samples[i].bit_length;
+        sample[3] = samples[i].channel_type;
+        std::memcpy(sample + 12, &samples[i].upper, 4);
+    }
+
+    return descriptor;
+}
+
+} // namespace
+
+std::uint32_t get_ktx2_block_size(const VkFormat format) {
+    switch (format) {
+    case VK_FORMAT_R8G8B8A8_UNORM:
+        return 4;
+    case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
+    case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
+        return 8;
+    case VK_FORMAT_BC3_UNORM_BLOCK:
+    case VK_FORMAT_BC7_UNORM_BLOCK:
+        return 16;
+    default:
+        return 0;
+    }
+}
+
+Ktx2File::Ktx2File(const std::filesystem::path &file_name) : file(file_name) {
+    const std::uint8_t *file_data = file.get_data();
+    const std::size_t file_size = file.get_size();
+
+    if (file_size < sizeof(Ktx2Header)) {
+        throw std::runtime_error("Error: " + get_file_name() + " is not a KTX 2.0 file!");
+    }
+
+    Ktx2Header header;
+    std::memcpy(&header, file_data, sizeof(header));
+
+    if (std::memcmp(header.identifier, KTX2_IDENTIFIER.data(), KTX2_IDENTIFIER.size()) != 0) {
+        throw std::runtime_error("Error: " + get_file_name() + " is not a KTX 2.0 file!");
+    }
+
+    format = static_cast<VkFormat>(header.vk_format);
+    width = header.pixel_width;
+    height = header.pixel_height;
+
+    if (get_ktx2_block_size(format) == 0) {
+        throw std::runtime_error("Error: KTX 2.0 file " + get_file_name() + " has unsupported format " +
+                                 std::to_string(header.vk_format) + "!");
+    }
+
+    if (header.supercompression_scheme != 0) {
+        throw std::runtime_error("Error: KTX 2.0 file " + get_file_name() + " is supercompressed!");
+    }
+
+    if (width == 0 || height == 0 || header.pixel_depth != 0 || header.layer_count > 1 || header.face_count != 1) {
+        throw std::runtime_error("Error: KTX 2.0 file " + get_file_name() + " does not contain a 2D texture!");
+    }
+
+    // A level count of 0 requests the generation of mip levels at load time, which is not possible for block
+    // compressed formats. The texture is used with its first level only then.
+    const std::uint32_t level_count = std::max(header.level_count, 1u);
+
+    if (level_count > 32 || (std::max(width, height) >> (level_count - 1)) == 0) {
+        throw std::runtime_error("Error: KTX 2.0 file " + get_file_name() + " has too many mip levels!");
+    }
+
+    const std::size_t level_index_end = sizeof(Ktx2Header) + level_count * sizeof(Ktx2LevelIndexEntry);
+
+    if (file_size < level_index_end) {
+        throw std::runtime_error("Error: KTX 2.0 file " + get_file_name() + " is truncated!");
+    }
+
+    level_offsets.resize(level_count);
+
+    for (std::uint32_t level = 0; level < level_count; level++) {
+        Ktx2LevelIndexEntry entry;
+        std::memcpy(&entry, file_data + sizeof(Ktx2Header) + level * sizeof(entry), sizeof(entry));
+
+        if (entry.byte_length != get_level_size(format, width, height, level)) {
+            throw std::runtime_error("Error: Mip level " + std::to_string(level) + " of KTX 2.0 file " +
+                                     get_file_name() + " has an invalid size!");
+        }
+
+        if (entry.byte_offset < level_index_end || entry.byte_offset > file_size ||
+            entry.byte_length > file_size - entry.byte_offset) {
+            throw std::runtime_error("Error: Mip level " + std::to_string(level) + " of KTX 2.0 file " +
+                                     get_file_name() + " is out of bounds!");
+        }
+
+        if (entry.byte_offset % get_ktx2_block_size(format) != 0) {
+            throw std::runtime_error("Error: Mip level " + std::to_string(level) + " of KTX 2.0 file " +
+                                     get_file_name() + " is not aligned!");
+        }
+
+        level_offsets[level] = entry.byte_offset;
+        data_size = std::max(data_size, entry.byte_offset + entry.byte_length);
+    }
+
+    spdlog::debug("Loaded KTX 2.0 file {} with format {}, {}x{} texels and {} mip levels.", get_file_name(),
+                  header.vk_format, width, height, level_count);
+}
+
+void write_ktx2_file(const std::filesystem::path &file_name, const VkFormat format, const std::uint32_t width,
+                     const std::uint32_t height, const std::vector<std::vector<std::uint8_t>> &levels) {
+    assert(get_ktx2_block_size(format) > 0);
+    assert(width > 0);
+    assert(height > 0);
+    assert(!levels.empty());
+
+    const auto level_count = static_cast<std::uint32_t>(levels.size());
+    const std::vector<std::uint8_t> descriptor = make_data_format_descriptor(format);
+
+    Ktx2Header header = {};
+    std::memcpy(header.identifier, KTX2_IDENTIFIER.data(), KTX2_IDENTIFIER.size());
+    header.vk_format = static_cast<std::uint32_t>(format);
+    header.type_size = 1;
+    header.pixel_width = width;
+    header.pixel_height = height;
+    header.face_count = 1;
+    header.level_count = level_count;
+    header.dfd_byte_offset = static_cast<std::uint32_t>(sizeof(Ktx2Header) + level_count * sizeof(Ktx2LevelIndexEntry));
+    header.dfd_byte_length = static_cast<std::uint32_t>(descriptor.size());
+
+    // The mip levels are stored from the smallest to the largest one, each aligned to the block size. The block sizes
+    // of all supported formats are multiples of 4, as required by the specification.
+    const std::uint32_t alignment = get_ktx2_block_size(format);
+
+    std::vector<Ktx2LevelIndexEntry> level_index(level_count);
+    std::uint64_t offset = header.dfd_byte_offset + header.dfd_byte_length;
+
+    for (std::uint32_t level = level_count; level-- > 0;) {
+        assert(levels[level].size() == get_level_size(format, width, height, level));
+
+        offset = (offset + alignment - 1) / alignment * alignment;
+        level_index[level] = {offset, levels[level].size(), levels[level].size()};
+        offset += levels[level].size();
+    }
+
+    std::vector<std::uint8_t> file_data(offset);
+    std::memcpy(file_data.data(), &header, sizeof(header));
+    std::memcpy(file_data.data() + sizeof(header), level_index.data(), level_count * sizeof(Ktx2LevelIndexEntry));
+    std::memcpy(file_data.data() + header.dfd_byte_offset, descriptor.data(), descriptor.size());
+
+    for (std::uint32_t level = 0; level < level_count; level++) {
+        std::memcpy(file_data.data() + level_index[level].byte_offset, levels[level].data(), levels[level].size());
+    }
+
+    std::ofstream file(file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char *>(file_data.data()), static_cast<std::streamsize>(file_data.size()));
+
+    if (!file) {
+        throw std::runtime_error("Error: Could not write KTX 2.0 file " + file_name.string() + "!");
+    }
+}
+
+} // namespace inexor::vulkan_renderer::io
@@ -0,0 +1,92 @@
+#include "inexor/vulkan-renderer/io/mapped_file.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <stdexcept>
+#include <utility>
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace inexor::vulkan_renderer::io {
+
+MappedFile::MappedFile(MappedFile &&other) noexcept
+    : file_name(std::move(other.file_name)), data(std::exchange(other.data, nullptr)),
+      size(std::exchange(other.size, 0)) {}
+
+MappedFile::MappedFile(const std::filesystem::path &file_name) : file_name(file_name.string()) {
+    // The handles are closed again right after mapping the file, as the mapping keeps the file open.
+#ifdef _WIN32
+    const HANDLE file = CreateFileW(file_name.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                    FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error("Error: Could not open file " + this->file_name + "!");
+    }
+
+    LARGE_INTEGER file_size;
+    if (!GetFileSizeEx(file, &file_size)) {
+        CloseHandle(file);
+        throw std::runtime_error("Error: Could not get the size of file " + this->file_name + "!");
+    }
+
+    size = static_cast<std::size_t>(file_size.QuadPart);
+
+    // Empty files can't be mapped.
+    if (size > 0) {
+        const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping != nullptr) {
+            data = static_cast<const std::uint8_t *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mapping);
+        }
+    }
+
+    CloseHandle(file);
+#else
+    const int file = open(file_name.c_str(), O_RDONLY);
+    if (file == -1) {
+        throw std::runtime_error("Error: Could not open file " + this->file_name + "!");
+    }
+
+    struct stat file_status;
+    if (fstat(file, &file_status) == -1) {
+        close(file);
+        throw std::runtime_error("Error: Could not get the size of file " + this->file_name + "!");
+    }
+
+    size = static_cast<std::size_t>(file_status.st_size);
+
+    // Empty files can't be mapped.
+    if (size > 0) {
+        void *mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (mapping != MAP_FAILED) {
+            data = static_cast<const std::uint8_t *>(mapping);
+        }
+    }
+
+    close(file);
+#endif
+
+    if (size > 0 && data == nullptr) {
+        throw std::runtime_error("Error: Could not map file " + this->file_name + " into memory!");
+    }
+}
+
+MappedFile::~MappedFile() {
+    if (data == nullptr) {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+#else
+    munmap(const_cast<std::uint8_t *>(data), size);
+#endif
+}
+
+} // namespace inexor::vulkan_renderer::io
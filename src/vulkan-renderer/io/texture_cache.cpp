@@ -0,0 +1,112 @@
+#include "inexor/vulkan-renderer/io/texture_cache.hpp"
+
+#include "inexor/vulkan-renderer/io/image_file.hpp"
+#include "inexor/vulkan-renderer/io/mapped_file.hpp"
+#include "inexor/vulkan-renderer/tools/mip_chain.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+namespace inexor::vulkan_renderer::io {
+
+namespace {
+
+/// Describes how the cache entries are created. It is part of the hash, so changing it invalidates all entries.
+constexpr std::string_view TEXTURE_CACHE_PROCESSING_OPTIONS = "version 1, R8G8B8A8_UNORM, 2x2 box filtered mip chain";
+
+constexpr std::uint64_t FNV_OFFSET_BASIS = 0xCBF29CE484222325;
+constexpr std::uint64_t FNV_PRIME = 0x100000001B3;
+
+/// @brief Continues a 64 bit FNV-1a hash with more data.
+std::uint64_t hash_fnv1a(const std::uint8_t *data, const std::size_t size, std::uint64_t hash = FNV_OFFSET_BASIS) {
+    for (std::size_t i = 0; i < size; i++) {
+        hash = (hash ^ data[i]) * FNV_PRIME;
+    }
+    return hash;
+}
+
+} // namespace
+
+TextureCache::TextureCache(const std::filesystem::path &directory) : directory(directory) {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+
+    if (error) {
+        spdlog::warn("Could not create texture cache directory {}: {}", directory.string(), error.message());
+    }
+}
+
+Ktx2File TextureCache::load(const std::filesystem::path &source_file_name) {
+    const MappedFile source_file(source_file_name);
+
+    if (source_file.get_size() == 0) {
+        throw std::runtime_error("Error: Texture file " + source_file.get_file_name() + " is empty!");
+    }
+
+    std::uint64_t hash = hash_fnv1a(source_file.get_data(), source_file.get_size());
+    hash = hash_fnv1a(reinterpret_cast<const std::uint8_t *>(TEXTURE_CACHE_PROCESSING_OPTIONS.data()),
+                      TEXTURE_CACHE_PROCESSING_OPTIONS.size(), hash);
+
+    std::ostringstream entry_name;
+    entry_name << std::hex << std::setw(16) << std::setfill('0') << hash << ".ktx2";
+
+    const std::filesystem::path entry_file_name = directory / entry_name.str();
+
+    if (std::filesystem::exists(entry_file_name)) {
+        try {
+            Ktx2File entry(entry_file_name);
+            hit_count++;
+            spdlog::debug("Loading texture {} from texture cache entry {}.", source_file.get_file_name(),
+                          entry_file_name.string());
+            return entry;
+        } catch (const std::runtime_error &exception) {
+            // The entry is replaced below.
+            spdlog::warn("Ignoring broken texture cache entry: {}", exception.what());
+        }
+    }
+
+    miss_count++;
+    spdlog::debug("Creating texture cache entry {} for texture {}.", entry_file_name.string(),
+                  source_file.get_file_name());
+
+    const ImageFile image_file(source_file.get_data(), source_file.get_size(), source_file.get_file_name());
+
+    const std::uint32_t width = image_file.get_width();
+    const std::uint32_t height = image_file.get_height();
+    const std::uint32_t mip_levels = tools::calculate_mip_levels(width, height);
+
+    std::vector<std::uint64_t> mip_level_offsets;
+    const auto mip_chain =
+        tools::generate_mip_chain(image_file.get_data(), width, height, mip_levels, mip_level_offsets);
+
+    std::vector<std::vector<std::uint8_t>> levels(mip_levels);
+    for (std::uint32_t level = 0; level < mip_levels; level++) {
+        const std::uint64_t level_end = level + 1 < mip_levels ? mip_level_offsets[level + 1] : mip_chain.size();
+        levels[level].assign(mip_chain.begin() + mip_level_offsets[level], mip_chain.begin() + level_end);
+    }
+
+    // Every thread writes its own temporary file, as the same texture might be loaded by several threads at once.
+    auto temporary_file_name = entry_file_name;
+    temporary_file_name += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id())) + ".tmp";
+
+    write_ktx2_file(temporary_file_name, VK_FORMAT_R8G8B8A8_UNORM, width, height, levels);
+
+    std::error_code error;
+    std::filesystem::rename(temporary_file_name, entry_file_name, error);
+
+    if (error) {
+        std::filesystem::remove(temporary_file_name, error);
+        throw std::runtime_error("Error: Could not create texture cache entry " + entry_file_name.string() + "!");
+    }
+
+    return Ktx2File(entry_file_name);
+}
+
+} // namespace inexor::vulkan_renderer::io
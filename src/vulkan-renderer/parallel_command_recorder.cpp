@@ -0,0 +1,122 @@
+#include "inexor/vulkan-renderer/parallel_command_recorder.hpp"
+
+#include "inexor/vulkan-renderer/frame_arena.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cassert>
+#include <future>
+#include <stdexcept>
+
+namespace inexor::vulkan_renderer {
+
+ParallelCommandRecorder::ParallelCommandRecorder(const VkDevice device, const std::uint32_t queue_family_index,
+                                                 std::shared_ptr<ThreadPool> thread_pool,
+                                                 const std::uint32_t frame_count, const std::uint32_t thread_count)
+    : device(device), thread_pool(std::move(thread_pool)), thread_count(thread_count) {
+    assert(device);
+    assert(this->thread_pool);
+    assert(frame_count > 0);
+    assert(thread_count > 0);
+
+    spdlog::debug("Creating parallel command recorder with {} recording threads for {} frames.", thread_count,
+                  frame_count);
+
+    command_pools.resize(frame_count);
+    command_buffers.resize(frame_count);
+
+    for (std::uint32_t frame = 0; frame < frame_count; frame++) {
+        command_pools[frame].reserve(thread_count);
+        command_buffers[frame].reserve(thread_count);
+
+        for (std::uint32_t slot = 0; slot < thread_count; slot++) {
+            command_pools[frame].emplace_back(device, queue_family_index);
+            command_buffers[frame].emplace_back(device, command_pools[frame].back().get(),
+                                                VK_COMMAND_BUFFER_LEVEL_SECONDARY);
+        }
+    }
+}
+
+void ParallelCommandRecorder::begin_frame(const std::uint32_t frame_index) {
+    assert(frame_index < command_pools.size());
+
+    current_frame = frame_index;
+
+    // Resetting the whole pool is cheaper than resetting every command buffer on its own.
+    for (const auto &command_pool : command_pools[current_frame]) {
+        if (vkResetCommandPool(device, command_pool.get(), 0) != VK_SUCCESS) {
+            throw std::runtime_error("Error: vkResetCommandPool failed!");
+        }
+    }
+}
+
+std::pmr::vector<VkCommandBuffer>
+ParallelCommandRecorder::record(const VkCommandBufferInheritanceInfo &inheritance_info, const std::uint32_t draw_count,
+                                const RecordFunction &record_function) {
+    assert(record_function);
+
+    const std::uint32_t range_count = std::min(thread_count, draw_count);
+    if (range_count == 0) {
+        return std::pmr::vector<VkCommandBuffer>(&FrameArena::get());
+    }
+
+    // The command buffer list and the futures are only needed during this frame, so they are allocated from the frame
+    // arena of the calling thread.
+    std::pmr::vector<VkCommandBuffer> secondary_command_buffers(range_count, &FrameArena::get());
+
+    // Every range is recorded into the command buffer of its own slot, so the ranges do not share any state.
+    auto record_range = [&](const std::uint32_t range_index) {
+        const auto first_draw = static_cast<std::uint32_t>(std::uint64_t(draw_count) * range_index / range_count);
+        const auto end_draw = static_cast<std::uint32_t>(std::uint64_t(draw_count) * (range_index + 1) / range_count);
+
+        const VkCommandBuffer command_buffer = command_buffers[current_frame][range_index].get();
+
+        VkCommandBufferBeginInfo command_buffer_bi = {};
+        command_buffer_bi.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+        command_buffer_bi.flags =
+            VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT;
+        command_buffer_bi.pInheritanceInfo = &inheritance_info;
+
+        if (vkBeginCommandBuffer(command_buffer, &command_buffer_bi) != VK_SUCCESS) {
+            throw std::runtime_error("Error: vkBeginCommandBuffer failed for secondary command buffer!");
+        }
+
+        record_function(command_buffer, first_draw, end_draw - first_draw);
+
+        if (vkEndCommandBuffer(command_buffer) != VK_SUCCESS) {
+            throw std::runtime_error("Error: vkEndCommandBuffer failed for secondary command buffer!");
+        }
+
+        secondary_command_buffers[range_index] = command_buffer;
+    };
+
+    std::pmr::vector<std::future<void>> futures(&FrameArena::get());
+    futures.reserve(range_count - 1);
+
+    for (std::uint32_t range_index = 1; range_index < range_count; range_index++) {
+        futures.push_back(thread_pool->execute(TaskPriority::FRAME_CRITICAL, record_range, range_index));
+    }
+
+    // The tasks reference local variables, so all of them must have finished before an exception leaves this scope.
+    try {
+        record_range(0);
+    } catch (...) {
+        for (auto &future : futures) {
+            future.wait();
+        }
+        throw;
+    }
+
+    for (auto &future : futures) {
+        future.wait();
+    }
+
+    for (auto &future : futures) {
+        future.get();
+    }
+
+    return secondary_command_buffers;
+}
+
+} // namespace inexor::vulkan_renderer
@@ -0,0 +1,66 @@
+#include "inexor/vulkan-renderer/range_allocator.hpp"
+
+#include <cassert>
+#include <iterator>
+
+namespace inexor::vulkan_renderer {
+
+RangeAllocator::RangeAllocator(const std::uint32_t capacity) : capacity(capacity), free_count(capacity) {
+    if (capacity > 0) {
+        free_ranges.emplace(0, capacity);
+    }
+}
+
+std::optional<std::uint32_t> RangeAllocator::allocate(const std::uint32_t count) {
+    assert(count > 0);
+
+    for (auto range = free_ranges.begin(); range != free_ranges.end(); range++) {
+        const auto [offset, size] = *range;
+        if (size < count) {
+            continue;
+        }
+
+        free_ranges.erase(range);
+
+        // The rest of the range stays free.
+        if (size > count) {
+            free_ranges.emplace(offset + count, size - count);
+        }
+
+        free_count -= count;
+        return offset;
+    }
+
+    return std::nullopt;
+}
+
+void RangeAllocator::free(std::uint32_t offset, std::uint32_t count) {
+    assert(count > 0);
+    assert(offset + count <= capacity);
+
+    auto next = free_ranges.lower_bound(offset);
+    assert(next == free_ranges.end() || offset + count <= next->first);
+
+    free_count += count;
+
+    // Merge the range with the free range after it.
+    if (next != free_ranges.end() && offset + count == next->first) {
+        count += next->second;
+        next = free_ranges.erase(next);
+    }
+
+    // Merge the range with the free range before it.
+    if (next != free_ranges.begin()) {
+        auto previous = std::prev(next);
+        assert(previous->first + previous->second <= offset);
+
+        if (previous->first + previous->second == offset) {
+            previous->second += count;
+            return;
+        }
+    }
+
+    free_ranges.emplace_hint(next, offset, count);
+}
+
+} // namespace inexor::vulkan_renderer
@@ -0,0 +1,802 @@
+#include "inexor/vulkan-renderer/render_graph.hpp"
+
+#include "inexor/vulkan-renderer/frame_arena.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <stdexcept>
+
+namespace inexor::vulkan_renderer {
+
+namespace {
+
+/// The access flags which write memory. Only those need to be made available by a barrier.
+constexpr VkAccessFlags WRITE_ACCESS_MASK = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT |
+                                            VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT | VK_ACCESS_SHADER_WRITE_BIT |
+                                            VK_ACCESS_TRANSFER_WRITE_BIT;
+
+bool has_stencil_component(const VkFormat format) {
+    switch (format) {
+    case VK_FORMAT_S8_UINT:
+    case VK_FORMAT_D16_UNORM_S8_UINT:
+    case VK_FORMAT_D24_UNORM_S8_UINT:
+    case VK_FORMAT_D32_SFLOAT_S8_UINT:
+        return true;
+    default:
+        return false;
+    }
+}
+
+VkImageAspectFlags get_aspect_mask(const TextureResource *texture) {
+    if (texture->get_usage() != TextureUsage::DEPTH_STENCIL) {
+        return VK_IMAGE_ASPECT_COLOR_BIT;
+    }
+    if (has_stencil_component(texture->get_format())) {
+        return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+    }
+    return VK_IMAGE_ASPECT_DEPTH_BIT;
+}
+
+} // namespace
+
+const RenderStage::TextureAccessInfo *RenderStage::find_access(const TextureResource *texture) const {
+    for (const auto &access : accesses) {
+        if (access.texture == texture) {
+            return &access;
+        }
+    }
+    return nullptr;
+}
+
+void RenderStage::writes_to(const TextureResource *texture, std::optional<VkClearValue> clear_value) {
+    assert(texture);
+
+    if (find_access(texture) != nullptr) {
+        throw std::runtime_error("Error: Render stage " + name + " accesses texture " + texture->get_name() +
+                                 " more than once!");
+    }
+
+    accesses.push_back({texture, TextureAccess::ATTACHMENT, nullptr, clear_value});
+}
+
+void RenderStage::resolves_to(const TextureResource *source, const TextureResource *target) {
+    assert(source);
+    assert(target);
+
+    const auto *source_access = find_access(source);
+    if (source_access == nullptr || source_access->access != TextureAccess::ATTACHMENT ||
+        source->get_usage() == TextureUsage::DEPTH_STENCIL) {
+        throw std::runtime_error("Error: Render stage " + name + " can't resolve texture " + source->get_name() +
+                                 " because it does not write to it as color attachment!");
+    }
+
+    if (find_access(target) != nullptr || target->get_usage() == TextureUsage::DEPTH_STENCIL) {
+        throw std::runtime_error("Error: Render stage " + name + " can't resolve into texture " + target->get_name() +
+                                 "!");
+    }
+
+    accesses.push_back({target, TextureAccess::RESOLVE_ATTACHMENT, source, std::nullopt});
+}
+
+void RenderStage::reads_from(const TextureResource *texture) {
+    assert(texture);
+
+    if (find_access(texture) != nullptr || texture->get_usage() == TextureUsage::BACK_BUFFER) {
+        throw std::runtime_error("Error: Render stage " + name + " can't read from texture " + texture->get_name() +
+                                 "!");
+    }
+
+    accesses.push_back({texture, TextureAccess::SAMPLED, nullptr, std::nullopt});
+}
+
+RenderGraph::PhysicalImage::PhysicalImage(PhysicalImage &&other) noexcept
+    : device(other.device), image(std::exchange(other.image, VK_NULL_HANDLE)),
+      image_view(std::exchange(other.image_view, VK_NULL_HANDLE)) {}
+
+RenderGraph::PhysicalImage::~PhysicalImage() {
+    vkDestroyImageView(device, image_view, nullptr);
+    vkDestroyImage(device, image, nullptr);
+}
+
+RenderGraph::MemoryBlock::MemoryBlock(MemoryBlock &&other) noexcept
+    : vma_allocator(other.vma_allocator), allocation(std::exchange(other.allocation, VK_NULL_HANDLE)) {}
+
+RenderGraph::MemoryBlock::~MemoryBlock() {
+    if (allocation != VK_NULL_HANDLE) {
+        vmaFreeMemory(vma_allocator, allocation);
+    }
+}
+
+RenderGraph::RenderGraph(const VkDevice device, const VmaAllocator vma_allocator)
+    : device(device), vma_allocator(vma_allocator) {
+    assert(device);
+    assert(vma_allocator);
+}
+
+RenderGraph::~RenderGraph() {
+    // The framebuffers reference the images, which reference the memory blocks.
+    physical_stages.clear();
+    physical_images.clear();
+    memory_blocks.clear();
+}
+
+RenderGraph::TextureState RenderGraph::get_required_state(const RenderStage::TextureAccessInfo &access) {
+    if (access.access == RenderStage::TextureAccess::SAMPLED) {
+        return {VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT,
+                VK_ACCESS_SHADER_READ_BIT};
+    }
+
+    if (access.texture->get_usage() == TextureUsage::DEPTH_STENCIL) {
+        return {VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL,
+                VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT,
+                VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT};
+    }
+
+    return {VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+            VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT};
+}
+
+RenderGraph::TextureState RenderGraph::get_export_state() {
+    return {VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT};
+}
+
+void RenderGraph::sort_stages() {
+    using TextureAccess = RenderStage::TextureAccess;
+
+    // Stages access textures in the order they were added: a stage reads what the stages added before it wrote. If
+    // no stage added before it writes the texture, the stage reads what the stages added after it write, so stages can
+    // be added in any order as long as every texture is only written once.
+    std::unordered_map<const RenderStage *, std::vector<const RenderStage *>> dependencies;
+
+    const auto writes = [](const RenderStage *stage, const TextureResource *texture) {
+        const auto *access = stage->find_access(texture);
+        return access != nullptr && access->access != TextureAccess::SAMPLED;
+    };
+
+    const auto has_earlier_writer = [&](const TextureResource *texture, const std::size_t stage_index) {
+        return std::any_of(stages.begin(), stages.begin() + stage_index,
+                           [&](const auto &stage) { return writes(stage.get(), texture); });
+    };
+
+    for (std::size_t i = 0; i < stages.size(); i++) {
+        for (const auto &access : stages[i]->accesses) {
+            const bool reads = access.access == TextureAccess::SAMPLED;
+            const bool reads_earlier_writes = has_earlier_writer(access.texture, i);
+            bool has_writer = false;
+
+            for (std::size_t j = 0; j < stages.size(); j++) {
+                const auto *other_access = stages[j]->find_access(access.texture);
+                if (i == j || other_access == nullptr) {
+                    continue;
+                }
+
+                const bool other_reads = other_access->access == TextureAccess::SAMPLED;
+                has_writer |= !other_reads;
+
+                bool depends = false;
+                if (reads && !other_reads) {
+                    // Read after write.
+                    depends = j < i || !reads_earlier_writes;
+                } else if (!reads && !other_reads) {
+                    // Write after write.
+                    depends = j < i;
+                } else if (!reads && other_reads) {
+                    // Write after read, if the other stage reads what was written before this stage.
+                    depends = j < i && has_earlier_writer(access.texture, j);
+                }
+
+                if (depends) {
+                    dependencies[stages[i].get()].push_back(stages[j].get());
+                }
+            }
+
+            if (reads && !has_writer) {
+                throw std::runtime_error("Error: Render stage " + stages[i]->name + " reads from texture " +
+                                         access.texture->get_name() + ", which is not written by any stage!");
+            }
+        }
+    }
+
+    // Depth first search from the stages which write the back buffer. Stages which are not reached do not contribute
+    // to the frame. The value is false while the stage is being visited, which detects cycles.
+    std::unordered_map<const RenderStage *, bool> visited;
+    std::vector<const RenderStage *> ordered_stages;
+
+    std::function<void(const RenderStage *)> visit = [&](const RenderStage *stage) {
+        if (const auto it = visited.find(stage); it != visited.end()) {
+            if (!it->second) {
+                throw std::runtime_error("Error: The render graph contains a cycle at render stage " + stage->name +
+                                         "!");
+            }
+            return;
+        }
+
+        visited[stage] = false;
+
+        for (const auto *dependency : dependencies[stage]) {
+            visit(dependency);
+        }
+
+        visited[stage] = true;
+        ordered_stages.push_back(stage);
+    };
+
+    for (const auto &stage : stages) {
+        const auto *access = stage->find_access(back_buffer);
+        if (access != nullptr && access->access != TextureAccess::SAMPLED) {
+            visit(stage.get());
+        }
+    }
+
+    if (ordered_stages.empty()) {
+        throw std::runtime_error("Error: No render stage writes to back buffer " + back_buffer->get_name() + "!");
+    }
+
+    for (const auto &stage : stages) {
+        if (visited.find(stage.get()) == visited.end()) {
+            spdlog::debug("Render stage {} does not contribute to the back buffer and is skipped.", stage->name);
+        }
+    }
+
+    physical_stages.clear();
+
+    for (const auto *stage : ordered_stages) {
+        spdlog::debug("Render stage #{}: {}.", physical_stages.size(), stage->name);
+        physical_stages.push_back({stage});
+    }
+}
+
+void RenderGraph::collect_texture_usages() {
+    lifetimes.clear();
+    image_usages.clear();
+
+    for (std::size_t i = 0; i < physical_stages.size(); i++) {
+        for (const auto &access : physical_stages[i].stage->accesses) {
+            if (access.texture->format == VK_FORMAT_UNDEFINED) {
+                throw std::runtime_error("Error: Texture " + access.texture->get_name() + " has no format!");
+            }
+            if (access.texture->exported && access.texture->usage == TextureUsage::BACK_BUFFER) {
+                throw std::runtime_error("Error: The back buffer " + access.texture->get_name() +
+                                         " can't be exported!");
+            }
+
+            auto [lifetime, inserted] = lifetimes.try_emplace(access.texture, TextureLifetime{i, i});
+            lifetime->second.last_stage = i;
+
+            auto &image_usage = image_usages[access.texture];
+            if (access.access == RenderStage::TextureAccess::SAMPLED) {
+                image_usage |= VK_IMAGE_USAGE_SAMPLED_BIT;
+            } else if (access.texture->usage == TextureUsage::DEPTH_STENCIL) {
+                image_usage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+            } else {
+                image_usage |= VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+            }
+
+            // Exported textures are sampled after the last stage.
+            if (access.texture->exported) {
+                image_usage |= VK_IMAGE_USAGE_SAMPLED_BIT;
+            }
+        }
+    }
+
+    // Attachments which are only used by a single stage are never stored to memory, so tiled GPUs can keep them in
+    // on-chip memory. This is typically the case for depth buffers and multisampled color buffers.
+    for (auto &[texture, image_usage] : image_usages) {
+        const auto &lifetime = lifetimes.at(texture);
+        if (texture->usage != TextureUsage::BACK_BUFFER && lifetime.first_stage == lifetime.last_stage &&
+            (image_usage & VK_IMAGE_USAGE_SAMPLED_BIT) == 0) {
+            image_usage |= VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT;
+        }
+    }
+}
+
+void RenderGraph::create_render_passes() {
+    using TextureAccess = RenderStage::TextureAccess;
+
+    // The state of every texture at the end of a frame, after the last stage which uses it.
+    std::unordered_map<const TextureResource *, TextureState> final_states;
+    for (const auto &physical_stage : physical_stages) {
+        for (const auto &access : physical_stage.stage->accesses) {
+            final_states[access.texture] = access.texture->exported ? get_export_state() : get_required_state(access);
+        }
+    }
+
+    std::unordered_map<const TextureResource *, TextureState> states;
+
+    for (std::size_t i = 0; i < physical_stages.size(); i++) {
+        auto &physical_stage = physical_stages[i];
+        const auto *stage = physical_stage.stage;
+
+        physical_stage.attachments.clear();
+        physical_stage.clear_values.clear();
+        physical_stage.barriers.clear();
+
+        std::vector<VkAttachmentDescription> attachments;
+        std::vector<VkAttachmentReference> color_references;
+        std::vector<const TextureResource *> color_textures;
+        std::vector<std::pair<const TextureResource *, std::uint32_t>> resolve_attachments;
+        std::optional<VkAttachmentReference> depth_reference;
+
+        for (const auto &access : stage->accesses) {
+            const auto *texture = access.texture;
+            const auto &lifetime = lifetimes.at(texture);
+            const bool first_use = lifetime.first_stage == i;
+            const TextureState new_state = get_required_state(access);
+
+            TextureState old_state;
+            if (!first_use) {
+                old_state = states.at(texture);
+            } else if (texture->usage == TextureUsage::BACK_BUFFER) {
+                // The back buffer is acquired from the swapchain, and the submission waits for it in this stage.
+                old_state = {VK_IMAGE_LAYOUT_UNDEFINED, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0};
+            } else {
+                // The content of a transient texture is discarded at its first use. The previous frame might still use
+                // its memory though, as might every texture it could share its memory with. Those are the textures
+                // whose lifetime does not overlap with this texture's lifetime.
+                old_state = {VK_IMAGE_LAYOUT_UNDEFINED, final_states.at(texture).stage_mask,
+                             final_states.at(texture).access_mask};
+
+                for (const auto &[other_texture, other_lifetime] : lifetimes) {
+                    if (other_texture->usage != TextureUsage::BACK_BUFFER &&
+                        (other_lifetime.last_stage < lifetime.first_stage ||
+                         other_lifetime.first_stage > lifetime.last_stage)) {
+                        old_state.stage_mask |= final_states.at(other_texture).stage_mask;
+                        old_state.access_mask |= final_states.at(other_texture).access_mask;
+                    }
+                }
+            }
+
+            // Only consecutive reads in the same layout do not need a barrier.
+            if (old_state.layout != new_state.layout || (old_state.access_mask & WRITE_ACCESS_MASK) != 0 ||
+                (new_state.access_mask & WRITE_ACCESS_MASK) != 0) {
+                old_state.access_mask &= WRITE_ACCESS_MASK;
+                physical_stage.barriers.push_back({texture, old_state, new_state});
+            }
+
+            states[texture] = new_state;
+
+            if (access.access == TextureAccess::SAMPLED) {
+                continue;
+            }
+
+            const bool is_used_later =
+                lifetime.last_stage > i || texture->usage == TextureUsage::BACK_BUFFER || texture->exported;
+
+            VkAttachmentDescription attachment = {};
+            attachment.format = texture->format;
+            attachment.samples = texture->sample_count;
+
+            if (access.clear_value) {
+                attachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+            } else if (!first_use && access.access == TextureAccess::ATTACHMENT) {
+                attachment.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+            } else {
+                attachment.loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+            }
+
+            attachment.storeOp = is_used_later ? VK_ATTACHMENT_STORE_OP_STORE : VK_ATTACHMENT_STORE_OP_DONT_CARE;
+
+            if (has_stencil_component(texture->format)) {
+                attachment.stencilLoadOp = attachment.loadOp;
+                attachment.stencilStoreOp = attachment.storeOp;
+            } else {
+                attachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+                attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+            }
+
+            // Layout transitions are done by the barriers in front of the render pass.
+            attachment.initialLayout = new_state.layout;
+            attachment.finalLayout = new_state.layout;
+
+            const auto attachment_index = static_cast<std::uint32_t>(attachments.size());
+            attachments.push_back(attachment);
+            physical_stage.attachments.push_back(texture);
+            physical_stage.clear_values.push_back(access.clear_value.value_or(VkClearValue{}));
+
+            if (access.access == TextureAccess::RESOLVE_ATTACHMENT) {
+                resolve_attachments.emplace_back(access.resolve_source, attachment_index);
+            } else if (texture->usage == TextureUsage::DEPTH_STENCIL) {
+                if (depth_reference) {
+                    throw std::runtime_error("Error: Render stage " + stage->name +
+                                             " writes to more than one depth buffer!");
+                }
+                depth_reference = VkAttachmentReference{attachment_index, new_state.layout};
+            } else {
+                color_references.push_back({attachment_index, new_state.layout});
+                color_textures.push_back(texture);
+            }
+        }
+
+        // The resolve attachments must be in the same order as the color attachments they resolve.
+        std::vector<VkAttachmentReference> resolve_references;
+        if (!resolve_attachments.empty()) {
+            resolve_references.resize(color_references.size(), {VK_ATTACHMENT_UNUSED, VK_IMAGE_LAYOUT_UNDEFINED});
+
+            for (const auto &[source, attachment_index] : resolve_attachments) {
+                const auto color_index = static_cast<std::size_t>(std::distance(
+                    color_textures.begin(), std::find(color_textures.begin(), color_textures.end(), source)));
+                resolve_references[color_index] = {attachment_index, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL};
+            }
+        }
+
+        VkSubpassDescription subpass_description = {};
+        subpass_description.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+        subpass_description.colorAttachmentCount = static_cast<std::uint32_t>(color_references.size());
+        subpass_description.pColorAttachments = color_references.data();
+        subpass_description.pResolveAttachments = resolve_references.empty() ? nullptr : resolve_references.data();
+        subpass_description.pDepthStencilAttachment = depth_reference ? &depth_reference.value() : nullptr;
+
+        // There are no subpass dependencies because all synchronisation is done with the barriers.
+        physical_stage.render_pass = std::make_unique<wrapper::RenderPass>(
+            device, attachments, std::vector<VkSubpassDependency>{}, subpass_description, stage->name);
+    }
+
+    TextureState back_buffer_final_state = {back_buffer_final_layout, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0};
+    if (back_buffer_final_layout == VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL) {
+        back_buffer_final_state.stage_mask = VK_PIPELINE_STAGE_TRANSFER_BIT;
+        back_buffer_final_state.access_mask = VK_ACCESS_TRANSFER_READ_BIT;
+    }
+
+    TextureState back_buffer_state = states.at(back_buffer);
+    back_buffer_state.access_mask &= WRITE_ACCESS_MASK;
+
+    back_buffer_final_barrier = TextureBarrier{back_buffer, back_buffer_state, back_buffer_final_state};
+
+    export_barriers.clear();
+    for (const auto &texture : textures) {
+        if (!texture->exported || states.find(texture.get()) == states.end()) {
+            continue;
+        }
+
+        TextureState export_state = states.at(texture.get());
+        export_state.access_mask &= WRITE_ACCESS_MASK;
+
+        export_barriers.push_back({texture.get(), export_state, get_export_state()});
+    }
+}
+
+void RenderGraph::compile(const TextureResource *target, const VkImageLayout target_final_layout) {
+    assert(target);
+
+    if (target->usage != TextureUsage::BACK_BUFFER) {
+        throw std::runtime_error("Error: The target of the render graph must be a back buffer!");
+    }
+
+    back_buffer = target;
+    back_buffer_final_layout = target_final_layout;
+
+    spdlog::debug("Compiling render graph with {} stages and {} textures.", stages.size(), textures.size());
+
+    sort_stages();
+    collect_texture_usages();
+    create_render_passes();
+
+    spdlog::debug("Compiled render graph successfully.");
+}
+
+void RenderGraph::create_transient_images() {
+    struct TransientImage {
+        const TextureResource *texture;
+        VkMemoryRequirements requirements;
+    };
+
+    std::vector<TransientImage> transient_images;
+
+    // Iterate over the textures instead of the lifetimes so the images are created in a deterministic order.
+    for (const auto &texture : textures) {
+        if (texture->usage == TextureUsage::BACK_BUFFER || lifetimes.find(texture.get()) == lifetimes.end()) {
+            continue;
+        }
+
+        VkImageCreateInfo image_ci = {};
+        image_ci.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+        image_ci.imageType = VK_IMAGE_TYPE_2D;
+        image_ci.format = texture->format;
+        image_ci.extent = {extent.width, extent.height, 1};
+        image_ci.mipLevels = 1;
+        image_ci.arrayLayers = 1;
+        image_ci.samples = texture->sample_count;
+        image_ci.tiling = VK_IMAGE_TILING_OPTIMAL;
+        image_ci.usage = image_usages.at(texture.get());
+        image_ci.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+        image_ci.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+        PhysicalImage physical_image(device);
+
+        if (vkCreateImage(device, &image_ci, nullptr, &physical_image.image) != VK_SUCCESS) {
+            throw std::runtime_error("Error: vkCreateImage failed for texture " + texture->get_name() + "!");
+        }
+
+        VkMemoryRequirements requirements;
+        vkGetImageMemoryRequirements(device, physical_image.image, &requirements);
+
+        transient_images.push_back({texture.get(), requirements});
+        physical_images.emplace(texture.get(), std::move(physical_image));
+    }
+
+    // Place the largest images first. Every image is bound to the first memory block which has a compatible memory
+    // type and whose images are not alive at the same time as the image.
+    std::stable_sort(transient_images.begin(), transient_images.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.requirements.size > rhs.requirements.size;
+    });
+
+    struct MemoryBlockInfo {
+        VkMemoryRequirements requirements;
+        bool transient_attachments_only;
+        std::vector<const TextureResource *> textures;
+    };
+
+    std::vector<MemoryBlockInfo> blocks;
+
+    for (const auto &transient_image : transient_images) {
+        const auto &lifetime = lifetimes.at(transient_image.texture);
+        const bool is_transient_attachment =
+            (image_usages.at(transient_image.texture) & VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT) != 0;
+
+        // The content of exported textures must outlive the frame, so they never share their memory.
+        auto block = std::find_if(blocks.begin(), blocks.end(), [&](const MemoryBlockInfo &candidate) {
+            if (transient_image.texture->exported || candidate.textures.front()->exported ||
+                (candidate.requirements.memoryTypeBits & transient_image.requirements.memoryTypeBits) == 0) {
+                return false;
+            }
+            return std::none_of(candidate.textures.begin(), candidate.textures.end(),
+                                [&](const TextureResource *texture) {
+                                    const auto &other_lifetime = lifetimes.at(texture);
+                                    return other_lifetime.first_stage <= lifetime.last_stage &&
+                                           lifetime.first_stage <= other_lifetime.last_stage;
+                                });
+        });
+
+        if (block == blocks.end()) {
+            blocks.push_back({transient_image.requirements, is_transient_attachment, {transient_image.texture}});
+            continue;
+        }
+
+        block->requirements.size = std::max(block->requirements.size, transient_image.requirements.size);
+        block->requirements.alignment =
+            std::max(block->requirements.alignment, transient_image.requirements.alignment);
+        block->requirements.memoryTypeBits &= transient_image.requirements.memoryTypeBits;
+        block->transient_attachments_only &= is_transient_attachment;
+        block->textures.push_back(transient_image.texture);
+    }
+
+    transient_memory_size = 0;
+
+    for (const auto &block_info : blocks) {
+        VmaAllocationCreateInfo allocation_ci = {};
+        allocation_ci.usage = block_info.transient_attachments_only ? VMA_MEMORY_USAGE_GPU_LAZILY_ALLOCATED
+                                                                    : VMA_MEMORY_USAGE_GPU_ONLY;
+
+        MemoryBlock block(vma_allocator);
+
+        VkResult result =
+            vmaAllocateMemory(vma_allocator, &block_info.requirements, &allocation_ci, &block.allocation, nullptr);
+
+        // Lazily allocated memory is usually only available on tiled GPUs.
+        if (result != VK_SUCCESS && block_info.transient_attachments_only) {
+            allocation_ci.usage = VMA_MEMORY_USAGE_GPU_ONLY;
+            result =
+                vmaAllocateMemory(vma_allocator, &block_info.requirements, &allocation_ci, &block.allocation, nullptr);
+        }
+
+        if (result != VK_SUCCESS) {
+            throw std::runtime_error("Error: vmaAllocateMemory failed for transient render graph images!");
+        }
+
+        for (const auto *texture : block_info.textures) {
+            if (vmaBindImageMemory(vma_allocator, block.allocation, physical_images.at(texture).image) != VK_SUCCESS) {
+                throw std::runtime_error("Error: vmaBindImageMemory failed for texture " + texture->get_name() + "!");
+            }
+        }
+
+        transient_memory_size += block_info.requirements.size;
+        memory_blocks.push_back(std::move(block));
+    }
+
+    for (auto &[texture, physical_image] : physical_images) {
+        VkImageViewCreateInfo image_view_ci = {};
+        image_view_ci.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        image_view_ci.image = physical_image.image;
+        image_view_ci.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        image_view_ci.format = texture->format;
+        image_view_ci.subresourceRange.baseMipLevel = 0;
+        image_view_ci.subresourceRange.levelCount = 1;
+        image_view_ci.subresourceRange.baseArrayLayer = 0;
+        image_view_ci.subresourceRange.layerCount = 1;
+
+        // Image views which are sampled must only have one aspect, so depth buffers are only sampled by depth.
+        image_view_ci.subresourceRange.aspectMask = (image_usages.at(texture) & VK_IMAGE_USAGE_SAMPLED_BIT) != 0
+                                                        ? get_aspect_mask(texture) & ~VK_IMAGE_ASPECT_STENCIL_BIT
+                                                        : get_aspect_mask(texture);
+
+        if (vkCreateImageView(device, &image_view_ci, nullptr, &physical_image.image_view) != VK_SUCCESS) {
+            throw std::runtime_error("Error: vkCreateImageView failed for texture " + texture->get_name() + "!");
+        }
+    }
+
+    spdlog::debug("Created {} transient images in {} memory blocks with a total size of {} bytes.",
+                  physical_images.size(), memory_blocks.size(), transient_memory_size);
+}
+
+void RenderGraph::create_physical_resources(const VkExtent2D extent, const std::vector<VkImage> &back_buffer_images,
+                                            const std::vector<VkImageView> &back_buffer_image_views,
+                                            DeletionQueue &deletion_queue) {
+    assert(!physical_stages.empty());
+    assert(extent.width > 0);
+    assert(extent.height > 0);
+    assert(!back_buffer_images.empty());
+    assert(back_buffer_images.size() == back_buffer_image_views.size());
+
+    // The framebuffers are destroyed before the images, and the images before the memory they are bound to.
+    for (auto &physical_stage : physical_stages) {
+        if (physical_stage.framebuffer) {
+            deletion_queue.retire(std::move(physical_stage.framebuffer));
+        }
+    }
+
+    if (!physical_images.empty()) {
+        deletion_queue.retire(std::move(physical_images));
+        deletion_queue.retire(std::move(memory_blocks));
+    }
+
+    physical_images.clear();
+    memory_blocks.clear();
+
+    this->extent = extent;
+    this->back_buffer_images = back_buffer_images;
+    this->back_buffer_image_views = back_buffer_image_views;
+
+    create_transient_images();
+
+    for (auto &physical_stage : physical_stages) {
+        std::vector<std::vector<VkImageView>> frame_attachments(back_buffer_images.size());
+
+        for (std::uint32_t i = 0; i < back_buffer_images.size(); i++) {
+            for (const auto *texture : physical_stage.attachments) {
+                frame_attachments[i].push_back(get_image_view(texture, i));
+            }
+        }
+
+        physical_stage.framebuffer =
+            std::make_unique<wrapper::Framebuffer>(device, physical_stage.render_pass->get(), frame_attachments,
+                                                   extent.width, extent.height, physical_stage.stage->name);
+    }
+}
+
+VkImage RenderGraph::get_image(const TextureResource *texture, const std::uint32_t back_buffer_index) const {
+    if (texture->usage == TextureUsage::BACK_BUFFER) {
+        return back_buffer_images.at(back_buffer_index);
+    }
+    return physical_images.at(texture).image;
+}
+
+VkImageView RenderGraph::get_image_view(const TextureResource *texture, const std::uint32_t back_buffer_index) const {
+    if (texture->usage == TextureUsage::BACK_BUFFER) {
+        return back_buffer_image_views.at(back_buffer_index);
+    }
+    return physical_images.at(texture).image_view;
+}
+
+void RenderGraph::record_barriers(const VkCommandBuffer command_buffer, const TextureBarrier *barriers,
+                                  const std::size_t barrier_count, const std::uint32_t back_buffer_index) const {
+    if (barrier_count == 0) {
+        return;
+    }
+
+    // The barriers are recorded every frame, so their array is allocated from the frame arena.
+    std::pmr::vector<VkImageMemoryBarrier> image_barriers(&FrameArena::get());
+    image_barriers.reserve(barrier_count);
+
+    VkPipelineStageFlags src_stage_mask = 0;
+    VkPipelineStageFlags dst_stage_mask = 0;
+
+    for (std::size_t i = 0; i < barrier_count; i++) {
+        const TextureBarrier &barrier = barriers[i];
+        VkImageMemoryBarrier image_barrier = {};
+        image_barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+        image_barrier.srcAccessMask = barrier.old_state.access_mask;
+        image_barrier.dstAccessMask = barrier.new_state.access_mask;
+        image_barrier.oldLayout = barrier.old_state.layout;
+        image_barrier.newLayout = barrier.new_state.layout;
+        image_barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        image_barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+        image_barrier.image = get_image(barrier.texture, back_buffer_index);
+        image_barrier.subresourceRange.aspectMask = get_aspect_mask(barrier.texture);
+        image_barrier.subresourceRange.baseMipLevel = 0;
+        image_barrier.subresourceRange.levelCount = 1;
+        image_barrier.subresourceRange.baseArrayLayer = 0;
+        image_barrier.subresourceRange.layerCount = 1;
+
+        image_barriers.push_back(image_barrier);
+
+        src_stage_mask |= barrier.old_state.stage_mask;
+        dst_stage_mask |= barrier.new_state.stage_mask;
+    }
+
+    vkCmdPipelineBarrier(command_buffer, src_stage_mask != 0 ? src_stage_mask : VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT,
+                         dst_stage_mask, 0, 0, nullptr, 0, nullptr, static_cast<std::uint32_t>(image_barriers.size()),
+                         image_barriers.data());
+}
+
+void RenderGraph::record(const VkCommandBuffer command_buffer, const std::uint32_t back_buffer_index) const {
+    assert(command_buffer);
+    assert(back_buffer_index < back_buffer_images.size());
+
+    for (const auto &physical_stage : physical_stages) {
+        record_barriers(command_buffer, physical_stage.barriers.data(), physical_stage.barriers.size(),
+                        back_buffer_index);
+
+        VkRenderPassBeginInfo render_pass_bi = {};
+        render_pass_bi.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+        render_pass_bi.renderPass = physical_stage.render_pass->get();
+        render_pass_bi.framebuffer = physical_stage.framebuffer->get(back_buffer_index);
+        render_pass_bi.renderArea.offset = {0, 0};
+        render_pass_bi.renderArea.extent = extent;
+        render_pass_bi.clearValueCount = static_cast<std::uint32_t>(physical_stage.clear_values.size());
+        render_pass_bi.pClearValues = physical_stage.clear_values.data();
+
+        if (physical_stage.stage->on_record_secondary) {
+            vkCmdBeginRenderPass(command_buffer, &render_pass_bi, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+            VkCommandBufferInheritanceInfo inheritance_info = {};
+            inheritance_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO;
+            inheritance_info.renderPass = render_pass_bi.renderPass;
+            inheritance_info.subpass = 0;
+            inheritance_info.framebuffer = render_pass_bi.framebuffer;
+
+            const auto secondary_command_buffers = physical_stage.stage->on_record_secondary(inheritance_info);
+            if (!secondary_command_buffers.empty()) {
+                vkCmdExecuteCommands(command_buffer, static_cast<std::uint32_t>(secondary_command_buffers.size()),
+                                     secondary_command_buffers.data());
+            }
+        } else {
+            vkCmdBeginRenderPass(command_buffer, &render_pass_bi, VK_SUBPASS_CONTENTS_INLINE);
+
+            if (physical_stage.stage->on_record) {
+                physical_stage.stage->on_record(command_buffer);
+            }
+        }
+
+        vkCmdEndRenderPass(command_buffer);
+    }
+
+    if (back_buffer_final_barrier) {
+        record_barriers(command_buffer, &*back_buffer_final_barrier, 1, back_buffer_index);
+    }
+
+    record_barriers(command_buffer, export_barriers.data(), export_barriers.size(), back_buffer_index);
+}
+
+VkRenderPass RenderGraph::get_render_pass(const RenderStage *stage) const {
+    for (const auto &physical_stage : physical_stages) {
+        if (physical_stage.stage == stage) {
+            return physical_stage.render_pass->get();
+        }
+    }
+    throw std::runtime_error("Error: Render stage " + stage->get_name() + " is not part of the compiled render graph!");
+}
+
+VkImage RenderGraph::get_exported_image(const TextureResource *texture) const {
+    assert(texture);
+
+    const auto physical_image = physical_images.find(texture);
+    if (!texture->exported || physical_image == physical_images.end()) {
+        throw std::runtime_error("Error: Texture " + texture->get_name() + " is not exported by the render graph!");
+    }
+    return physical_image->second.image;
+}
+
+VkImageView RenderGraph::get_exported_image_view(const TextureResource *texture) const {
+    assert(texture);
+
+    const auto physical_image = physical_images.find(texture);
+    if (!texture->exported || physical_image == physical_images.end()) {
+        throw std::runtime_error("Error: Texture " + texture->get_name() + " is not exported by the render graph!");
+    }
+    return physical_image->second.image_view;
+}
+
+} // namespace inexor::vulkan_renderer
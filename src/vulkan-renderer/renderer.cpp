@@ -3,169 +3,255 @@
 #include "inexor/vulkan-renderer/error_handling.hpp"
 #include "inexor/vulkan-renderer/octree_vertex.hpp"
 #include "inexor/vulkan-renderer/standard_ubo.hpp"
+#ifdef INEXOR_USE_COROUTINES
+#include "inexor/vulkan-renderer/task.hpp"
+#endif
 
 #include <spdlog/spdlog.h>
 
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include <fstream>
 
 namespace inexor::vulkan_renderer {
 
-VkResult VulkanRenderer::create_uniform_buffers() {
-    uniform_buffers.emplace_back(vkdevice->get_device(), vma->get_allocator(), std::string("matrices uniform buffer"),
-                                 sizeof(UniformBufferObject));
+void VulkanRenderer::FenceWaiterDeleter::operator()(FenceWaiter *fence_waiter) const {
+#ifdef INEXOR_USE_COROUTINES
+    delete fence_waiter;
+#else
+    // The fence waiter is never created without coroutine support.
+    static_cast<void>(fence_waiter);
+#endif
+}
 
-    return VK_SUCCESS;
+VkFormat VulkanRenderer::get_color_format() const {
+    return headless ? HEADLESS_COLOR_FORMAT : swapchain->get_image_format();
 }
 
-VkResult VulkanRenderer::create_depth_buffer() {
+VkExtent2D VulkanRenderer::get_render_extent() const {
+    return headless ? VkExtent2D{window_width, window_height} : swapchain->get_extent();
+}
 
-    const std::vector<VkFormat> supported_formats = {VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D32_SFLOAT,
-                                                     VK_FORMAT_D24_UNORM_S8_UINT, VK_FORMAT_D16_UNORM_S8_UINT,
-                                                     VK_FORMAT_D16_UNORM};
+std::uint32_t VulkanRenderer::get_render_target_count() const {
+    return headless ? static_cast<std::uint32_t>(offscreen_images.size()) : swapchain->get_image_count();
+}
 
-    VkImageTiling tiling = VK_IMAGE_TILING_OPTIMAL;
-    VkFormatFeatureFlags format = VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT;
+std::vector<VkImage> VulkanRenderer::get_render_target_images() const {
+    if (!headless) {
+        return swapchain->get_images();
+    }
 
-    auto depth_buffer_format_candidate = settings_decision_maker->find_depth_buffer_format(
-        vkdevice->get_physical_device(), supported_formats, tiling, format);
+    std::vector<VkImage> images;
+    for (const auto &offscreen_image : offscreen_images) {
+        images.push_back(offscreen_image.get());
+    }
+    return images;
+}
 
-    if (!depth_buffer_format_candidate) {
-        throw std::runtime_error("Error: Could not find appropriate image format for depth buffer!");
+std::vector<VkImageView> VulkanRenderer::get_render_target_views() const {
+    if (!headless) {
+        return swapchain->get_image_views();
     }
 
-    // Create depth buffer image and image view.
-    depth_buffer = std::make_unique<wrapper::Image>(
-        vkdevice->get_device(), vkdevice->get_physical_device(), vma->get_allocator(),
-        depth_buffer_format_candidate.value(), VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT, VK_IMAGE_ASPECT_DEPTH_BIT,
-        VK_SAMPLE_COUNT_1_BIT, "Depth buffer", swapchain->get_extent());
+    std::vector<VkImageView> image_views;
+    for (const auto &offscreen_image : offscreen_images) {
+        image_views.push_back(offscreen_image.get_image_view());
+    }
+    return image_views;
+}
+
+VkResult VulkanRenderer::create_offscreen_images() {
+    assert(headless);
+    assert(window_width > 0);
+    assert(window_height > 0);
+
+    spdlog::debug("Creating {} offscreen images of size {} x {}.", MAX_FRAMES_IN_FLIGHT, window_width, window_height);
+
+    offscreen_images.clear();
+
+    for (std::size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+        offscreen_images.emplace_back(vkdevice->get_device(), vkdevice->get_physical_device(), vma->get_allocator(),
+                                      HEADLESS_COLOR_FORMAT,
+                                      VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
+                                      VK_IMAGE_ASPECT_COLOR_BIT, VK_SAMPLE_COUNT_1_BIT,
+                                      "Offscreen image #" + std::to_string(i), get_render_extent());
+    }
 
     return VK_SUCCESS;
 }
 
-VkResult VulkanRenderer::create_command_buffers() {
+VkResult VulkanRenderer::create_timestamp_queries() {
     assert(vkdevice->get_device());
-    assert(swapchain->get_image_count() > 0);
 
-    spdlog::debug("Allocating command buffers.");
-    spdlog::debug("Number of images in swapchain: {}.", swapchain->get_image_count());
+    std::uint32_t queue_family_count = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(vkdevice->get_physical_device(), &queue_family_count, nullptr);
+
+    std::vector<VkQueueFamilyProperties> queue_families(queue_family_count);
+    vkGetPhysicalDeviceQueueFamilyProperties(vkdevice->get_physical_device(), &queue_family_count,
+                                             queue_families.data());
 
-    for (std::size_t i = 0; i < swapchain->get_image_count(); i++) {
-        command_buffers.emplace_back(vkdevice->get_device(), command_pool->get());
+    if (queue_families[vkdevice->get_graphics_queue_family_index()].timestampValidBits == 0) {
+        spdlog::warn("The graphics queue does not support timestamps, GPU frame times will not be available!");
+        return VK_SUCCESS;
     }
 
-    return VK_SUCCESS;
-}
+    VkPhysicalDeviceProperties graphics_card_properties;
+    vkGetPhysicalDeviceProperties(vkdevice->get_physical_device(), &graphics_card_properties);
 
-VkResult VulkanRenderer::record_command_buffers() {
-    assert(window->get_width() > 0);
-    assert(window->get_height() > 0);
+    timestamp_period = graphics_card_properties.limits.timestampPeriod;
 
-    spdlog::debug("Recording command buffers.");
+    VkQueryPoolCreateInfo query_pool_ci = {};
+    query_pool_ci.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+    query_pool_ci.queryType = VK_QUERY_TYPE_TIMESTAMP;
+    query_pool_ci.queryCount = 2 * MAX_FRAMES_IN_FLIGHT;
 
-    VkCommandBufferBeginInfo command_buffer_bi = {};
-    command_buffer_bi.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
-    command_buffer_bi.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
-    command_buffer_bi.pInheritanceInfo = nullptr;
+    spdlog::debug("Creating timestamp query pool with {} queries.", query_pool_ci.queryCount);
 
-    // TODO: Setup clear colors by TOML configuration file.
-    std::array<VkClearValue, 3> clear_values;
+    return vkCreateQueryPool(vkdevice->get_device(), &query_pool_ci, nullptr, &timestamp_query_pool);
+}
 
-    // Note that the order of clear_values must be identical to the order of the attachments.
-    if (multisampling_enabled) {
-        clear_values[0].color = {{0.0f, 0.0f, 0.0f, 1.0f}};
-        clear_values[1].color = {{0.0f, 0.0f, 0.0f, 1.0f}};
-        clear_values[2].depthStencil = {1.0f, 0};
-    } else {
-        clear_values[0].color = {{0.0f, 0.0f, 0.0f, 1.0f}};
-        clear_values[1].depthStencil = {1.0f, 0};
+std::optional<double> VulkanRenderer::get_gpu_frame_time(const std::uint32_t command_buffer_index) const {
+    if (timestamp_query_pool == VK_NULL_HANDLE) {
+        return std::nullopt;
     }
 
-    VkExtent2D render_area;
-    render_area.width = window->get_width();
-    render_area.height = window->get_height();
+    std::array<std::uint64_t, 2> timestamps{};
 
-    VkRenderPassBeginInfo render_pass_bi = {};
-    render_pass_bi.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
-    render_pass_bi.renderPass = renderpass->get();
-    render_pass_bi.renderArea.offset = {0, 0};
-    render_pass_bi.renderArea.extent = render_area;
-    render_pass_bi.clearValueCount = static_cast<std::uint32_t>(clear_values.size());
-    render_pass_bi.pClearValues = clear_values.data();
+    if (vkGetQueryPoolResults(vkdevice->get_device(), timestamp_query_pool, 2 * command_buffer_index, 2,
+                              sizeof(timestamps), timestamps.data(), sizeof(std::uint64_t),
+                              VK_QUERY_RESULT_64_BIT) != VK_SUCCESS) {
+        return std::nullopt;
+    }
 
-    VkViewport viewport{};
+    return static_cast<double>(timestamps[1] - timestamps[0]) * timestamp_period / 1000000.0;
+}
 
-    viewport.width = static_cast<float>(window->get_width());
-    viewport.height = static_cast<float>(window->get_height());
-    viewport.minDepth = 0.0f;
-    viewport.maxDepth = 1.0f;
+VkResult VulkanRenderer::create_uniform_buffers() {
+    assert(vkdevice->get_device());
+    assert(vma->get_allocator());
 
-    VkRect2D scissor{};
+    VkPhysicalDeviceProperties graphics_card_properties;
+    vkGetPhysicalDeviceProperties(vkdevice->get_physical_device(), &graphics_card_properties);
 
-    scissor.extent.width = window->get_width();
-    scissor.extent.height = window->get_height();
+    // Dynamic offsets must be multiples of this alignment.
+    const VkDeviceSize alignment = graphics_card_properties.limits.minUniformBufferOffsetAlignment;
 
-    for (std::size_t i = 0; i < swapchain->get_image_count(); i++) {
-        spdlog::debug("Recording command buffer #{}.", i);
+    uniform_ring_buffer = std::make_unique<wrapper::UniformRingBuffer>(
+        vkdevice->get_device(), vma->get_allocator(), "uniform ring buffer", UNIFORM_RING_BUFFER_FRAME_SIZE,
+        MAX_FRAMES_IN_FLIGHT, std::max<VkDeviceSize>(alignment, 1));
 
-        VkCommandBuffer current_command_buffer = command_buffers[i].get();
+    return VK_SUCCESS;
+}
 
-        // TODO: Start debug marker region.
+VkResult VulkanRenderer::create_command_buffers() {
+    assert(vkdevice->get_device());
+    assert(thread_pool);
 
-        VkResult result = vkBeginCommandBuffer(current_command_buffer, &command_buffer_bi);
-        if (VK_SUCCESS != result)
-            return result;
+    spdlog::debug("Allocating command buffers.");
+    spdlog::debug("Number of frames in flight: {}.", MAX_FRAMES_IN_FLIGHT);
 
-        // Update only the necessary parts of VkRenderPassBeginInfo.
-        render_pass_bi.framebuffer = framebuffer->get(i);
+    command_buffers.clear();
+    command_pools.clear();
+    command_pools.reserve(MAX_FRAMES_IN_FLIGHT);
 
-        vkCmdBeginRenderPass(current_command_buffer, &render_pass_bi, VK_SUBPASS_CONTENTS_INLINE);
+    for (std::size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+        command_pools.emplace_back(vkdevice->get_device(), vkdevice->get_graphics_queue_family_index());
+        command_buffers.emplace_back(vkdevice->get_device(), command_pools.back().get());
+    }
 
-        // ----------------------------------------------------------------------------------------------------------------
-        // Begin of render pass.
-        {
-            vkCmdSetViewport(current_command_buffer, 0, 1, &viewport);
+    octree_recorder =
+        std::make_unique<ParallelCommandRecorder>(vkdevice->get_device(), vkdevice->get_graphics_queue_family_index(),
+                                                  thread_pool, MAX_FRAMES_IN_FLIGHT, recording_thread_count);
 
-            vkCmdSetScissor(current_command_buffer, 0, 1, &scissor);
+    return VK_SUCCESS;
+}
 
-            // TODO: Render skybox!
+VkResult VulkanRenderer::record_command_buffer(const std::uint32_t frame_index, const std::uint32_t image_index) {
+    assert(frame_index < command_buffers.size());
+    assert(image_index < get_render_target_count());
 
-            vkCmdBindPipeline(current_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphics_pipeline->get());
+    // The fence of this frame has been signaled, so none of its command buffers or uniform data are in use anymore.
+    VkResult result = vkResetCommandPool(vkdevice->get_device(), command_pools[frame_index].get(), 0);
+    if (VK_SUCCESS != result)
+        return result;
 
-            vkCmdBindDescriptorSets(current_command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout->get(), 0,
-                                    1, descriptors[0].get_descriptor_sets_data(), 0, nullptr);
+    octree_recorder->begin_frame(frame_index);
 
-            VkBuffer vertexBuffers[] = {mesh_buffers[0].get_vertex_buffer()};
-            VkDeviceSize offsets[] = {0};
-            vkCmdBindVertexBuffers(current_command_buffer, 0, 1, vertexBuffers, offsets);
+    // The descriptor sets which were allocated for the previous use of this frame in flight are freed at once.
+    frame_descriptor_allocators[frame_index]->reset();
 
-            vkCmdDraw(current_command_buffer, mesh_buffers[0].get_vertex_count(), 1, 0, 0);
+    // The draw commands of the chunks are copied into the region of this frame in flight, unless the chunk culler
+    // writes them on the device.
+    if (indirect_drawing_enabled) {
+        chunk_draw_buffer->begin_frame(frame_index);
 
-            // TODO: This does not specify the order of rendering!
-            // gltf_model_manager->render_all_models(command_buffers[i], pipeline_layout, i);
+        if (chunk_culler) {
+            chunk_culling_stats = chunk_culler->read_stats(frame_index, *chunk_draw_buffer);
+        } else {
+            const auto &chunk_draw_commands = chunk_meshes->get_draw_commands();
 
-            // TODO: Draw imgui user interface.
+            chunk_draw_buffer->write(chunk_draw_commands.data(),
+                                     static_cast<std::uint32_t>(chunk_draw_commands.size()));
+            chunk_draw_buffer->flush();
         }
-        // End of render pass.
-        // ----------------------------------------------------------------------------------------------------------------
+    }
 
-        vkCmdEndRenderPass(current_command_buffer);
+    VkCommandBufferBeginInfo command_buffer_bi = {};
+    command_buffer_bi.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    command_buffer_bi.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    command_buffer_bi.pInheritanceInfo = nullptr;
+
+    VkCommandBuffer current_command_buffer = command_buffers[frame_index].get();
+
+    // TODO: Start debug marker region.
+
+    result = vkBeginCommandBuffer(current_command_buffer, &command_buffer_bi);
+    if (VK_SUCCESS != result)
+        return result;
 
-        result = vkEndCommandBuffer(current_command_buffer);
-        if (VK_SUCCESS != result)
-            return result;
+    // Take over the resources which have been uploaded on the data transfer queue since the last frame.
+    upload_manager->record_acquire_barriers(current_command_buffer);
 
-        // TODO: End debug marker region
+    if (timestamp_query_pool != VK_NULL_HANDLE) {
+        vkCmdResetQueryPool(current_command_buffer, timestamp_query_pool, 2 * frame_index, 2);
+        vkCmdWriteTimestamp(current_command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, timestamp_query_pool,
+                            2 * frame_index);
     }
 
-    return VK_SUCCESS;
+    if (chunk_culler) {
+        chunk_culler->record_culling(current_command_buffer, frame_index, *frame_descriptor_allocators[frame_index],
+                                     *uniform_ring_buffer, *chunk_meshes, *chunk_draw_buffer,
+                                     view_projection * octree_model_matrix);
+    }
+
+    // The render graph records the render passes of all stages and the barriers in between.
+    render_graph->record(current_command_buffer, image_index);
+
+    // The depth buffer of this frame is used to cull the chunks of the next frame.
+    if (chunk_culler && chunk_culler->is_occlusion_culling_enabled()) {
+        chunk_culler->record_depth_pyramid(current_command_buffer, *frame_descriptor_allocators[frame_index],
+                                           render_graph->get_exported_image_view(depth_buffer));
+    }
+
+    if (timestamp_query_pool != VK_NULL_HANDLE) {
+        vkCmdWriteTimestamp(current_command_buffer, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, timestamp_query_pool,
+                            2 * frame_index + 1);
+    }
+
+    // TODO: End debug marker region
+
+    // The uniform data of the frame has been allocated before recording.
+    uniform_ring_buffer->flush();
+
+    return vkEndCommandBuffer(current_command_buffer);
 }
 
 VkResult VulkanRenderer::create_synchronisation_objects() {
-    assert(swapchain->get_image_count() > 0);
+    assert(get_render_target_count() > 0);
 
     spdlog::debug("Creating synchronisation objects: semaphores and fences.");
-    spdlog::debug("Number of images in swapchain: {}.", swapchain->get_image_count());
+    spdlog::debug("Number of render targets: {}.", get_render_target_count());
 
     in_flight_fences.clear();
     image_available_semaphores.clear();
@@ -193,24 +279,11 @@ VkResult VulkanRenderer::cleanup_swapchain() {
 
     spdlog::debug("Device is idle.");
 
-    framebuffer.reset();
-
-    depth_buffer.reset();
-
-    depth_stencil.reset();
-
-    if (multisampling_enabled) {
-        msaa_target_buffer.color.reset();
-        msaa_target_buffer.depth.reset();
-    }
-
-    command_buffers.clear();
-
     graphics_pipeline.reset();
 
     pipeline_layout.reset();
 
-    renderpass.reset();
+    render_graph.reset();
 
     return VK_SUCCESS;
 }
@@ -225,47 +298,53 @@ VkResult VulkanRenderer::update_cameras() {
 VkResult VulkanRenderer::recreate_swapchain() {
     assert(vkdevice->get_device());
 
-    vkDeviceWaitIdle(vkdevice->get_device());
+    const auto recreation_start = std::chrono::steady_clock::now();
 
-    // TODO: outsource cleanup_swapchain() methods!
+    // In headless mode, the size of the offscreen images never changes.
+    if (!headless) {
+        spdlog::debug("Querying new window size.");
 
-    spdlog::debug("Querying new window size.");
+        window->update_size();
 
-    window->wait_for_focus();
+        // A minimized window has no size, so there is nothing to render into. Instead of blocking until the window
+        // is restored, the recreation is tried again in the next frame.
+        if (window->get_width() == 0 || window->get_height() == 0) {
+            if (!swapchain_recreation_pending) {
+                spdlog::debug("Window is minimized, postponing swapchain recreation.");
+            }
+            swapchain_recreation_pending = true;
+            return VK_SUCCESS;
+        }
 
-    window_width = window->get_width();
-    window_height = window->get_height();
+        window_width = window->get_width();
+        window_height = window->get_height();
 
-    spdlog::debug("New window size: width: {}, height: {}.", window_width, window_height);
+        spdlog::debug("New window size: width: {}, height: {}.", window_width, window_height);
 
-    swapchain->recreate(window_width, window_height);
+        swapchain->recreate(window_width, window_height, deletion_queue);
+    }
 
-    depth_buffer.reset();
+    swapchain_recreation_pending = false;
 
-    depth_stencil.reset();
+    // The render passes stay valid, only the attachments depend on the size and the images of the render targets.
+    render_graph->create_physical_resources(get_render_extent(), get_render_target_images(),
+                                            get_render_target_views(), deletion_queue);
 
-    if (multisampling_enabled) {
-        msaa_target_buffer.color.reset();
-        msaa_target_buffer.depth.reset();
+    if (chunk_culler) {
+        chunk_culler->resize(get_render_extent(), deletion_queue);
     }
 
-    framebuffer.reset();
-
-    VkResult result = create_depth_buffer();
-    vulkan_error_check(result);
+    // The latency a window resize adds to the frame. No pipelines are created and the device is not waited for.
+    const std::chrono::duration<double, std::milli> recreation_time =
+        std::chrono::steady_clock::now() - recreation_start;
 
-    result = create_frame_buffers();
-    vulkan_error_check(result);
-
-    vkDeviceWaitIdle(vkdevice->get_device());
+    spdlog::debug("Recreated swapchain and render targets in {:.3f} ms.", recreation_time.count());
 
     // Calculate the new aspect ratio so we can update game camera matrices.
     float aspect_ratio = window_width / static_cast<float>(window_height);
 
     spdlog::debug("New aspect ratio: {}.", aspect_ratio);
 
-    vkDeviceWaitIdle(vkdevice->get_device());
-
     // Setup game camera.
     game_camera.type = Camera::CameraType::LOOKAT;
 
@@ -275,80 +354,68 @@ VkResult VulkanRenderer::recreate_swapchain() {
     game_camera.set_position({0.0f, 0.0f, 5.0f});
     game_camera.set_rotation({0.0f, 0.0f, 0.0f});
 
-    result = record_command_buffers();
-    vulkan_error_check(result);
-
-    vkDeviceWaitIdle(vkdevice->get_device());
-
     return VK_SUCCESS;
 }
 
-VkResult VulkanRenderer::create_descriptor_pool() {
-    descriptors.emplace_back(vkdevice->get_device(), swapchain->get_image_count(), std::string("unnamed descriptor"));
+VkResult VulkanRenderer::create_descriptor_allocators() {
+    assert(vkdevice->get_device());
+
+    descriptor_layout_cache =
+        std::make_unique<wrapper::DescriptorLayoutCache>(vkdevice->get_device(), "Descriptor layout cache");
+
+    descriptor_allocator =
+        std::make_unique<wrapper::DescriptorAllocator>(vkdevice->get_device(), "Persistent descriptor allocator");
 
-    // Create the descriptor pool.
-    descriptors[0].create_descriptor_pool(
-        {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER});
+    frame_descriptor_allocators.clear();
+
+    for (std::size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++) {
+        frame_descriptor_allocators.push_back(std::make_unique<wrapper::DescriptorAllocator>(
+            vkdevice->get_device(), "Frame descriptor allocator #" + std::to_string(i)));
+    }
 
     return VK_SUCCESS;
 }
 
 VkResult VulkanRenderer::create_descriptor_set_layouts() {
-    std::vector<VkDescriptorSetLayoutBinding> descriptor_set_layout_bindings(2);
+    // One dynamic uniform buffer for the pass data. The draw data is passed as push constants and the textures are
+    // bound separately.
+    std::vector<VkDescriptorSetLayoutBinding> descriptor_set_layout_bindings(1);
 
     descriptor_set_layout_bindings[0].binding = 0;
-    descriptor_set_layout_bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    descriptor_set_layout_bindings[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     descriptor_set_layout_bindings[0].descriptorCount = 1;
     descriptor_set_layout_bindings[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
     descriptor_set_layout_bindings[0].pImmutableSamplers = nullptr;
 
-    descriptor_set_layout_bindings[1].binding = 1;
-    descriptor_set_layout_bindings[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    descriptor_set_layout_bindings[1].descriptorCount = 1;
-    descriptor_set_layout_bindings[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
-    descriptor_set_layout_bindings[1].pImmutableSamplers = nullptr;
-
-    descriptors[0].create_descriptor_set_layouts(descriptor_set_layout_bindings);
+    uniform_descriptor_set_layout = descriptor_layout_cache->get(descriptor_set_layout_bindings);
 
     return VK_SUCCESS;
 }
 
-VkResult VulkanRenderer::create_descriptor_writes() {
-    assert(!textures.empty());
+VkResult VulkanRenderer::create_descriptor_sets() {
+    // The uniform data is selected by dynamic offsets, so one descriptor set serves all frames in flight.
+    uniform_descriptor_set = descriptor_allocator->allocate(uniform_descriptor_set_layout);
 
-    std::vector<VkWriteDescriptorSet> descriptor_writes(2);
+    std::vector<VkWriteDescriptorSet> descriptor_writes(1);
 
-    // Link the matrices uniform buffer to the descriptor set so the shader can access it.
+    // Link the uniform ring buffer to the descriptor set so the shader can access it. The binding points to the start
+    // of the ring buffer, the actual data is selected by the dynamic offset when the descriptor set is bound.
 
     // We can do better than this, but therefore RAII refactoring needs to be done..
-    uniform_buffer_info.buffer = uniform_buffers[0].get_buffer();
-    uniform_buffer_info.offset = 0;
-    uniform_buffer_info.range = sizeof(UniformBufferObject);
+    pass_uniform_buffer_info.buffer = uniform_ring_buffer->get_buffer();
+    pass_uniform_buffer_info.offset = 0;
+    pass_uniform_buffer_info.range = sizeof(PassUniformBufferObject);
 
     descriptor_writes[0].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    descriptor_writes[0].dstSet = nullptr;
+    descriptor_writes[0].dstSet = uniform_descriptor_set;
     descriptor_writes[0].dstBinding = 0;
     descriptor_writes[0].dstArrayElement = 0;
-    descriptor_writes[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+    descriptor_writes[0].descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
     descriptor_writes[0].descriptorCount = 1;
-    descriptor_writes[0].pBufferInfo = &uniform_buffer_info;
-
-    // Link the texture to the descriptor set so the shader can access it.
-    descriptor_image_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
-    descriptor_image_info.imageView = textures[0].get_image_view();
-    descriptor_image_info.sampler = textures[0].get_sampler();
-
-    descriptor_writes[1].sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-    descriptor_writes[1].dstSet = nullptr;
-    descriptor_writes[1].dstBinding = 1;
-    descriptor_writes[1].dstArrayElement = 0;
-    descriptor_writes[1].descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
-    descriptor_writes[1].descriptorCount = 1;
-    descriptor_writes[1].pImageInfo = &descriptor_image_info;
+    descriptor_writes[0].pBufferInfo = &pass_uniform_buffer_info;
 
-    descriptors[0].add_descriptor_writes(descriptor_writes);
-
-    descriptors[0].create_descriptor_sets();
+    vkUpdateDescriptorSets(vkdevice->get_device(), static_cast<std::uint32_t>(descriptor_writes.size()),
+                           descriptor_writes.data(), 0, nullptr);
 
     return VK_SUCCESS;
 }
@@ -364,199 +431,279 @@ VkResult VulkanRenderer::create_pipeline() {
 
     spdlog::debug("Setting up shader stages.");
 
+    // The size of the texture array depends on the graphics card, so it is passed to the shaders when the pipeline is
+    // created.
+    const std::uint32_t texture_array_size = texture_array->get_capacity();
+
+    VkSpecializationMapEntry texture_array_size_entry = {};
+    texture_array_size_entry.constantID = wrapper::BindlessTextureArray::TEXTURE_ARRAY_SIZE_CONSTANT_ID;
+    texture_array_size_entry.offset = 0;
+    texture_array_size_entry.size = sizeof(texture_array_size);
+
+    VkSpecializationInfo specialization_info = {};
+    specialization_info.mapEntryCount = 1;
+    specialization_info.pMapEntries = &texture_array_size_entry;
+    specialization_info.dataSize = sizeof(texture_array_size);
+    specialization_info.pData = &texture_array_size;
+
     // Loop through all shaders in Vulkan shader manager's list and add them to the setup.
     for (const auto &shader : shaders) {
         VkPipelineShaderStageCreateInfo shader_stage_ci = {};
         shader_stage_ci.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
         shader_stage_ci.stage = shader.get_type();
         shader_stage_ci.module = shader.get_module();
-        shader_stage_ci.pSpecializationInfo = nullptr;
+        shader_stage_ci.pSpecializationInfo = &specialization_info;
         shader_stage_ci.pName = shader.get_entry_point().c_str();
 
         shader_stages.push_back(shader_stage_ci);
     }
 
-    std::vector<VkAttachmentDescription> attachments;
+    const std::vector<VkDescriptorSetLayout> set_layouts = {uniform_descriptor_set_layout,
+                                                            texture_array->get_descriptor_set_layout()};
 
-    VkSubpassDescription subpass_description = {};
+    // If the pipeline is replaced at runtime, frames in flight might still use the previous one.
+    if (graphics_pipeline) {
+        deletion_queue.retire(std::move(graphics_pipeline));
+    }
+    if (pipeline_layout) {
+        deletion_queue.retire(std::move(pipeline_layout));
+    }
 
-    VkAttachmentReference color_reference = {};
-    color_reference.attachment = 0;
-    color_reference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    // The model matrix and the texture index of every draw.
+    std::vector<VkPushConstantRange> push_constant_ranges(1);
+    push_constant_ranges[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+    push_constant_ranges[0].offset = 0;
+    push_constant_ranges[0].size = sizeof(DrawPushConstants);
 
-    VkAttachmentReference resolve_reference = {};
-    resolve_reference.attachment = 1;
-    resolve_reference.layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    pipeline_layout = std::make_unique<wrapper::PipelineLayout>(vkdevice->get_device(), set_layouts,
+                                                                push_constant_ranges, "Default pipeline layout");
 
-    VkAttachmentReference depth_reference = {};
-    depth_reference.attachment = multisampling_enabled ? 2 : 1;
-    depth_reference.layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+    const auto vertex_binding_desc = OctreeVertex::get_vertex_binding_description();
+    const auto attribute_binding_desc = OctreeVertex::get_attribute_binding_description();
 
-    if (multisampling_enabled) {
-        spdlog::debug("Multisampling is enabled.");
+    const auto pipeline_creation_start = std::chrono::steady_clock::now();
 
-        attachments.resize(4);
-
-        // Multisampled attachment that we render to.
-        attachments[0].format = swapchain->get_image_format();
-        attachments[0].samples = multisampling_sample_count;
-        attachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-        attachments[0].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-        attachments[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        attachments[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        attachments[0].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        attachments[0].finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
-
-        // This is the frame buffer attachment to where the multisampled image
-        // will be resolved to and which will be presented to the swapchain.
-        attachments[1].format = swapchain->get_image_format();
-        attachments[1].samples = VK_SAMPLE_COUNT_1_BIT;
-        attachments[1].loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        attachments[1].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-        attachments[1].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        attachments[1].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        attachments[1].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        attachments[1].finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-
-        // Multisampled depth attachment we render to.
-        attachments[2].format = depth_buffer->get_image_format();
-        attachments[2].samples = multisampling_sample_count;
-        attachments[2].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-        attachments[2].storeOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        attachments[2].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        attachments[2].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        attachments[2].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        attachments[2].finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-
-        // Depth resolve attachment.
-        attachments[3].format = depth_buffer->get_image_format();
-        attachments[3].samples = VK_SAMPLE_COUNT_1_BIT;
-        attachments[3].loadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        attachments[3].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-        attachments[3].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        attachments[3].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        attachments[3].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        attachments[3].finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-
-        subpass_description.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-        subpass_description.colorAttachmentCount = 1;
-        subpass_description.pColorAttachments = &color_reference;
-        subpass_description.pResolveAttachments = &resolve_reference;
-        subpass_description.pDepthStencilAttachment = &depth_reference;
-    } else {
-        spdlog::debug("Multisampling is disabled.");
+    graphics_pipeline = std::make_unique<wrapper::GraphicsPipeline>(
+        vkdevice->get_device(), pipeline_cache->get(), pipeline_layout->get(),
+        render_graph->get_render_pass(octree_stage), shader_stages, vertex_binding_desc, attribute_binding_desc,
+        multisampling_enabled, "Default graphics pipeline");
 
-        attachments.resize(2);
-
-        // Color attachment.
-        attachments[0].format = swapchain->get_image_format();
-        attachments[0].samples = VK_SAMPLE_COUNT_1_BIT;
-        attachments[0].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-        attachments[0].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-        attachments[0].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
-        attachments[0].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        attachments[0].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        attachments[0].finalLayout = VK_IMAGE_LAYOUT_PRESENT_SRC_KHR;
-
-        // Depth attachment.
-        attachments[1].format = depth_buffer->get_image_format();
-        attachments[1].samples = VK_SAMPLE_COUNT_1_BIT;
-        attachments[1].loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-        attachments[1].storeOp = VK_ATTACHMENT_STORE_OP_STORE;
-        attachments[1].stencilLoadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
-        attachments[1].stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-        attachments[1].initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
-        attachments[1].finalLayout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
-
-        subpass_description.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
-        subpass_description.colorAttachmentCount = 1;
-        subpass_description.pColorAttachments = &color_reference;
-        subpass_description.pDepthStencilAttachment = &depth_reference;
-        subpass_description.inputAttachmentCount = 0;
-        subpass_description.pInputAttachments = nullptr;
-        subpass_description.preserveAttachmentCount = 0;
-        subpass_description.pPreserveAttachments = nullptr;
-        subpass_description.pResolveAttachments = nullptr;
-    }
-
-    std::vector<VkSubpassDependency> dependencies(2);
-
-    // Subpass dependencies for layout transitions.
-    dependencies[0].srcSubpass = VK_SUBPASS_EXTERNAL;
-    dependencies[0].dstSubpass = 0;
-    dependencies[0].dstStageMask = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-    dependencies[0].srcStageMask = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-    dependencies[0].dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-    dependencies[0].srcAccessMask = VK_ACCESS_MEMORY_READ_BIT;
-    dependencies[0].dependencyFlags = VK_DEPENDENCY_BY_REGION_BIT;
-
-    dependencies[1] = dependencies[0];
-
-    renderpass = std::make_unique<wrapper::RenderPass>(vkdevice->get_device(), attachments, dependencies,
-                                                       subpass_description, "Default renderpass");
-
-    const std::vector<VkDescriptorSetLayout> set_layouts = {descriptors[0].get_descriptor_set_layout()};
-
-    pipeline_layout =
-        std::make_unique<wrapper::PipelineLayout>(vkdevice->get_device(), set_layouts, "Default pipeline layout");
+    const std::chrono::duration<double, std::milli> pipeline_creation_time =
+        std::chrono::steady_clock::now() - pipeline_creation_start;
 
-    const auto vertex_binding_desc = OctreeVertex::get_vertex_binding_description();
-    const auto attribute_binding_desc = OctreeVertex::get_attribute_binding_description();
+    spdlog::debug("Created graphics pipeline in {:.3f} ms.", pipeline_creation_time.count());
 
-    graphics_pipeline = std::make_unique<wrapper::GraphicsPipeline>(
-        vkdevice->get_device(), pipeline_layout->get(), renderpass->get(), shader_stages, vertex_binding_desc,
-        attribute_binding_desc, window->get_width(), window->get_height(), multisampling_enabled,
-        "Default graphics pipeline");
+    return VK_SUCCESS;
+}
+
+VkResult VulkanRenderer::create_chunk_culler() {
+    assert(vkdevice->get_device());
+    assert(chunk_meshes);
+
+    if (!indirect_drawing_enabled || !gpu_culling_enabled) {
+        spdlog::debug("The chunks are not culled on the device.");
+        return VK_SUCCESS;
+    }
+
+    // The commands of the visible chunks can only be packed densely if the draw count is read from the buffer.
+    chunk_culler = std::make_unique<ChunkCuller>(
+        vkdevice->get_device(), vkdevice->get_physical_device(), vma->get_allocator(), pipeline_cache->get(),
+        *descriptor_layout_cache, chunk_draw_buffer->get_max_draw_count(), MAX_FRAMES_IN_FLIGHT,
+        draw_indirect_count_enabled, occlusion_culling_enabled, get_render_extent(),
+        multisampling_enabled ? multisampling_sample_count : VK_SAMPLE_COUNT_1_BIT);
 
     return VK_SUCCESS;
 }
 
-VkResult VulkanRenderer::create_frame_buffers() {
+const char *VulkanRenderer::get_chunk_draw_call_name() const {
+    if (!indirect_drawing_enabled) {
+        return "vkCmdDrawIndexed";
+    }
+    return draw_indirect_count_enabled ? "vkCmdDrawIndexedIndirectCountKHR" : "vkCmdDrawIndexedIndirect";
+}
+
+void VulkanRenderer::record_indirect_chunk_draws(const VkCommandBuffer command_buffer) const {
+    const VkBuffer draw_buffer = chunk_draw_buffer->get_buffer();
+    const std::uint32_t stride = wrapper::IndirectDrawBuffer::COMMAND_STRIDE;
+
+    if (draw_indirect_count_enabled) {
+        // The device reads the number of draws from the buffer, so the command buffer does not depend on it.
+        vkdevice->draw_indexed_indirect_count(command_buffer, draw_buffer, chunk_draw_buffer->get_command_offset(0),
+                                              draw_buffer, chunk_draw_buffer->get_count_offset(),
+                                              chunk_draw_buffer->get_max_draw_count(), stride);
+    } else if (vkdevice->is_multi_draw_indirect_enabled()) {
+        vkCmdDrawIndexedIndirect(command_buffer, draw_buffer, chunk_draw_buffer->get_command_offset(0),
+                                 chunk_draw_buffer->get_draw_count(), stride);
+    } else {
+        // Without the multiDrawIndirect feature, every indirect draw call can only issue one draw.
+        for (std::uint32_t draw = 0; draw < chunk_draw_buffer->get_draw_count(); draw++) {
+            vkCmdDrawIndexedIndirect(command_buffer, draw_buffer, chunk_draw_buffer->get_command_offset(draw), 1,
+                                     stride);
+        }
+    }
+}
+
+VkResult VulkanRenderer::setup_render_graph() {
     assert(vkdevice->get_device());
-    assert(window->get_width() > 0);
-    assert(window->get_height() > 0);
-    assert(swapchain->get_image_count() > 0);
+    assert(vma->get_allocator());
+    assert(get_render_target_count() > 0);
+
+    const std::vector<VkFormat> supported_depth_formats = {VK_FORMAT_D32_SFLOAT_S8_UINT, VK_FORMAT_D32_SFLOAT,
+                                                           VK_FORMAT_D24_UNORM_S8_UINT, VK_FORMAT_D16_UNORM_S8_UINT,
+                                                           VK_FORMAT_D16_UNORM};
+
+    // The chunk culler builds its depth pyramid from the depth buffer, so compute shaders have to sample it.
+    bool depth_buffer_exported = indirect_drawing_enabled && gpu_culling_enabled && occlusion_culling_enabled;
+
+    if (depth_buffer_exported && multisampling_enabled) {
+        VkPhysicalDeviceProperties graphics_card_properties;
+        vkGetPhysicalDeviceProperties(vkdevice->get_physical_device(), &graphics_card_properties);
 
-    // Create depth stencil buffer.
-    depth_stencil = std::make_unique<wrapper::Image>(
-        vkdevice->get_device(), vkdevice->get_physical_device(), vma->get_allocator(), depth_buffer->get_image_format(),
-        VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT,
-        VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT, VK_SAMPLE_COUNT_1_BIT, "Depth stencil image",
-        swapchain->get_extent());
+        if ((graphics_card_properties.limits.sampledImageDepthSampleCounts & multisampling_sample_count) == 0) {
+            spdlog::warn("The selected graphics card can not sample multisampled depth buffers, occlusion culling is "
+                         "disabled!");
+            depth_buffer_exported = false;
+        }
+    }
+
+    std::optional<VkFormat> depth_buffer_format_candidate;
 
-    std::vector<VkImageView> attachments(multisampling_enabled ? 4 : 2, nullptr);
+    if (depth_buffer_exported) {
+        depth_buffer_format_candidate = settings_decision_maker->find_depth_buffer_format(
+            vkdevice->get_physical_device(), supported_depth_formats, VK_IMAGE_TILING_OPTIMAL,
+            VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT);
+
+        if (!depth_buffer_format_candidate) {
+            spdlog::warn("Could not find a depth buffer format which can be sampled, occlusion culling is disabled!");
+            depth_buffer_exported = false;
+        }
+    }
+
+    if (!depth_buffer_exported) {
+        occlusion_culling_enabled = false;
+
+        depth_buffer_format_candidate = settings_decision_maker->find_depth_buffer_format(
+            vkdevice->get_physical_device(), supported_depth_formats, VK_IMAGE_TILING_OPTIMAL,
+            VK_FORMAT_FEATURE_DEPTH_STENCIL_ATTACHMENT_BIT);
+    }
+
+    if (!depth_buffer_format_candidate) {
+        throw std::runtime_error("Error: Could not find appropriate image format for depth buffer!");
+    }
+
+    spdlog::debug("Setting up render graph.");
+
+    render_graph = std::make_unique<RenderGraph>(vkdevice->get_device(), vma->get_allocator());
+
+    back_buffer = render_graph->add<TextureResource>("Back buffer", TextureUsage::BACK_BUFFER);
+    back_buffer->set_format(get_color_format());
+
+    depth_buffer = render_graph->add<TextureResource>("Depth buffer", TextureUsage::DEPTH_STENCIL);
+    depth_buffer->set_format(depth_buffer_format_candidate.value());
+    depth_buffer->set_exported(depth_buffer_exported);
+
+    // TODO: Setup clear colors by TOML configuration file.
+    VkClearValue clear_color = {};
+    clear_color.color = {{0.0f, 0.0f, 0.0f, 1.0f}};
+
+    VkClearValue clear_depth = {};
+    clear_depth.depthStencil = {1.0f, 0};
+
+    octree_stage = render_graph->add<RenderStage>("Octree stage");
 
     if (multisampling_enabled) {
-        // Check if device supports requested sample count for color and depth frame buffer
-        // assert((deviceProperties.limits.framebufferColorSampleCounts >= sampleCount) &&
-        // (deviceProperties.limits.framebufferDepthSampleCounts >= sampleCount));
-
-        // Create color buffer for MSAA target.
-        msaa_target_buffer.color = std::make_unique<wrapper::Image>(
-            vkdevice->get_device(), vkdevice->get_physical_device(), vma->get_allocator(),
-            swapchain->get_image_format(),
-            VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, VK_IMAGE_ASPECT_COLOR_BIT,
-            multisampling_sample_count, "MSAA color image", swapchain->get_extent());
-
-        // Create depth buffer for MSAA target.
-        msaa_target_buffer.depth = std::make_unique<wrapper::Image>(
-            vkdevice->get_device(), vkdevice->get_physical_device(), vma->get_allocator(),
-            depth_buffer->get_image_format(),
-            VK_IMAGE_USAGE_TRANSIENT_ATTACHMENT_BIT | VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT,
-            VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT, multisampling_sample_count, "MSAA depth image",
-            swapchain->get_extent());
-
-        attachments[0] = msaa_target_buffer.color->get_image_view();
-        attachments[2] = msaa_target_buffer.depth->get_image_view();
-        attachments[3] = depth_stencil->get_image_view();
+        spdlog::debug("Multisampling is enabled.");
+
+        // Render into a multisampled color buffer which is resolved into the back buffer.
+        auto *msaa_color_buffer = render_graph->add<TextureResource>("MSAA color buffer", TextureUsage::COLOR);
+        msaa_color_buffer->set_format(get_color_format());
+        msaa_color_buffer->set_sample_count(multisampling_sample_count);
+
+        depth_buffer->set_sample_count(multisampling_sample_count);
+
+        octree_stage->writes_to(msaa_color_buffer, clear_color);
+        octree_stage->resolves_to(msaa_color_buffer, back_buffer);
     } else {
-        attachments[1] = depth_stencil->get_image_view();
+        spdlog::debug("Multisampling is disabled.");
+
+        octree_stage->writes_to(back_buffer, clear_color);
     }
 
-    // Create frames for frame buffer.
-    framebuffer = std::make_unique<wrapper::Framebuffer>(
-        vkdevice->get_device(), renderpass->get(), attachments, swapchain->get_image_views(), window->get_width(),
-        window->get_height(), swapchain->get_image_count(), multisampling_enabled, "Standard framebuffer");
+    octree_stage->writes_to(depth_buffer, clear_depth);
+
+    // The draws of the octree stage are recorded into secondary command buffers on several threads. Recording indirect
+    // draw calls takes the same time no matter how many chunks they draw, so they are recorded on one thread.
+    octree_stage->set_on_record_secondary([this](const VkCommandBufferInheritanceInfo &inheritance_info) {
+        return octree_recorder->record(
+            inheritance_info, indirect_drawing_enabled ? 1 : chunk_meshes->get_chunk_count(),
+            [this](const VkCommandBuffer command_buffer, const std::uint32_t first_draw,
+                   const std::uint32_t draw_count) {
+                const VkExtent2D render_area = get_render_extent();
+
+                VkViewport viewport{};
+                viewport.width = static_cast<float>(render_area.width);
+                viewport.height = static_cast<float>(render_area.height);
+                viewport.minDepth = 0.0f;
+                viewport.maxDepth = 1.0f;
+
+                VkRect2D scissor{};
+                scissor.extent = render_area;
+
+                vkCmdSetViewport(command_buffer, 0, 1, &viewport);
+
+                vkCmdSetScissor(command_buffer, 0, 1, &scissor);
+
+                // TODO: Render skybox!
+
+                vkCmdBindPipeline(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, graphics_pipeline->get());
+
+                // All chunks are drawn from the same vertex buffer and index buffer.
+                const VkBuffer vertex_buffer = chunk_meshes->get_vertex_buffer();
+                const VkDeviceSize vertex_buffer_offset = 0;
+                vkCmdBindVertexBuffers(command_buffer, 0, 1, &vertex_buffer, &vertex_buffer_offset);
+                vkCmdBindIndexBuffer(command_buffer, chunk_meshes->get_index_buffer(), 0,
+                                     wrapper::ChunkMeshBuffer::INDEX_TYPE);
+
+                // The pass data and the texture array are bound once, the draws only push their own data.
+                const std::array<VkDescriptorSet, 2> descriptor_sets = {uniform_descriptor_set,
+                                                                        texture_array->get_descriptor_set()};
+                vkCmdBindDescriptorSets(command_buffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline_layout->get(), 0,
+                                        static_cast<std::uint32_t>(descriptor_sets.size()), descriptor_sets.data(), 1,
+                                        &pass_uniform_offset);
+
+                // All chunks share the model matrix and the texture of the octree.
+                DrawPushConstants draw_push_constants = {};
+                draw_push_constants.model = octree_model_matrix;
+                draw_push_constants.texture_index = octree_texture_index;
+
+                vkCmdPushConstants(command_buffer, pipeline_layout->get(), VK_SHADER_STAGE_VERTEX_BIT, 0,
+                                   sizeof(draw_push_constants), &draw_push_constants);
+
+                if (indirect_drawing_enabled) {
+                    record_indirect_chunk_draws(command_buffer);
+                } else {
+                    const auto &chunk_draw_commands = chunk_meshes->get_draw_commands();
+
+                    for (std::uint32_t draw = first_draw; draw < first_draw + draw_count; draw++) {
+                        const auto &command = chunk_draw_commands[draw];
+                        vkCmdDrawIndexed(command_buffer, command.indexCount, command.instanceCount, command.firstIndex,
+                                         command.vertexOffset, command.firstInstance);
+                    }
+                }
+
+                // TODO: This does not specify the order of rendering!
+                // gltf_model_manager->render_all_models(command_buffers[i], pipeline_layout, i);
+
+                // TODO: Draw imgui user interface.
+            });
+    });
+
+    // Offscreen images are not presented, but they can be copied from after rendering.
+    render_graph->compile(back_buffer,
+                          headless ? VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL : VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+
+    render_graph->create_physical_resources(get_render_extent(), get_render_target_images(),
+                                            get_render_target_views(), deletion_queue);
 
     return VK_SUCCESS;
 }
@@ -644,22 +791,53 @@ VkResult VulkanRenderer::shutdown_vulkan() {
 
     cleanup_swapchain();
 
+    // The device is idle after cleanup_swapchain(), so the remaining objects can be destroyed right away.
+    deletion_queue.flush();
+
+    chunk_culler.reset();
+
+    // The pipelines have been destroyed, so the cache contains everything that has been compiled during this run.
+    if (pipeline_cache) {
+        pipeline_cache->save();
+        pipeline_cache.reset();
+    }
+
     // @todo: (yeetari) Remove once this class is RAII-ified.
     shaders.clear();
+    texture_array.reset();
     textures.clear();
-    uniform_buffers.clear();
+    uniform_ring_buffer.reset();
+    chunk_draw_buffer.reset();
+    chunk_meshes.reset();
     mesh_buffers.clear();
-    descriptors.clear();
+    frame_descriptor_allocators.clear();
+    descriptor_allocator.reset();
+    descriptor_layout_cache.reset();
+
+    fence_waiter.reset();
+
+    // This waits for the uploads which are still in flight before their staging buffers are destroyed.
+    upload_manager.reset();
 
     image_available_semaphores.clear();
     rendering_finished_semaphores.clear();
 
     in_flight_fences.clear();
 
+    if (timestamp_query_pool != VK_NULL_HANDLE) {
+        vkDestroyQueryPool(vkdevice->get_device(), timestamp_query_pool, nullptr);
+        timestamp_query_pool = VK_NULL_HANDLE;
+    }
+
+    offscreen_images.clear();
+
     vma.reset();
 
+    command_buffers.clear();
+    octree_recorder.reset();
+
     // @todo: (Hanni) Remove them once this class is RAII-ified.
-    command_pool.reset();
+    command_pools.clear();
     swapchain.reset();
     surface.reset();
     vkdevice.reset();
@@ -13,7 +13,6 @@ std::uint32_t
 VulkanSettingsDecisionMaker::decide_how_many_images_in_swapchain_to_use(const VkPhysicalDevice &graphics_card,
                                                                         const VkSurfaceKHR &surface) {
     assert(graphics_card);
-    assert(surface);
 
     spdlog::debug("Deciding automatically how many images in swapchain to use.");
 
@@ -135,6 +134,18 @@ bool VulkanSettingsDecisionMaker::is_graphics_card_suitable(const VkPhysicalDevi
 
     spdlog::debug("Checking suitability of graphics card: {}.", graphics_card_properties.deviceName);
 
+    // The fragment shader indexes the texture array with the texture index of the draw.
+    if (graphics_card_features.shaderSampledImageArrayDynamicIndexing != VK_TRUE) {
+        spdlog::debug("This device is not suitable because it does not support indexing arrays of sampled images!");
+        return false;
+    }
+
+    // Headless rendering neither needs a swapchain nor presentation support.
+    if (surface == VK_NULL_HANDLE) {
+        spdlog::debug("No surface specified, skipping swapchain and presentation checks.");
+        return true;
+    }
+
     // Step 1: Check if swapchain is supported.
     // In theory we could have used the code from VulkanAvailabilityChecks, but I didn't want
     // VulkanSettingsDecisionMaker to have a dependency just because of this one code part here.
@@ -240,7 +251,6 @@ std::optional<VkPhysicalDevice> VulkanSettingsDecisionMaker::decide_which_graphi
     const VkInstance &vulkan_instance, const VkSurfaceKHR &surface,
     const std::optional<std::uint32_t> &preferred_graphics_card_index) {
     assert(vulkan_instance);
-    assert(surface);
 
     // Do not assert preferred_graphics_card_index because this classifies as runtime error!
 
@@ -0,0 +1,71 @@
+#include "inexor/vulkan-renderer/task.hpp"
+
+#include "inexor/vulkan-renderer/tools/file.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace inexor::vulkan_renderer {
+
+FenceWaiter::~FenceWaiter() {
+    if (!pending_fences.empty()) {
+        spdlog::error("Error: {} coroutines are still waiting for a fence!", pending_fences.size());
+    }
+}
+
+void FenceWaiter::add(const VkDevice device, const VkFence fence, const TaskPriority priority, VkResult *result,
+                      std::coroutine_handle<> handle) {
+    assert(device);
+    assert(fence);
+    assert(result);
+
+    std::scoped_lock lock(pending_fences_mutex);
+    pending_fences.push_back({device, fence, priority, result, handle});
+}
+
+std::size_t FenceWaiter::update() {
+    std::vector<PendingFence> signaled_fences;
+    {
+        std::scoped_lock lock(pending_fences_mutex);
+
+        // Keep the fences which are not signaled yet and move the others out.
+        auto it = std::partition(pending_fences.begin(), pending_fences.end(), [](PendingFence &pending) {
+            *pending.result = vkGetFenceStatus(pending.device, pending.fence);
+            return *pending.result == VK_NOT_READY;
+        });
+
+        signaled_fences.assign(it, pending_fences.end());
+        pending_fences.erase(it, pending_fences.end());
+    }
+
+    for (const auto &signaled : signaled_fences) {
+        if (*signaled.result != VK_SUCCESS) {
+            spdlog::error("Error: vkGetFenceStatus failed while awaiting fence!");
+        }
+
+        // The returned future is not needed because the coroutine itself carries the result.
+        static_cast<void>(thread_pool.execute(signaled.priority, [handle = signaled.handle]() { handle.resume(); }));
+    }
+
+    return signaled_fences.size();
+}
+
+std::size_t FenceWaiter::get_pending_count() {
+    std::scoped_lock lock(pending_fences_mutex);
+    return pending_fences.size();
+}
+
+Task<std::vector<char>> read_file_async(ThreadPool &thread_pool, std::string file_name) {
+    co_await schedule_on(thread_pool, TaskPriority::BACKGROUND);
+
+    tools::File file;
+    if (!file.load_file(file_name)) {
+        throw std::runtime_error("Error: Could not load file " + file_name + "!");
+    }
+
+    co_return file.get_file_data();
+}
+
+} // namespace inexor::vulkan_renderer
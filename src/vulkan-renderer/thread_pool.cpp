@@ -1,8 +1,67 @@
 #include "inexor/vulkan-renderer/thread_pool.hpp"
 
+#include <algorithm>
+#include <cassert>
+
 namespace inexor {
 
-ThreadPool::ThreadPool(std::size_t thread_count) {
+void LatencyHistogram::record(const std::chrono::nanoseconds duration) {
+    const auto microseconds =
+        static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(duration).count());
+
+    // Bucket i contains durations in [2^(i-1), 2^i) microseconds.
+    std::size_t bucket_index = 0;
+    for (std::uint64_t value = microseconds; value > 0 && bucket_index < BUCKET_COUNT - 1; value >>= 1) {
+        bucket_index++;
+    }
+
+    buckets[bucket_index].fetch_add(1, std::memory_order_relaxed);
+    total_count.fetch_add(1, std::memory_order_relaxed);
+    total_microseconds.fetch_add(microseconds, std::memory_order_relaxed);
+
+    std::uint64_t previous_max = max_microseconds.load(std::memory_order_relaxed);
+    while (previous_max < microseconds &&
+           !max_microseconds.compare_exchange_weak(previous_max, microseconds, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::reset() {
+    for (auto &bucket : buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    total_count.store(0, std::memory_order_relaxed);
+    total_microseconds.store(0, std::memory_order_relaxed);
+    max_microseconds.store(0, std::memory_order_relaxed);
+}
+
+std::array<std::uint64_t, LatencyHistogram::BUCKET_COUNT> LatencyHistogram::get_buckets() const {
+    std::array<std::uint64_t, BUCKET_COUNT> result{};
+    for (std::size_t i = 0; i < BUCKET_COUNT; i++) {
+        result[i] = buckets[i].load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+std::chrono::microseconds LatencyHistogram::get_bucket_upper_bound(const std::size_t bucket_index) {
+    assert(bucket_index < BUCKET_COUNT);
+
+    if (bucket_index == BUCKET_COUNT - 1) {
+        return std::chrono::microseconds::max();
+    }
+    return std::chrono::microseconds(std::uint64_t(1) << bucket_index);
+}
+
+std::chrono::microseconds LatencyHistogram::get_average() const {
+    const std::uint64_t count = total_count.load(std::memory_order_relaxed);
+    if (count == 0) {
+        return std::chrono::microseconds(0);
+    }
+    return std::chrono::microseconds(total_microseconds.load(std::memory_order_relaxed) / count);
+}
+
+ThreadPool::ThreadPool(std::size_t thread_count, std::size_t low_latency_thread_count,
+                       const TaskQueueBackend backend, const std::size_t lock_free_capacity)
+    : backend(backend) {
     // Try to estimate the number of CPU cores available on the system.
     std::size_t number_of_cpu_cores = std::thread::hardware_concurrency();
 
@@ -35,8 +94,24 @@ ThreadPool::ThreadPool(std::size_t thread_count) {
         spdlog::warn("This might decrease performance as thread management overhead increases!");
     }
 
+    // At least one general purpose worker must remain, otherwise background tasks would never run.
+    if (low_latency_thread_count >= thread_count) {
+        spdlog::warn("Too many low-latency threads requested, using {} instead!", thread_count - 1);
+        low_latency_thread_count = thread_count - 1;
+    }
+
+    spdlog::debug("Reserving {} of {} threads for frame-critical tasks.", low_latency_thread_count, thread_count);
+
+    if (backend == TaskQueueBackend::LOCK_FREE) {
+        spdlog::debug("Using lock-free tasklists with a capacity of {} tasks.", lock_free_capacity);
+
+        for (auto &tasklist : lock_free_tasklists) {
+            tasklist = std::make_unique<MPMCQueue<std::unique_ptr<TaskContainerBase>>>(lock_free_capacity);
+        }
+    }
+
     for (std::size_t i = 0; i < thread_count; ++i) {
-        start_thread();
+        start_thread(i < low_latency_thread_count);
     }
 }
 
@@ -46,8 +121,14 @@ ThreadPool::~ThreadPool() {
     stop_threads = true;
 
     // Notify all worker threads about program stop.
+    {
+        // Taking the lock makes sure no worker misses the notification between checking its predicate and waiting.
+        std::lock_guard<std::mutex> queue_lock(tasklist_mutex);
+    }
     tasklist_cv.notify_all();
+    low_latency_cv.notify_all();
 
+    std::lock_guard<std::mutex> threads_lock(threads_mutex);
     for (std::thread &thread : threads) {
         thread.join();
     }
@@ -55,51 +136,234 @@ ThreadPool::~ThreadPool() {
     // spdlog::debug("All worker threads closed successfully.");
 }
 
-void ThreadPool::start_thread() {
-    // TODO: Do we need additional locks here?
-    // spdlog::debug("Starting new worker thread.");
+void ThreadPool::enqueue(const TaskPriority priority, std::unique_ptr<TaskContainerBase> task) {
+    assert(task);
 
-    // Start waiting for threads.
-    // Working threads listen for new tasks through ThreadPool's condition_variable.
-    threads.emplace_back(
+    if (instrumentation_enabled.load(std::memory_order_relaxed)) {
+        task->enqueue_time = std::chrono::steady_clock::now();
+        enqueued_tasks[static_cast<std::size_t>(priority)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (backend == TaskQueueBackend::LOCK_FREE) {
+        const auto index = static_cast<std::size_t>(priority);
+
+        // Count the task before pushing it, so the counter never drops below the actual number of tasks.
+        pending_tasks[index].fetch_add(1);
+
+        // The tasklist is bounded, so wait for the workers to catch up if it is full.
+        while (!lock_free_tasklists[index]->try_push(std::move(task))) {
+            std::this_thread::yield();
+        }
+
+        // Nobody needs to be woken up if all workers are busy.
+        if (sleeping_workers.load() == 0) {
+            return;
+        }
+
+        // Taking the lock makes sure no worker misses the notification between checking its predicate and waiting.
+        std::lock_guard<std::mutex> sleep_lock(tasklist_mutex);
+    } else {
+        std::lock_guard<std::mutex> queue_lock(tasklist_mutex);
+        tasklists[static_cast<std::size_t>(priority)].emplace(std::move(task));
+    }
+
+    // Frame-critical tasks can be picked by both kinds of workers, whichever wakes up first.
+    // The other worker will find the tasklist empty and go back to sleep.
+    if (priority == TaskPriority::FRAME_CRITICAL) {
+        low_latency_cv.notify_one();
+    }
+    tasklist_cv.notify_one();
+}
+
+void ThreadPool::set_instrumentation_enabled(const bool enabled) {
+    if (enabled && !instrumentation_enabled) {
+        reset_stats();
+    }
+    instrumentation_enabled = enabled;
+}
 
-        std::thread([&]() {
-            // Lock the queue so we can see which tasks are to ne done.
-            std::unique_lock<std::mutex> queue_lock(tasklist_mutex, std::defer_lock);
+void ThreadPool::reset_stats() {
+    for (std::size_t i = 0; i < THREADPOOL_TASK_PRIORITY_COUNT; i++) {
+        queue_latency_histograms[i].reset();
+        execution_time_histograms[i].reset();
+        enqueued_tasks[i].store(0, std::memory_order_relaxed);
+        completed_tasks[i].store(0, std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard<std::mutex> threads_lock(threads_mutex);
+        for (auto &stats : worker_stats) {
+            stats->busy_nanoseconds.store(0, std::memory_order_relaxed);
+        }
+    }
+
+    stats_reset_time = std::chrono::steady_clock::now().time_since_epoch().count();
+}
+
+ThreadPoolStats ThreadPool::get_stats() {
+    ThreadPoolStats stats;
+
+    for (std::size_t i = 0; i < THREADPOOL_TASK_PRIORITY_COUNT; i++) {
+        stats.enqueued_tasks[i] = enqueued_tasks[i].load(std::memory_order_relaxed);
+        stats.completed_tasks[i] = completed_tasks[i].load(std::memory_order_relaxed);
+    }
+
+    {
+        std::lock_guard<std::mutex> queue_lock(tasklist_mutex);
+        for (std::size_t i = 0; i < THREADPOOL_TASK_PRIORITY_COUNT; i++) {
+            stats.queue_depth[i] =
+                (backend == TaskQueueBackend::LOCK_FREE) ? pending_tasks[i].load() : tasklists[i].size();
+        }
+    }
+
+    const auto elapsed_nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                         std::chrono::steady_clock::now().time_since_epoch() -
+                                         std::chrono::steady_clock::duration(stats_reset_time.load()))
+                                         .count();
+
+    std::lock_guard<std::mutex> threads_lock(threads_mutex);
+    stats.worker_utilization.reserve(worker_stats.size());
+    for (const auto &worker : worker_stats) {
+        const auto busy_nanoseconds = worker->busy_nanoseconds.load(std::memory_order_relaxed);
+        stats.worker_utilization.push_back(
+            elapsed_nanoseconds > 0
+                ? std::min(1.0f, static_cast<float>(busy_nanoseconds) / static_cast<float>(elapsed_nanoseconds))
+                : 0.0f);
+    }
+
+    return stats;
+}
+
+bool ThreadPool::take_task(const std::size_t lowest_priority, std::condition_variable &worker_cv,
+                           std::size_t &priority, std::unique_ptr<TaskContainerBase> &task) {
+    // Lock the queue so we can see which tasks are to ne done.
+    std::unique_lock<std::mutex> queue_lock(tasklist_mutex);
+
+    // Returns the index of the tasklist to pick the next task from, or lowest_priority + 1 if there is nothing to do.
+    const auto next_priority = [&]() -> std::size_t {
+        std::size_t next = 0;
+        while (next <= lowest_priority && tasklists[next].empty()) {
+            next++;
+        }
+        return next;
+    };
+
+    // Use the conditional variable to wait for new tasks.
+    worker_cv.wait(queue_lock, [&]() -> bool { return next_priority() <= lowest_priority || stop_threads; });
+
+    priority = next_priority();
+
+    // Check if we should finish the task.
+    if (stop_threads && priority > lowest_priority) {
+        return false;
+    }
+
+    // To initialise the task, we must move the unique pointer
+    // from the queue to the loal stakc. Since a unique pointer
+    // cannot be copie, it must be explicitly moved. This transfers
+    // ownershp of the pointed-to object to *this.
+    task = std::move(tasklists[priority].front());
 
-            while (true) {
-                // Lock the queue
-                queue_lock.lock();
+    // Remove the task from the task list.
+    tasklists[priority].pop();
 
-                // spdlog::debug("Waiting for work!.");
+    return true;
+}
+
+bool ThreadPool::take_task_lock_free(const std::size_t lowest_priority, std::condition_variable &worker_cv,
+                                     std::size_t &priority, std::unique_ptr<TaskContainerBase> &task) {
+    const auto has_pending_tasks = [&]() -> bool {
+        for (std::size_t i = 0; i <= lowest_priority; i++) {
+            if (pending_tasks[i].load() > 0) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    while (true) {
+        for (priority = 0; priority <= lowest_priority; priority++) {
+            if (lock_free_tasklists[priority]->try_pop(task)) {
+                pending_tasks[priority].fetch_sub(1);
+                return true;
+            }
+        }
+
+        if (stop_threads) {
+            return false;
+        }
+
+        // The mutex is only needed to go to sleep. Producers only take it if a worker is sleeping.
+        std::unique_lock<std::mutex> sleep_lock(tasklist_mutex);
+        sleeping_workers.fetch_add(1);
+        worker_cv.wait(sleep_lock, [&]() -> bool { return has_pending_tasks() || stop_threads; });
+        sleeping_workers.fetch_sub(1);
+    }
+}
+
+void ThreadPool::run_task(const std::size_t priority, std::unique_ptr<TaskContainerBase> task, WorkerStats &stats) {
+    if (!instrumentation_enabled.load(std::memory_order_relaxed)) {
+        // Run the task!
+        (*task)();
+        return;
+    }
 
-                // Use the conditional variable to wait for new tasks.
-                tasklist_cv.wait(queue_lock, [&]() -> bool { return !tasklist.empty() || stop_threads; });
+    const auto start_time = std::chrono::steady_clock::now();
 
-                // spdlog::debug("Starting a new task!.");
+    // Tasks which were enqueued while instrumentation was disabled have no enqueue time.
+    if (task->enqueue_time != std::chrono::steady_clock::time_point{}) {
+        queue_latency_histograms[priority].record(start_time - task->enqueue_time);
+    }
+
+    // Run the task!
+    (*task)();
+
+    const auto execution_time = std::chrono::steady_clock::now() - start_time;
 
-                // Check if we should finish the task.
-                if (stop_threads && tasklist.empty()) {
-                    return;
-                }
+    execution_time_histograms[priority].record(execution_time);
+    completed_tasks[priority].fetch_add(1, std::memory_order_relaxed);
+    stats.busy_nanoseconds.fetch_add(std::chrono::duration_cast<std::chrono::nanoseconds>(execution_time).count(),
+                                     std::memory_order_relaxed);
+}
+
+void ThreadPool::start_thread(const bool low_latency_lane) {
+    // spdlog::debug("Starting new worker thread.");
 
-                // To initialise the task, we must move the unique pointer
-                // from the queue to the loal stakc. Since a unique pointer
-                // cannot be copie, it must be explicitly moved. This transfers
-                // ownershp of the pointed-to object to *this.
-                auto temp_task = std::move(tasklist.front());
+    // Workers of the low-latency lane only look at the frame-critical tasklist.
+    // General purpose workers check the tasklists in order of priority.
+    const std::size_t lowest_priority =
+        low_latency_lane ? static_cast<std::size_t>(TaskPriority::FRAME_CRITICAL) : THREADPOOL_TASK_PRIORITY_COUNT - 1;
 
-                // Remove the task from the task list.
-                tasklist.pop();
+    std::condition_variable &worker_cv = low_latency_lane ? low_latency_cv : tasklist_cv;
 
-                queue_lock.unlock();
+    // Other threads may read the worker list in get_stats() or reset_stats() at the same time.
+    std::lock_guard<std::mutex> threads_lock(threads_mutex);
 
-                // Run the task!
-                (*temp_task)();
+    worker_stats.push_back(std::make_unique<WorkerStats>());
+    WorkerStats &stats = *worker_stats.back();
 
-                // spdlog::debug("Task is done!");
+    // Start waiting for threads.
+    // Working threads listen for new tasks through ThreadPool's condition_variables.
+    // The lane settings are captured by value because the worker outlives this function call.
+    threads.emplace_back(std::thread([this, lowest_priority, &worker_cv, &stats]() {
+        std::size_t priority = 0;
+        std::unique_ptr<TaskContainerBase> task;
+
+        while (true) {
+            const bool has_task = (backend == TaskQueueBackend::LOCK_FREE)
+                                      ? take_task_lock_free(lowest_priority, worker_cv, priority, task)
+                                      : take_task(lowest_priority, worker_cv, priority, task);
+
+            // Check if we should finish the task.
+            if (!has_task) {
+                return;
             }
-        }));
+
+            run_task(priority, std::move(task), stats);
+
+            // spdlog::debug("Task is done!");
+        }
+    }));
 }
 
 } // namespace inexor
@@ -0,0 +1,76 @@
+#include "inexor/vulkan-renderer/tools/mip_chain.hpp"
+
+#include <algorithm>
+#include <cassert>
+
+namespace inexor::vulkan_renderer::tools {
+
+std::uint32_t calculate_mip_levels(std::uint32_t width, std::uint32_t height) {
+    std::uint32_t mip_levels = 1;
+
+    while (width > 1 || height > 1) {
+        width /= 2;
+        height /= 2;
+        mip_levels++;
+    }
+
+    return mip_levels;
+}
+
+std::vector<std::uint8_t> generate_mip_chain(const std::uint8_t *texture_data, std::uint32_t width,
+                                             std::uint32_t height, const std::uint32_t mip_levels,
+                                             std::vector<std::uint64_t> &mip_level_offsets) {
+    assert(texture_data);
+    assert(width > 0);
+    assert(height > 0);
+    assert(mip_levels > 0);
+
+    constexpr std::size_t TEXEL_SIZE = 4;
+
+    mip_level_offsets.resize(mip_levels);
+
+    std::size_t total_size = 0;
+    for (std::uint32_t level = 0; level < mip_levels; level++) {
+        mip_level_offsets[level] = total_size;
+        total_size += TEXEL_SIZE * std::max(width >> level, 1u) * std::max(height >> level, 1u);
+    }
+
+    std::vector<std::uint8_t> mip_chain(total_size);
+    std::copy(texture_data, texture_data + TEXEL_SIZE * width * height, mip_chain.begin());
+
+    for (std::uint32_t level = 1; level < mip_levels; level++) {
+        const std::uint8_t *src = mip_chain.data() + mip_level_offsets[level - 1];
+        std::uint8_t *dst = mip_chain.data() + mip_level_offsets[level];
+
+        const std::uint32_t dst_width = std::max(width / 2, 1u);
+        const std::uint32_t dst_height = std::max(height / 2, 1u);
+
+        for (std::uint32_t y = 0; y < dst_height; y++) {
+            // If a dimension of the previous level is 1, the same row or column is used twice.
+            const std::size_t row0 = std::min(2 * y, height - 1) * width;
+            const std::size_t row1 = std::min(2 * y + 1, height - 1) * width;
+
+            for (std::uint32_t x = 0; x < dst_width; x++) {
+                const std::size_t column0 = std::min(2 * x, width - 1);
+                const std::size_t column1 = std::min(2 * x + 1, width - 1);
+
+                for (std::size_t channel = 0; channel < TEXEL_SIZE; channel++) {
+                    const unsigned sum = src[(row0 + column0) * TEXEL_SIZE + channel] +
+                                         src[(row0 + column1) * TEXEL_SIZE + channel] +
+                                         src[(row1 + column0) * TEXEL_SIZE + channel] +
+                                         src[(row1 + column1) * TEXEL_SIZE + channel];
+
+                    dst[(static_cast<std::size_t>(y) * dst_width + x) * TEXEL_SIZE + channel] =
+                        static_cast<std::uint8_t>((sum + 2) / 4);
+                }
+            }
+        }
+
+        width = dst_width;
+        height = dst_height;
+    }
+
+    return mip_chain;
+}
+
+} // namespace inexor::vulkan_renderer::tools
@@ -0,0 +1,497 @@
+#include "inexor/vulkan-renderer/upload_manager.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace inexor::vulkan_renderer {
+
+namespace {
+
+/// Copies from a buffer into an image need an offset which is a multiple of 4 and of the texel block size, which is at
+/// most 16 bytes for block compressed formats.
+constexpr VkDeviceSize STAGING_ALIGNMENT = 16;
+
+} // namespace
+
+UploadManager::UploadManager(const VkDevice device, const VmaAllocator vma_allocator, const VkQueue transfer_queue,
+                             const std::uint32_t transfer_queue_family_index,
+                             const std::uint32_t graphics_queue_family_index, const VkDeviceSize staging_ring_size)
+    : device(device), vma_allocator(vma_allocator), transfer_queue(transfer_queue),
+      transfer_queue_family_index(transfer_queue_family_index),
+      graphics_queue_family_index(graphics_queue_family_index), command_pool(device, transfer_queue_family_index) {
+    assert(device);
+    assert(vma_allocator);
+    assert(transfer_queue);
+
+    staging_ring = std::make_unique<wrapper::StagingRingBuffer>(device, vma_allocator, "staging ring buffer",
+                                                                staging_ring_size, STAGING_ALIGNMENT);
+
+    spdlog::debug("Creating upload manager for queue family {}.", transfer_queue_family_index);
+
+    if (needs_ownership_transfer()) {
+        spdlog::debug("Uploaded resources will be transferred to queue family {}.", graphics_queue_family_index);
+    }
+}
+
+UploadManager::~UploadManager() {
+    if (!submitted_batches.empty()) {
+        wait(submitted_batches.back().id);
+    }
+}
+
+UploadManager::Batch &UploadManager::get_recording_batch() {
+    if (recording_batch) {
+        return *recording_batch;
+    }
+
+    if (free_command_buffers.empty()) {
+        free_command_buffers.emplace_back(device, command_pool.get());
+    }
+
+    if (free_fences.empty()) {
+        free_fences.push_back(std::make_unique<wrapper::Fence>(device, "Upload fence", false));
+    }
+
+    recording_batch.emplace(
+        Batch{next_batch_id++, std::move(free_command_buffers.back()), std::move(free_fences.back())});
+    free_command_buffers.pop_back();
+    free_fences.pop_back();
+
+    VkCommandBufferBeginInfo command_buffer_bi = {};
+    command_buffer_bi.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    command_buffer_bi.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+
+    // The command pool allows resetting single command buffers, so beginning it again resets it implicitly.
+    if (vkBeginCommandBuffer(recording_batch->command_buffer.get(), &command_buffer_bi) != VK_SUCCESS) {
+        throw std::runtime_error("Error: vkBeginCommandBuffer failed for upload batch!");
+    }
+
+    return *recording_batch;
+}
+
+std::pair<VkBuffer, VkDeviceSize> UploadManager::copy_to_staging_memory(const void *data, const VkDeviceSize size) {
+    stats.upload_count++;
+    stats.uploaded_bytes += size;
+
+    if (size > staging_ring->get_size()) {
+        Batch &batch = get_recording_batch();
+
+        batch.staging_buffers.push_back(std::make_unique<wrapper::GPUMemoryBuffer>(
+            device, vma_allocator, "staging buffer", size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+            VMA_MEMORY_USAGE_CPU_ONLY));
+        stats.staging_allocation_count++;
+
+        const auto &staging_buffer = batch.staging_buffers.back();
+        std::memcpy(staging_buffer->get_allocation_info().pMappedData, data, static_cast<std::size_t>(size));
+
+        return {staging_buffer->get_buffer(), 0};
+    }
+
+    auto offset = staging_ring->allocate(data, size);
+    if (!offset) {
+        update();
+        offset = staging_ring->allocate(data, size);
+    }
+
+    // The device still reads from the whole ring, so wait for the oldest batch until enough space has been released.
+    // If only the recording batch uses the ring, it has to be submitted first.
+    while (!offset) {
+        if (submitted_batches.empty()) {
+            assert(recording_batch);
+            submit();
+        }
+
+        stats.staging_ring_stall_count++;
+        wait(submitted_batches.front().id);
+        offset = staging_ring->allocate(data, size);
+    }
+
+    return {staging_ring->get_buffer(), *offset};
+}
+
+void UploadManager::upload_buffer(const VkBuffer buffer, const void *data, const VkDeviceSize size,
+                                  const VkDeviceSize buffer_offset, const VkPipelineStageFlags dst_stage_mask,
+                                  const VkAccessFlags dst_access_mask) {
+    assert(buffer);
+    assert(data);
+    assert(size > 0);
+
+    // This must happen before the recording batch is accessed, because it might submit the recording batch.
+    const auto [staging_buffer, staging_offset] = copy_to_staging_memory(data, size);
+    Batch &batch = get_recording_batch();
+
+    VkBufferCopy copy_region = {};
+    copy_region.srcOffset = staging_offset;
+    copy_region.dstOffset = buffer_offset;
+    copy_region.size = size;
+
+    vkCmdCopyBuffer(batch.command_buffer.get(), staging_buffer, buffer, 1, &copy_region);
+
+    VkBufferMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = dst_access_mask;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.buffer = buffer;
+    barrier.offset = buffer_offset;
+    barrier.size = size;
+
+    if (!needs_ownership_transfer()) {
+        vkCmdPipelineBarrier(batch.command_buffer.get(), VK_PIPELINE_STAGE_TRANSFER_BIT, dst_stage_mask, 0, 0, nullptr,
+                             1, &barrier, 0, nullptr);
+        return;
+    }
+
+    barrier.srcQueueFamilyIndex = transfer_queue_family_index;
+    barrier.dstQueueFamilyIndex = graphics_queue_family_index;
+
+    // The destination scope of a release barrier is ignored, the graphics queue defines it in the acquire barrier.
+    VkBufferMemoryBarrier release_barrier = barrier;
+    release_barrier.dstAccessMask = 0;
+
+    vkCmdPipelineBarrier(batch.command_buffer.get(), VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 1, &release_barrier, 0, nullptr);
+
+    // Likewise, the source scope of an acquire barrier is defined by the release barrier.
+    barrier.srcAccessMask = 0;
+    batch.acquire_buffer_barriers.push_back(barrier);
+    batch.acquire_stage_mask |= dst_stage_mask;
+}
+
+void UploadManager::record_image_copy(const VkCommandBuffer command_buffer, const VkImage image,
+                                      const VkBuffer staging_buffer, const VkDeviceSize staging_offset,
+                                      const VkExtent3D extent, const std::vector<VkDeviceSize> &mip_level_offsets) {
+    VkImageMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseMipLevel = 0;
+    barrier.subresourceRange.levelCount = static_cast<std::uint32_t>(mip_level_offsets.size());
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = 1;
+
+    vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0,
+                         nullptr, 0, nullptr, 1, &barrier);
+
+    std::vector<VkBufferImageCopy> copy_regions(mip_level_offsets.size());
+
+    for (std::uint32_t level = 0; level < copy_regions.size(); level++) {
+        auto &copy_region = copy_regions[level];
+        copy_region.bufferOffset = staging_offset + mip_level_offsets[level];
+        copy_region.bufferRowLength = 0;
+        copy_region.bufferImageHeight = 0;
+        copy_region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        copy_region.imageSubresource.mipLevel = level;
+        copy_region.imageSubresource.baseArrayLayer = 0;
+        copy_region.imageSubresource.layerCount = 1;
+        copy_region.imageOffset = {0, 0, 0};
+        copy_region.imageExtent = {std::max(extent.width >> level, 1u), std::max(extent.height >> level, 1u),
+                                   std::max(extent.depth >> level, 1u)};
+    }
+
+    vkCmdCopyBufferToImage(command_buffer, staging_buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                           static_cast<std::uint32_t>(copy_regions.size()), copy_regions.data());
+}
+
+void UploadManager::record_mipmap_generation(const VkCommandBuffer command_buffer,
+                                             const MipmapGeneration &mipmap_generation) {
+    const auto &[image, extent, mip_levels, final_layout, dst_stage_mask, dst_access_mask] = mipmap_generation;
+
+    // The first level is in VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL already, the other levels have not been used yet.
+    VkImageMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = 0;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseMipLevel = 1;
+    barrier.subresourceRange.levelCount = mip_levels - 1;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = 1;
+
+    vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0,
+                         nullptr, 0, nullptr, 1, &barrier);
+
+    // Every level is downsampled from the previous one, which must be finished before it can be read.
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    barrier.subresourceRange.levelCount = 1;
+
+    auto src_width = static_cast<std::int32_t>(extent.width);
+    auto src_height = static_cast<std::int32_t>(extent.height);
+
+    for (std::uint32_t level = 1; level < mip_levels; level++) {
+        const std::int32_t dst_width = std::max(src_width / 2, 1);
+        const std::int32_t dst_height = std::max(src_height / 2, 1);
+
+        VkImageBlit blit = {};
+        blit.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        blit.srcSubresource.mipLevel = level - 1;
+        blit.srcSubresource.baseArrayLayer = 0;
+        blit.srcSubresource.layerCount = 1;
+        blit.srcOffsets[1] = {src_width, src_height, 1};
+        blit.dstSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        blit.dstSubresource.mipLevel = level;
+        blit.dstSubresource.baseArrayLayer = 0;
+        blit.dstSubresource.layerCount = 1;
+        blit.dstOffsets[1] = {dst_width, dst_height, 1};
+
+        vkCmdBlitImage(command_buffer, image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, image,
+                       VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
+
+        barrier.subresourceRange.baseMipLevel = level;
+
+        vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0,
+                             nullptr, 0, nullptr, 1, &barrier);
+
+        src_width = dst_width;
+        src_height = dst_height;
+    }
+
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = dst_access_mask;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    barrier.newLayout = final_layout;
+    barrier.subresourceRange.baseMipLevel = 0;
+    barrier.subresourceRange.levelCount = mip_levels;
+
+    vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, dst_stage_mask, 0, 0, nullptr, 0, nullptr, 1,
+                         &barrier);
+}
+
+void UploadManager::upload_image(const VkImage image, const void *data, const VkDeviceSize size,
+                                 const VkExtent3D extent, const std::vector<VkDeviceSize> &mip_level_offsets,
+                                 const VkImageLayout final_layout, const VkPipelineStageFlags dst_stage_mask,
+                                 const VkAccessFlags dst_access_mask) {
+    assert(image);
+    assert(data);
+    assert(size > 0);
+    assert(!mip_level_offsets.empty());
+
+    // This must happen before the recording batch is accessed, because it might submit the recording batch.
+    const auto [staging_buffer, staging_offset] = copy_to_staging_memory(data, size);
+    Batch &batch = get_recording_batch();
+
+    record_image_copy(batch.command_buffer.get(), image, staging_buffer, staging_offset, extent, mip_level_offsets);
+
+    VkImageMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = dst_access_mask;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = final_layout;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseMipLevel = 0;
+    barrier.subresourceRange.levelCount = static_cast<std::uint32_t>(mip_level_offsets.size());
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = 1;
+
+    if (!needs_ownership_transfer()) {
+        vkCmdPipelineBarrier(batch.command_buffer.get(), VK_PIPELINE_STAGE_TRANSFER_BIT, dst_stage_mask, 0, 0, nullptr,
+                             0, nullptr, 1, &barrier);
+        return;
+    }
+
+    // The layout transition is part of the ownership transfer, so release and acquire barrier must specify it both.
+    barrier.srcQueueFamilyIndex = transfer_queue_family_index;
+    barrier.dstQueueFamilyIndex = graphics_queue_family_index;
+
+    VkImageMemoryBarrier release_barrier = barrier;
+    release_barrier.dstAccessMask = 0;
+
+    vkCmdPipelineBarrier(batch.command_buffer.get(), VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1, &release_barrier);
+
+    barrier.srcAccessMask = 0;
+    batch.acquire_image_barriers.push_back(barrier);
+    batch.acquire_stage_mask |= dst_stage_mask;
+}
+
+void UploadManager::upload_image_and_generate_mipmaps(const VkImage image, const void *data, const VkDeviceSize size,
+                                                      const VkExtent3D extent, const std::uint32_t mip_levels,
+                                                      const VkImageLayout final_layout,
+                                                      const VkPipelineStageFlags dst_stage_mask,
+                                                      const VkAccessFlags dst_access_mask) {
+    assert(mip_levels > 0);
+
+    if (mip_levels == 1) {
+        upload_image(image, data, size, extent, {0}, final_layout, dst_stage_mask, dst_access_mask);
+        return;
+    }
+
+    assert(image);
+    assert(data);
+    assert(size > 0);
+
+    const auto [staging_buffer, staging_offset] = copy_to_staging_memory(data, size);
+    Batch &batch = get_recording_batch();
+
+    record_image_copy(batch.command_buffer.get(), image, staging_buffer, staging_offset, extent, {0});
+
+    const MipmapGeneration mipmap_generation{image, extent, mip_levels, final_layout, dst_stage_mask, dst_access_mask};
+
+    // The first level is the source of the first blit.
+    VkImageMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+    barrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+    barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+    barrier.newLayout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    barrier.subresourceRange.baseMipLevel = 0;
+    barrier.subresourceRange.levelCount = 1;
+    barrier.subresourceRange.baseArrayLayer = 0;
+    barrier.subresourceRange.layerCount = 1;
+
+    if (!needs_ownership_transfer()) {
+        // The transfer queue belongs to the graphics queue family, so it supports blits.
+        vkCmdPipelineBarrier(batch.command_buffer.get(), VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+        record_mipmap_generation(batch.command_buffer.get(), mipmap_generation);
+        return;
+    }
+
+    // A dedicated transfer queue does not support blits, so the mip levels are generated on the graphics queue after
+    // it has acquired the first level.
+    barrier.srcQueueFamilyIndex = transfer_queue_family_index;
+    barrier.dstQueueFamilyIndex = graphics_queue_family_index;
+
+    VkImageMemoryBarrier release_barrier = barrier;
+    release_barrier.dstAccessMask = 0;
+
+    vkCmdPipelineBarrier(batch.command_buffer.get(), VK_PIPELINE_STAGE_TRANSFER_BIT,
+                         VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, nullptr, 0, nullptr, 1, &release_barrier);
+
+    barrier.srcAccessMask = 0;
+    batch.acquire_image_barriers.push_back(barrier);
+    batch.acquire_stage_mask |= VK_PIPELINE_STAGE_TRANSFER_BIT;
+    batch.mipmap_generations.push_back(mipmap_generation);
+}
+
+std::uint64_t UploadManager::submit() {
+    if (!recording_batch) {
+        return next_batch_id - 1;
+    }
+
+    Batch &batch = *recording_batch;
+    batch.staging_ring_mark = staging_ring->get_mark();
+
+    if (vkEndCommandBuffer(batch.command_buffer.get()) != VK_SUCCESS) {
+        throw std::runtime_error("Error: vkEndCommandBuffer failed for upload batch!");
+    }
+
+    VkSubmitInfo submit_info = {};
+    submit_info.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+    submit_info.commandBufferCount = 1;
+    submit_info.pCommandBuffers = batch.command_buffer.get_ptr();
+
+    if (vkQueueSubmit(transfer_queue, 1, &submit_info, batch.fence->get()) != VK_SUCCESS) {
+        throw std::runtime_error("Error: vkQueueSubmit failed for upload batch!");
+    }
+
+    spdlog::debug("Submitted upload batch {}, {} bytes of the staging ring are in use.", batch.id,
+                  staging_ring->get_used_size());
+
+    const std::uint64_t batch_id = batch.id;
+
+    submitted_batches.push_back(std::move(batch));
+    recording_batch.reset();
+
+    return batch_id;
+}
+
+void UploadManager::retire_oldest_batch() {
+    assert(!submitted_batches.empty());
+
+    Batch &batch = submitted_batches.front();
+
+    pending_buffer_barriers.insert(pending_buffer_barriers.end(), batch.acquire_buffer_barriers.begin(),
+                                   batch.acquire_buffer_barriers.end());
+    pending_image_barriers.insert(pending_image_barriers.end(), batch.acquire_image_barriers.begin(),
+                                  batch.acquire_image_barriers.end());
+    pending_stage_mask |= batch.acquire_stage_mask;
+    pending_mipmap_generations.insert(pending_mipmap_generations.end(), batch.mipmap_generations.begin(),
+                                      batch.mipmap_generations.end());
+
+    finished_batch_id = batch.id;
+
+    batch.fence->reset();
+    free_fences.push_back(std::move(batch.fence));
+    free_command_buffers.push_back(std::move(batch.command_buffer));
+
+    staging_ring->release(batch.staging_ring_mark);
+
+    // This destroys the staging buffers of the batch.
+    submitted_batches.pop_front();
+}
+
+void UploadManager::update() {
+    // Batches are submitted to the same queue, so they finish in the order of submission.
+    while (!submitted_batches.empty() &&
+           vkGetFenceStatus(device, submitted_batches.front().fence->get()) == VK_SUCCESS) {
+        retire_oldest_batch();
+    }
+}
+
+void UploadManager::wait(const std::uint64_t batch_id) {
+    assert(batch_id < next_batch_id);
+    assert(!recording_batch || recording_batch->id != batch_id);
+
+    while (!submitted_batches.empty() && submitted_batches.front().id <= batch_id) {
+        submitted_batches.front().fence->block(std::numeric_limits<std::uint64_t>::max());
+        retire_oldest_batch();
+    }
+}
+
+void UploadManager::record_acquire_barriers(const VkCommandBuffer command_buffer) {
+    assert(command_buffer);
+
+    update();
+
+    if (!pending_buffer_barriers.empty() || !pending_image_barriers.empty()) {
+        vkCmdPipelineBarrier(command_buffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, pending_stage_mask, 0, 0, nullptr,
+                             static_cast<std::uint32_t>(pending_buffer_barriers.size()), pending_buffer_barriers.data(),
+                             static_cast<std::uint32_t>(pending_image_barriers.size()), pending_image_barriers.data());
+
+        pending_buffer_barriers.clear();
+        pending_image_barriers.clear();
+        pending_stage_mask = 0;
+    }
+
+    for (const auto &mipmap_generation : pending_mipmap_generations) {
+        record_mipmap_generation(command_buffer, mipmap_generation);
+    }
+
+    pending_mipmap_generations.clear();
+
+    available_batch_id = finished_batch_id;
+}
+
+} // namespace inexor::vulkan_renderer
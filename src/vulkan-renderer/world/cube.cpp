@@ -1,4 +1,5 @@
 #include "inexor/vulkan-renderer/world/cube.hpp"
+#include "inexor/vulkan-renderer/frustum.hpp"
 #include "inexor/vulkan-renderer/world/indentation.hpp"
 
 #include <spdlog/spdlog.h>
@@ -184,6 +185,14 @@ Cube::Type Cube::type() const noexcept {
     return m_type;
 }
 
+float Cube::size() const noexcept {
+    return m_size;
+}
+
+glm::vec3 Cube::position() const noexcept {
+    return m_position;
+}
+
 const std::array<std::shared_ptr<Cube>, Cube::SUB_CUBES> &Cube::childs() const {
     return m_childs;
 }
@@ -306,4 +315,38 @@ std::vector<PolygonCache> Cube::polygons(const bool update_invalid) const {
     collect(this->shared_from_this());
     return polygons;
 }
+
+std::vector<PolygonCache> Cube::polygons(const Frustum &frustum, const bool update_invalid) const {
+    std::vector<PolygonCache> polygons;
+
+    std::function<void(std::shared_ptr<const world::Cube>, bool)> collect;
+    // pre-order traversal, every cube is inside of its parent
+    collect = [&collect, &polygons, &frustum, &update_invalid](std::shared_ptr<const world::Cube> cube, bool inside) {
+        if (cube->type() == world::Cube::Type::EMPTY) {
+            return;
+        }
+        if (!inside) {
+            const glm::vec3 position = cube->position();
+            const auto visibility = frustum.test_box(position, position + glm::vec3(cube->size()));
+            if (visibility == Frustum::Visibility::OUTSIDE) {
+                return;
+            }
+            inside = visibility == Frustum::Visibility::INSIDE;
+        }
+        if (cube->type() == world::Cube::Type::OCTANT) {
+            for (const auto &child : cube->childs()) {
+                collect(child, inside);
+            }
+            return;
+        }
+        if (!cube->m_polygon_cache_valid && update_invalid) {
+            cube->update_polygon_cache();
+        }
+        if (cube->m_polygon_cache != nullptr) {
+            polygons.push_back(cube->m_polygon_cache);
+        }
+    };
+    collect(this->shared_from_this(), false);
+    return polygons;
+}
 } // namespace inexor::vulkan_renderer::world
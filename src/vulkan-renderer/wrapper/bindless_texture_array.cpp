@@ -0,0 +1,156 @@
+#include "inexor/vulkan-renderer/wrapper/bindless_texture_array.hpp"
+
+#include "inexor/vulkan-renderer/frame_arena.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <vector>
+
+namespace inexor::vulkan_renderer::wrapper {
+
+BindlessTextureArray::BindlessTextureArray(const VkDevice device, const VkPhysicalDevice graphics_card,
+                                           const bool descriptor_indexing_enabled, const std::string &name)
+    : device(device), name(name), bindless(descriptor_indexing_enabled) {
+    assert(device);
+    assert(graphics_card);
+    assert(!name.empty());
+
+    if (bindless) {
+        VkPhysicalDeviceDescriptorIndexingPropertiesEXT descriptor_indexing_properties = {};
+        descriptor_indexing_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES_EXT;
+
+        VkPhysicalDeviceProperties2 graphics_card_properties = {};
+        graphics_card_properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+        graphics_card_properties.pNext = &descriptor_indexing_properties;
+
+        vkGetPhysicalDeviceProperties2(graphics_card, &graphics_card_properties);
+
+        capacity = std::min({MAX_BINDLESS_TEXTURE_COUNT,
+                             descriptor_indexing_properties.maxPerStageDescriptorUpdateAfterBindSamplers,
+                             descriptor_indexing_properties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+                             descriptor_indexing_properties.maxDescriptorSetUpdateAfterBindSamplers,
+                             descriptor_indexing_properties.maxDescriptorSetUpdateAfterBindSampledImages});
+    } else {
+        VkPhysicalDeviceProperties graphics_card_properties;
+        vkGetPhysicalDeviceProperties(graphics_card, &graphics_card_properties);
+
+        capacity = std::min({MAX_FALLBACK_TEXTURE_COUNT, graphics_card_properties.limits.maxPerStageDescriptorSamplers,
+                             graphics_card_properties.limits.maxPerStageDescriptorSampledImages,
+                             graphics_card_properties.limits.maxDescriptorSetSamplers,
+                             graphics_card_properties.limits.maxDescriptorSetSampledImages});
+    }
+
+    if (capacity == 0) {
+        throw std::runtime_error("Error: The graphics card does not support texture arrays!");
+    }
+
+    spdlog::debug("Creating {} texture array {} with {} elements.", bindless ? "bindless" : "fallback", name, capacity);
+
+    VkDescriptorSetLayoutBinding binding = {};
+    binding.binding = 0;
+    binding.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    binding.descriptorCount = capacity;
+    binding.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+    // Elements which are not used by a draw don't have to be valid, and adding textures does not invalidate the
+    // command buffers which have bound the descriptor set.
+    const VkDescriptorBindingFlagsEXT binding_flags =
+        VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT_EXT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT_EXT;
+
+    VkDescriptorSetLayoutBindingFlagsCreateInfoEXT binding_flags_ci = {};
+    binding_flags_ci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO_EXT;
+    binding_flags_ci.bindingCount = 1;
+    binding_flags_ci.pBindingFlags = &binding_flags;
+
+    VkDescriptorSetLayoutCreateInfo descriptor_set_layout_ci = {};
+    descriptor_set_layout_ci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    descriptor_set_layout_ci.bindingCount = 1;
+    descriptor_set_layout_ci.pBindings = &binding;
+
+    if (bindless) {
+        descriptor_set_layout_ci.pNext = &binding_flags_ci;
+        descriptor_set_layout_ci.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT_EXT;
+    }
+
+    if (vkCreateDescriptorSetLayout(device, &descriptor_set_layout_ci, nullptr, &descriptor_set_layout) != VK_SUCCESS) {
+        throw std::runtime_error("Error: vkCreateDescriptorSetLayout failed for texture array " + name + " !");
+    }
+
+    VkDescriptorPoolSize pool_size = {};
+    pool_size.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    pool_size.descriptorCount = capacity;
+
+    VkDescriptorPoolCreateInfo descriptor_pool_ci = {};
+    descriptor_pool_ci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    descriptor_pool_ci.flags = bindless ? VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT_EXT : 0;
+    descriptor_pool_ci.maxSets = 1;
+    descriptor_pool_ci.poolSizeCount = 1;
+    descriptor_pool_ci.pPoolSizes = &pool_size;
+
+    if (vkCreateDescriptorPool(device, &descriptor_pool_ci, nullptr, &descriptor_pool) != VK_SUCCESS) {
+        vkDestroyDescriptorSetLayout(device, descriptor_set_layout, nullptr);
+        throw std::runtime_error("Error: vkCreateDescriptorPool failed for texture array " + name + " !");
+    }
+
+    VkDescriptorSetAllocateInfo descriptor_set_ai = {};
+    descriptor_set_ai.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    descriptor_set_ai.descriptorPool = descriptor_pool;
+    descriptor_set_ai.descriptorSetCount = 1;
+    descriptor_set_ai.pSetLayouts = &descriptor_set_layout;
+
+    if (vkAllocateDescriptorSets(device, &descriptor_set_ai, &descriptor_set) != VK_SUCCESS) {
+        vkDestroyDescriptorPool(device, descriptor_pool, nullptr);
+        vkDestroyDescriptorSetLayout(device, descriptor_set_layout, nullptr);
+        throw std::runtime_error("Error: vkAllocateDescriptorSets failed for texture array " + name + " !");
+    }
+}
+
+BindlessTextureArray::~BindlessTextureArray() {
+    spdlog::trace("Destroying texture array {}.", name);
+
+    // The descriptor set is freed along with its pool.
+    vkDestroyDescriptorPool(device, descriptor_pool, nullptr);
+    vkDestroyDescriptorSetLayout(device, descriptor_set_layout, nullptr);
+}
+
+void BindlessTextureArray::write_descriptors(const Texture &texture, const std::uint32_t first_element,
+                                             const std::uint32_t element_count) {
+    VkDescriptorImageInfo image_info = {};
+    image_info.sampler = texture.get_sampler();
+    image_info.imageView = texture.get_image_view();
+    image_info.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+
+    const std::pmr::vector<VkDescriptorImageInfo> image_infos(element_count, image_info, &FrameArena::get());
+
+    VkWriteDescriptorSet descriptor_write = {};
+    descriptor_write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+    descriptor_write.dstSet = descriptor_set;
+    descriptor_write.dstBinding = 0;
+    descriptor_write.dstArrayElement = first_element;
+    descriptor_write.descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER;
+    descriptor_write.descriptorCount = element_count;
+    descriptor_write.pImageInfo = image_infos.data();
+
+    vkUpdateDescriptorSets(device, 1, &descriptor_write, 0, nullptr);
+}
+
+std::uint32_t BindlessTextureArray::add(const Texture &texture) {
+    if (size == capacity) {
+        throw std::runtime_error("Error: Texture array " + name + " is full, it can hold " + std::to_string(capacity) +
+                                 " textures!");
+    }
+
+    // Every element of the fallback array must be valid, so the first texture is written into all of them.
+    if (!bindless && size == 0) {
+        write_descriptors(texture, 0, capacity);
+    } else {
+        write_descriptors(texture, size, 1);
+    }
+
+    return size++;
+}
+
+} // namespace inexor::vulkan_renderer::wrapper
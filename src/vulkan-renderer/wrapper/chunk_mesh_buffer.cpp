@@ -0,0 +1,115 @@
+#include "inexor/vulkan-renderer/wrapper/chunk_mesh_buffer.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <cassert>
+#include <stdexcept>
+
+namespace inexor::vulkan_renderer::wrapper {
+
+ChunkMeshBuffer::ChunkMeshBuffer(const VkDevice device, const VmaAllocator vma_allocator, const std::string &name,
+                                 const VkDeviceSize vertex_size, const std::uint32_t max_vertex_count,
+                                 const std::uint32_t max_index_count)
+    : name(name), vertex_size(vertex_size),
+      vertex_buffer(device, vma_allocator, name + " vertices", vertex_size * max_vertex_count,
+                    VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, VMA_MEMORY_USAGE_GPU_ONLY),
+      index_buffer(device, vma_allocator, name + " indices", sizeof(std::uint32_t) * max_index_count,
+                   VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT, VMA_MEMORY_USAGE_GPU_ONLY),
+      vertex_ranges(max_vertex_count), index_ranges(max_index_count) {
+    assert(device);
+    assert(vma_allocator);
+    assert(!name.empty());
+    assert(vertex_size > 0);
+    assert(max_vertex_count > 0);
+    assert(max_index_count > 0);
+
+    spdlog::debug("Created chunk mesh buffer {} for {} vertices and {} indices.", name, max_vertex_count,
+                  max_index_count);
+}
+
+std::uint32_t ChunkMeshBuffer::add_chunk(UploadManager &upload_manager, const void *vertices,
+                                         const std::uint32_t vertex_count, const std::uint32_t *indices,
+                                         const std::uint32_t index_count, const Bounds &bounds) {
+    assert(vertices);
+    assert(vertex_count > 0);
+    assert(indices);
+    assert(index_count > 0);
+
+    const auto first_vertex = vertex_ranges.allocate(vertex_count);
+    if (!first_vertex) {
+        throw std::runtime_error("Error: Chunk mesh buffer " + name + " has no space left for " +
+                                 std::to_string(vertex_count) + " vertices!");
+    }
+
+    const auto first_index = index_ranges.allocate(index_count);
+    if (!first_index) {
+        vertex_ranges.free(*first_vertex, vertex_count);
+        throw std::runtime_error("Error: Chunk mesh buffer " + name + " has no space left for " +
+                                 std::to_string(index_count) + " indices!");
+    }
+
+    upload_manager.upload_buffer(vertex_buffer.get_buffer(), vertices, vertex_size * vertex_count,
+                                 vertex_size * *first_vertex, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                                 VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT);
+
+    upload_manager.upload_buffer(index_buffer.get_buffer(), indices, sizeof(std::uint32_t) * index_count,
+                                 sizeof(std::uint32_t) * *first_index, VK_PIPELINE_STAGE_VERTEX_INPUT_BIT,
+                                 VK_ACCESS_INDEX_READ_BIT);
+
+    std::uint32_t chunk_id = 0;
+
+    if (!free_chunk_ids.empty()) {
+        chunk_id = free_chunk_ids.back();
+        free_chunk_ids.pop_back();
+    } else {
+        chunk_id = static_cast<std::uint32_t>(chunks.size());
+        chunks.emplace_back();
+    }
+
+    Chunk &chunk = chunks[chunk_id];
+    chunk.first_vertex = *first_vertex;
+    chunk.vertex_count = vertex_count;
+    chunk.first_index = *first_index;
+    chunk.index_count = index_count;
+    chunk.draw_index = static_cast<std::uint32_t>(draw_commands.size());
+
+    VkDrawIndexedIndirectCommand draw_command = {};
+    draw_command.indexCount = index_count;
+    draw_command.instanceCount = 1;
+    draw_command.firstIndex = *first_index;
+    draw_command.vertexOffset = static_cast<std::int32_t>(*first_vertex);
+    draw_command.firstInstance = 0;
+
+    draw_commands.push_back(draw_command);
+    draw_bounds.push_back(bounds);
+    draw_chunk_ids.push_back(chunk_id);
+
+    return chunk_id;
+}
+
+void ChunkMeshBuffer::remove_chunk(const std::uint32_t chunk_id) {
+    assert(chunk_id < chunks.size());
+
+    Chunk &chunk = chunks[chunk_id];
+    assert(chunk.vertex_count > 0);
+
+    vertex_ranges.free(chunk.first_vertex, chunk.vertex_count);
+    index_ranges.free(chunk.first_index, chunk.index_count);
+
+    // Move the last draw command into the place of the removed one, so the commands stay densely packed.
+    const std::uint32_t last_chunk_id = draw_chunk_ids.back();
+
+    draw_commands[chunk.draw_index] = draw_commands.back();
+    draw_bounds[chunk.draw_index] = draw_bounds.back();
+    draw_chunk_ids[chunk.draw_index] = last_chunk_id;
+    chunks[last_chunk_id].draw_index = chunk.draw_index;
+
+    draw_commands.pop_back();
+    draw_bounds.pop_back();
+    draw_chunk_ids.pop_back();
+
+    chunk = {};
+    free_chunk_ids.push_back(chunk_id);
+}
+
+} // namespace inexor::vulkan_renderer::wrapper
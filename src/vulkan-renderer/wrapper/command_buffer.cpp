@@ -5,12 +5,13 @@ namespace inexor::vulkan_renderer::wrapper {
 CommandBuffer::CommandBuffer(CommandBuffer &&other) noexcept
     : command_buffer(std::exchange(other.command_buffer, nullptr)) {}
 
-CommandBuffer::CommandBuffer(const VkDevice device, const VkCommandPool command_pool) {
+CommandBuffer::CommandBuffer(const VkDevice device, const VkCommandPool command_pool,
+                             const VkCommandBufferLevel level) {
     VkCommandBufferAllocateInfo alloc_info = {};
     alloc_info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
     alloc_info.commandBufferCount = 1;
     alloc_info.commandPool = command_pool;
-    alloc_info.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+    alloc_info.level = level;
 
     if (vkAllocateCommandBuffers(device, &alloc_info, &command_buffer) != VK_SUCCESS) {
         throw std::runtime_error("Error: vkAllocateCommandBuffers failed for once command buffer!");
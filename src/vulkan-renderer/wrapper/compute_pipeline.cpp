@@ -0,0 +1,46 @@
+#include "inexor/vulkan-renderer/wrapper/compute_pipeline.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <cassert>
+#include <stdexcept>
+#include <utility>
+
+namespace inexor::vulkan_renderer::wrapper {
+
+ComputePipeline::ComputePipeline(ComputePipeline &&other) noexcept
+    : device(other.device), compute_pipeline(std::exchange(other.compute_pipeline, nullptr)),
+      name(std::move(other.name)) {}
+
+ComputePipeline::ComputePipeline(const VkDevice device, const VkPipelineCache pipeline_cache,
+                                 const VkPipelineLayout pipeline_layout,
+                                 const VkPipelineShaderStageCreateInfo &shader_stage, const std::string &name)
+    : device(device), name(name) {
+    assert(device);
+    assert(pipeline_cache);
+    assert(pipeline_layout);
+    assert(shader_stage.stage == VK_SHADER_STAGE_COMPUTE_BIT);
+    assert(!name.empty());
+
+    VkComputePipelineCreateInfo pipeline_ci = {};
+    pipeline_ci.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
+    pipeline_ci.stage = shader_stage;
+    pipeline_ci.layout = pipeline_layout;
+    pipeline_ci.basePipelineHandle = VK_NULL_HANDLE;
+    pipeline_ci.basePipelineIndex = -1;
+
+    spdlog::debug("Creating compute pipeline {}.", name);
+
+    if (vkCreateComputePipelines(device, pipeline_cache, 1, &pipeline_ci, nullptr, &compute_pipeline) != VK_SUCCESS) {
+        throw std::runtime_error("Error: vkCreateComputePipelines failed for " + name + " !");
+    }
+
+    spdlog::debug("Created compute pipeline successfully.");
+}
+
+ComputePipeline::~ComputePipeline() {
+    spdlog::trace("Destroying pipeline {}.", name);
+    vkDestroyPipeline(device, compute_pipeline, nullptr);
+}
+
+} // namespace inexor::vulkan_renderer::wrapper
@@ -0,0 +1,87 @@
+#include "inexor/vulkan-renderer/wrapper/depth_pyramid.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+
+namespace inexor::vulkan_renderer::wrapper {
+
+namespace {
+
+/// @brief Returns the largest power of two which is not larger than the given value.
+std::uint32_t previous_power_of_two(const std::uint32_t value) {
+    assert(value > 0);
+
+    std::uint32_t power = 1;
+    while (power <= value / 2) {
+        power *= 2;
+    }
+    return power;
+}
+
+/// @brief Returns the size of mip level 0 of a depth pyramid.
+VkExtent2D get_pyramid_extent(const VkExtent2D depth_extent) {
+    return {previous_power_of_two(depth_extent.width), previous_power_of_two(depth_extent.height)};
+}
+
+/// @brief Returns the number of mip levels down to a size of 1 x 1.
+std::uint32_t get_full_mip_count(const VkExtent2D extent) {
+    std::uint32_t mip_count = 1;
+    while ((std::max(extent.width, extent.height) >> mip_count) > 0) {
+        mip_count++;
+    }
+    return mip_count;
+}
+
+} // namespace
+
+DepthPyramid::DepthPyramid(const VkDevice device, const VkPhysicalDevice graphics_card,
+                           const VmaAllocator vma_allocator, const VkExtent2D depth_extent, const std::string &name)
+    : device(device), name(name), extent(get_pyramid_extent(depth_extent)), mip_count(get_full_mip_count(extent)),
+      image(device, graphics_card, vma_allocator, FORMAT, VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+            VK_IMAGE_ASPECT_COLOR_BIT, VK_SAMPLE_COUNT_1_BIT, name, extent, mip_count) {
+    assert(device);
+    assert(!name.empty());
+
+    mip_views.reserve(mip_count);
+
+    for (std::uint32_t mip_level = 0; mip_level < mip_count; mip_level++) {
+        VkImageViewCreateInfo image_view_ci = {};
+        image_view_ci.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+        image_view_ci.image = image.get();
+        image_view_ci.viewType = VK_IMAGE_VIEW_TYPE_2D;
+        image_view_ci.format = FORMAT;
+        image_view_ci.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+        image_view_ci.subresourceRange.baseMipLevel = mip_level;
+        image_view_ci.subresourceRange.levelCount = 1;
+        image_view_ci.subresourceRange.baseArrayLayer = 0;
+        image_view_ci.subresourceRange.layerCount = 1;
+
+        VkImageView mip_view = VK_NULL_HANDLE;
+        if (vkCreateImageView(device, &image_view_ci, nullptr, &mip_view) != VK_SUCCESS) {
+            throw std::runtime_error("Error: vkCreateImageView failed for mip level " + std::to_string(mip_level) +
+                                     " of depth pyramid " + name + "!");
+        }
+        mip_views.push_back(mip_view);
+    }
+
+    spdlog::debug("Created depth pyramid {} of size {} x {} with {} mip levels.", name, extent.width, extent.height,
+                  mip_count);
+}
+
+DepthPyramid::~DepthPyramid() {
+    spdlog::trace("Destroying depth pyramid {}.", name);
+
+    for (const auto mip_view : mip_views) {
+        vkDestroyImageView(device, mip_view, nullptr);
+    }
+}
+
+VkExtent2D DepthPyramid::get_mip_extent(const std::uint32_t mip_level) const {
+    assert(mip_level < mip_count);
+    return {std::max(1u, extent.width >> mip_level), std::max(1u, extent.height >> mip_level)};
+}
+
+} // namespace inexor::vulkan_renderer::wrapper
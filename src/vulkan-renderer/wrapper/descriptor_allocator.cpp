@@ -0,0 +1,130 @@
+#include "inexor/vulkan-renderer/wrapper/descriptor_allocator.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <stdexcept>
+
+namespace inexor::vulkan_renderer::wrapper {
+
+std::vector<DescriptorAllocator::PoolSizeRatio> DescriptorAllocator::get_default_pool_size_ratios() {
+    return {{VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1.0f},
+            {VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 2.0f},
+            {VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1.0f},
+            {VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4.0f},
+            {VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, 1.0f},
+            {VK_DESCRIPTOR_TYPE_STORAGE_IMAGE, 1.0f}};
+}
+
+DescriptorAllocator::DescriptorAllocator(const VkDevice device, const std::string &name,
+                                         const std::vector<PoolSizeRatio> &pool_size_ratios,
+                                         const std::uint32_t initial_sets_per_pool)
+    : device(device), name(name), pool_size_ratios(pool_size_ratios),
+      sets_per_pool(std::clamp(initial_sets_per_pool, 1u, MAX_SETS_PER_POOL)) {
+    assert(device);
+    assert(!name.empty());
+    assert(!pool_size_ratios.empty());
+}
+
+DescriptorAllocator::~DescriptorAllocator() {
+    spdlog::trace("Destroying {} descriptor pools of descriptor allocator {}.", get_pool_count(), name);
+
+    if (current_pool != VK_NULL_HANDLE) {
+        vkDestroyDescriptorPool(device, current_pool, nullptr);
+    }
+    for (const auto pool : used_pools) {
+        vkDestroyDescriptorPool(device, pool, nullptr);
+    }
+    for (const auto pool : free_pools) {
+        vkDestroyDescriptorPool(device, pool, nullptr);
+    }
+}
+
+void DescriptorAllocator::use_next_pool() {
+    if (current_pool != VK_NULL_HANDLE) {
+        used_pools.push_back(current_pool);
+        current_pool = VK_NULL_HANDLE;
+    }
+
+    if (!free_pools.empty()) {
+        current_pool = free_pools.back();
+        free_pools.pop_back();
+        return;
+    }
+
+    std::vector<VkDescriptorPoolSize> pool_sizes;
+    pool_sizes.reserve(pool_size_ratios.size());
+
+    for (const auto &[type, ratio] : pool_size_ratios) {
+        const auto descriptor_count = static_cast<std::uint32_t>(std::ceil(ratio * static_cast<float>(sets_per_pool)));
+        pool_sizes.push_back({type, std::max(descriptor_count, 1u)});
+    }
+
+    VkDescriptorPoolCreateInfo descriptor_pool_ci = {};
+    descriptor_pool_ci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    descriptor_pool_ci.maxSets = sets_per_pool;
+    descriptor_pool_ci.poolSizeCount = static_cast<std::uint32_t>(pool_sizes.size());
+    descriptor_pool_ci.pPoolSizes = pool_sizes.data();
+
+    if (vkCreateDescriptorPool(device, &descriptor_pool_ci, nullptr, &current_pool) != VK_SUCCESS) {
+        throw std::runtime_error("Error: vkCreateDescriptorPool failed for descriptor allocator " + name + " !");
+    }
+
+    spdlog::debug("Created descriptor pool #{} for {} sets in descriptor allocator {}.", get_pool_count(),
+                  sets_per_pool, name);
+
+    // Every new pool is larger than the previous one, so a growing number of sets needs few pools.
+    sets_per_pool = std::min(2 * sets_per_pool, MAX_SETS_PER_POOL);
+}
+
+VkDescriptorSet DescriptorAllocator::allocate(const VkDescriptorSetLayout descriptor_set_layout) {
+    assert(descriptor_set_layout);
+
+    if (current_pool == VK_NULL_HANDLE) {
+        use_next_pool();
+    }
+
+    VkDescriptorSetAllocateInfo descriptor_set_ai = {};
+    descriptor_set_ai.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+    descriptor_set_ai.descriptorPool = current_pool;
+    descriptor_set_ai.descriptorSetCount = 1;
+    descriptor_set_ai.pSetLayouts = &descriptor_set_layout;
+
+    VkDescriptorSet descriptor_set = VK_NULL_HANDLE;
+    VkResult result = vkAllocateDescriptorSets(device, &descriptor_set_ai, &descriptor_set);
+
+    // The current pool is exhausted, so the set is allocated from the next one.
+    if (result == VK_ERROR_OUT_OF_POOL_MEMORY || result == VK_ERROR_FRAGMENTED_POOL) {
+        use_next_pool();
+
+        descriptor_set_ai.descriptorPool = current_pool;
+        result = vkAllocateDescriptorSets(device, &descriptor_set_ai, &descriptor_set);
+    }
+
+    if (result != VK_SUCCESS) {
+        throw std::runtime_error("Error: vkAllocateDescriptorSets failed for descriptor allocator " + name + " !");
+    }
+
+    allocated_set_count++;
+
+    return descriptor_set;
+}
+
+void DescriptorAllocator::reset() {
+    if (current_pool != VK_NULL_HANDLE) {
+        used_pools.push_back(current_pool);
+        current_pool = VK_NULL_HANDLE;
+    }
+
+    for (const auto pool : used_pools) {
+        vkResetDescriptorPool(device, pool, 0);
+        free_pools.push_back(pool);
+    }
+
+    used_pools.clear();
+    allocated_set_count = 0;
+}
+
+} // namespace inexor::vulkan_renderer::wrapper
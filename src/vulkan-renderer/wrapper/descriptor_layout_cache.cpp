@@ -0,0 +1,88 @@
+#include "inexor/vulkan-renderer/wrapper/descriptor_layout_cache.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cassert>
+#include <functional>
+#include <stdexcept>
+
+namespace inexor::vulkan_renderer::wrapper {
+
+bool DescriptorLayoutCache::LayoutKey::operator==(const LayoutKey &other) const {
+    return std::equal(bindings.begin(), bindings.end(), other.bindings.begin(), other.bindings.end(),
+                      [](const VkDescriptorSetLayoutBinding &lhs, const VkDescriptorSetLayoutBinding &rhs) {
+                          return lhs.binding == rhs.binding && lhs.descriptorType == rhs.descriptorType &&
+                                 lhs.descriptorCount == rhs.descriptorCount && lhs.stageFlags == rhs.stageFlags &&
+                                 lhs.pImmutableSamplers == rhs.pImmutableSamplers;
+                      });
+}
+
+std::size_t DescriptorLayoutCache::LayoutKeyHash::operator()(const LayoutKey &key) const {
+    std::size_t hash = std::hash<std::size_t>()(key.bindings.size());
+
+    const auto combine = [&hash](const std::size_t value) {
+        hash ^= value + 0x9E3779B9 + (hash << 6) + (hash >> 2);
+    };
+
+    for (const auto &binding : key.bindings) {
+        combine(binding.binding);
+        combine(static_cast<std::size_t>(binding.descriptorType));
+        combine(binding.descriptorCount);
+        combine(binding.stageFlags);
+        combine(std::hash<const VkSampler *>()(binding.pImmutableSamplers));
+    }
+
+    return hash;
+}
+
+DescriptorLayoutCache::DescriptorLayoutCache(const VkDevice device, const std::string &name)
+    : device(device), name(name) {
+    assert(device);
+    assert(!name.empty());
+}
+
+DescriptorLayoutCache::~DescriptorLayoutCache() {
+    spdlog::trace("Destroying {} descriptor set layouts of descriptor layout cache {}.", layouts.size(), name);
+
+    for (const auto &[key, layout] : layouts) {
+        vkDestroyDescriptorSetLayout(device, layout, nullptr);
+    }
+}
+
+VkDescriptorSetLayout DescriptorLayoutCache::get(std::vector<VkDescriptorSetLayoutBinding> bindings) {
+    assert(!bindings.empty());
+
+    // The same bindings in another order describe the same layout.
+    std::sort(bindings.begin(), bindings.end(),
+              [](const VkDescriptorSetLayoutBinding &lhs, const VkDescriptorSetLayoutBinding &rhs) {
+                  return lhs.binding < rhs.binding;
+              });
+
+    LayoutKey key{std::move(bindings)};
+
+    if (const auto layout = layouts.find(key); layout != layouts.end()) {
+        return layout->second;
+    }
+
+    VkDescriptorSetLayoutCreateInfo descriptor_set_layout_ci = {};
+    descriptor_set_layout_ci.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+    descriptor_set_layout_ci.bindingCount = static_cast<std::uint32_t>(key.bindings.size());
+    descriptor_set_layout_ci.pBindings = key.bindings.data();
+
+    VkDescriptorSetLayout layout = VK_NULL_HANDLE;
+
+    if (vkCreateDescriptorSetLayout(device, &descriptor_set_layout_ci, nullptr, &layout) != VK_SUCCESS) {
+        throw std::runtime_error("Error: vkCreateDescriptorSetLayout failed for descriptor layout cache " + name +
+                                 " !");
+    }
+
+    spdlog::debug("Created descriptor set layout #{} with {} bindings in descriptor layout cache {}.",
+                  layouts.size() + 1, key.bindings.size(), name);
+
+    layouts.emplace(std::move(key), layout);
+
+    return layout;
+}
+
+} // namespace inexor::vulkan_renderer::wrapper
@@ -19,7 +19,8 @@ Device::Device(Device &&other) noexcept
     : device(std::exchange(other.device, nullptr)), graphics_card(std::exchange(other.graphics_card, nullptr)) {}
 
 Device::Device(const VkInstance instance, const VkSurfaceKHR surface, bool enable_vulkan_debug_markers,
-               bool prefer_distinct_transfer_queue, const std::optional<std::uint32_t> preferred_physical_device_index)
+               bool prefer_distinct_transfer_queue, bool prefer_descriptor_indexing,
+               const std::optional<std::uint32_t> preferred_physical_device_index)
     : graphics_card(graphics_card), surface(surface) {
 
     VulkanSettingsDecisionMaker settings_decision_maker;
@@ -44,8 +45,11 @@ Device::Device(const VkInstance instance, const VkSurfaceKHR surface, bool enabl
     }
 
     // Check if there is one queue family which can be used for both graphics and presentation.
+    // Without a surface (headless rendering), only a graphics queue is needed.
     std::optional<std::uint32_t> queue_family_index_for_both_graphics_and_presentation =
-        settings_decision_maker.find_queue_family_for_both_graphics_and_presentation(graphics_card, surface);
+        (surface != VK_NULL_HANDLE)
+            ? settings_decision_maker.find_queue_family_for_both_graphics_and_presentation(graphics_card, surface)
+            : settings_decision_maker.find_graphics_queue_family(graphics_card);
 
     if (queue_family_index_for_both_graphics_and_presentation) {
         spdlog::debug("One queue for both graphics and presentation will be used.");
@@ -144,10 +148,12 @@ Device::Device(const VkInstance instance, const VkSurfaceKHR surface, bool enabl
         transfer_queue_family_index = graphics_queue_family_index;
     }
 
-    std::vector<const char *> device_extensions_wishlist = {
+    std::vector<const char *> device_extensions_wishlist;
+
+    if (surface != VK_NULL_HANDLE) {
         // Since we want to draw on a window, we need the swapchain extension.
-        VK_KHR_SWAPCHAIN_EXTENSION_NAME,
-    };
+        device_extensions_wishlist.push_back(VK_KHR_SWAPCHAIN_EXTENSION_NAME);
+    }
 
 #ifndef NDEBUG
     if (enable_vulkan_debug_markers) {
@@ -172,13 +178,74 @@ Device::Device(const VkInstance instance, const VkSurfaceKHR surface, bool enabl
         }
     }
 
+    VkPhysicalDeviceDescriptorIndexingFeaturesEXT used_descriptor_indexing_features = {};
+    used_descriptor_indexing_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+
+    if (prefer_descriptor_indexing &&
+        availability_checks.has_device_extension(graphics_card, VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME)) {
+        VkPhysicalDeviceDescriptorIndexingFeaturesEXT available_descriptor_indexing_features = {};
+        available_descriptor_indexing_features.sType =
+            VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_FEATURES_EXT;
+
+        VkPhysicalDeviceFeatures2 supported_features = {};
+        supported_features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+        supported_features.pNext = &available_descriptor_indexing_features;
+
+        vkGetPhysicalDeviceFeatures2(graphics_card, &supported_features);
+
+        // Textures are bound as one array whose unused elements don't have to be valid, and which can be updated while
+        // command buffers which use it are pending.
+        descriptor_indexing_enabled =
+            available_descriptor_indexing_features.descriptorBindingPartiallyBound == VK_TRUE &&
+            available_descriptor_indexing_features.descriptorBindingSampledImageUpdateAfterBind == VK_TRUE;
+    }
+
+    if (descriptor_indexing_enabled) {
+        spdlog::debug("Device extension '{}' is available on this system.", VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+        enabled_device_extensions.push_back(VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+
+        used_descriptor_indexing_features.descriptorBindingPartiallyBound = VK_TRUE;
+        used_descriptor_indexing_features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+    } else if (prefer_descriptor_indexing) {
+        spdlog::warn("{} is not available, textures are bound as a small fallback array.",
+                     VK_EXT_DESCRIPTOR_INDEXING_EXTENSION_NAME);
+    }
+
     VkPhysicalDeviceFeatures used_features = {};
 
     // Enable anisotropic filtering.
     used_features.samplerAnisotropy = VK_TRUE;
 
+    VkPhysicalDeviceFeatures available_features;
+    vkGetPhysicalDeviceFeatures(graphics_card, &available_features);
+
+    // The fragment shader selects the texture of a draw by indexing the texture array with a push constant.
+    if (available_features.shaderSampledImageArrayDynamicIndexing != VK_TRUE) {
+        throw std::runtime_error("Error: Graphics card does not support dynamic indexing of sampled image arrays!");
+    }
+    used_features.shaderSampledImageArrayDynamicIndexing = VK_TRUE;
+
+    // Enable block compressed textures if possible. Textures fall back to uncompressed formats otherwise.
+    used_features.textureCompressionBC = available_features.textureCompressionBC;
+
+    // Enable issuing several draws with one indirect draw call if possible. Otherwise, every indirect draw call can
+    // only issue one draw.
+    used_features.multiDrawIndirect = available_features.multiDrawIndirect;
+    multi_draw_indirect_enabled = available_features.multiDrawIndirect == VK_TRUE;
+
+    // The number of indirect draws can be read from a buffer, so the device can decide how many draws it issues.
+    const bool draw_indirect_count_available =
+        multi_draw_indirect_enabled &&
+        availability_checks.has_device_extension(graphics_card, VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+
+    if (draw_indirect_count_available) {
+        spdlog::debug("Device extension '{}' is available on this system.", VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+        enabled_device_extensions.push_back(VK_KHR_DRAW_INDIRECT_COUNT_EXTENSION_NAME);
+    }
+
     VkDeviceCreateInfo device_ci = {};
     device_ci.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    device_ci.pNext = descriptor_indexing_enabled ? &used_descriptor_indexing_features : nullptr;
     device_ci.queueCreateInfoCount = static_cast<std::uint32_t>(queues_to_create.size());
     device_ci.pQueueCreateInfos = queues_to_create.data();
     // Device layers were deprecated in Vulkan some time ago, essentially making all layers instance layers.
@@ -194,6 +261,12 @@ Device::Device(const VkInstance instance, const VkSurfaceKHR surface, bool enabl
         throw std::runtime_error("Error: vkCreateDevice failed!");
     }
 
+    if (draw_indirect_count_available) {
+        vk_cmd_draw_indexed_indirect_count = reinterpret_cast<PFN_vkCmdDrawIndexedIndirectCountKHR>(
+            vkGetDeviceProcAddr(device, "vkCmdDrawIndexedIndirectCountKHR"));
+        assert(vk_cmd_draw_indexed_indirect_count);
+    }
+
 #ifndef NDEBUG
     if (enable_vulkan_debug_markers) {
         spdlog::debug("Initializing Vulkan debug markers.");
@@ -242,6 +315,8 @@ Device::Device(const VkInstance instance, const VkSurfaceKHR surface, bool enabl
     if (use_distinct_data_transfer_queue) {
         // Use a separate queue for data transfer to GPU.
         vkGetDeviceQueue(device, transfer_queue_family_index, 0, &transfer_queue);
+    } else {
+        transfer_queue = graphics_queue;
     }
 
     spdlog::debug("Created device successfully.");
@@ -253,6 +328,17 @@ Device::~Device() {
     vkDestroyDevice(device, nullptr);
 }
 
+void Device::draw_indexed_indirect_count(const VkCommandBuffer command_buffer, const VkBuffer buffer,
+                                         const VkDeviceSize offset, const VkBuffer count_buffer,
+                                         const VkDeviceSize count_buffer_offset, const std::uint32_t max_draw_count,
+                                         const std::uint32_t stride) const {
+    assert(command_buffer);
+    assert(vk_cmd_draw_indexed_indirect_count);
+
+    vk_cmd_draw_indexed_indirect_count(command_buffer, buffer, offset, count_buffer, count_buffer_offset,
+                                       max_draw_count, stride);
+}
+
 #ifndef NDEBUG
 void Device::set_object_name(const std::uint64_t object, const VkDebugReportObjectTypeEXT type,
                              const std::string &name) {
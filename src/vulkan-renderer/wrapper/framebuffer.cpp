@@ -10,45 +10,36 @@ Framebuffer::Framebuffer(Framebuffer &&other) noexcept
     : device(other.device), name(std::move(other.name)), frames(std::move(other.frames)) {}
 
 Framebuffer::Framebuffer(const VkDevice device, const VkRenderPass renderpass,
-                         std::vector<VkImageView> attachments,
-                         const std::vector<VkImageView> &swapchain_attachments, const std::uint32_t width,
-                         const std::uint32_t height, const std::uint32_t swapchain_image_count,
-                         const bool multisampling_enabled, const std::string name)
+                         const std::vector<std::vector<VkImageView>> &frame_attachments, const std::uint32_t width,
+                         const std::uint32_t height, const std::string name)
     : device(device), name(std::move(name)) {
     assert(device);
     assert(renderpass);
-    assert(!name.empty());
-    assert(!attachments.empty());
+    assert(!this->name.empty());
+    assert(!frame_attachments.empty());
     assert(width > 0);
     assert(height > 0);
-    assert(swapchain_image_count > 0);
 
     spdlog::debug("Creating frame buffers.");
-    spdlog::debug("Number of images in swapchain: {}.", swapchain_image_count);
+    spdlog::debug("Number of frames: {}.", frame_attachments.size());
 
     VkFramebufferCreateInfo framebuffer_ci = {};
     framebuffer_ci.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
     framebuffer_ci.renderPass = renderpass;
-    framebuffer_ci.attachmentCount = static_cast<std::uint32_t>(attachments.size());
-    framebuffer_ci.pAttachments = attachments.data();
     framebuffer_ci.width = width;
     framebuffer_ci.height = height;
     framebuffer_ci.layers = 1;
 
-    frames.resize(swapchain_image_count);
+    frames.resize(frame_attachments.size());
 
-    // Create one frame buffer for every image in swap chain.
-    for (std::size_t i = 0; i < swapchain_image_count; i++) {
+    for (std::size_t i = 0; i < frame_attachments.size(); i++) {
         spdlog::debug("Creating framebuffer #{}.", i);
 
-        if (multisampling_enabled) {
-            attachments[1] = swapchain_attachments[i];
-        } else {
-            attachments[0] = swapchain_attachments[i];
-        }
+        framebuffer_ci.attachmentCount = static_cast<std::uint32_t>(frame_attachments[i].size());
+        framebuffer_ci.pAttachments = frame_attachments[i].data();
 
         if (vkCreateFramebuffer(device, &framebuffer_ci, nullptr, &frames[i])) {
-            throw std::runtime_error("Error: vkCreateFramebuffer failed for framebuffer " + name + " !");
+            throw std::runtime_error("Error: vkCreateFramebuffer failed for framebuffer " + this->name + " !");
         }
     }
 
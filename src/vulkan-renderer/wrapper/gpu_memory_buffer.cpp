@@ -3,11 +3,13 @@
 #include <spdlog/spdlog.h>
 
 #include <cassert>
+#include <utility>
 
 namespace inexor::vulkan_renderer::wrapper {
 
 GPUMemoryBuffer::GPUMemoryBuffer(GPUMemoryBuffer &&other) noexcept
-    : name(std::move(name)), device(std::exchange(other.device, nullptr)), buffer(std::exchange(other.buffer, nullptr)),
+    : name(std::move(other.name)), device(other.device), vma_allocator(other.vma_allocator),
+      buffer(std::exchange(other.buffer, nullptr)), buffer_size(other.buffer_size),
       allocation(std::exchange(other.allocation, nullptr)), allocation_info(std::move(other.allocation_info)),
       allocation_ci(std::move(other.allocation_ci)) {}
 
@@ -8,24 +8,22 @@ namespace inexor::vulkan_renderer::wrapper {
 
 GraphicsPipeline::GraphicsPipeline(GraphicsPipeline &&other) noexcept
     : device(other.device), graphics_pipeline(std::exchange(other.graphics_pipeline, nullptr)),
-      pipeline_cache(std::exchange(other.pipeline_cache, nullptr)), name(std::move(other.name)) {}
+      name(std::move(other.name)) {}
 
-GraphicsPipeline::GraphicsPipeline(const VkDevice device, const VkPipelineLayout pipeline_layout,
-                                   const VkRenderPass render_pass,
+GraphicsPipeline::GraphicsPipeline(const VkDevice device, const VkPipelineCache pipeline_cache,
+                                   const VkPipelineLayout pipeline_layout, const VkRenderPass render_pass,
                                    const std::vector<VkPipelineShaderStageCreateInfo> &shader_stages,
                                    const VkVertexInputBindingDescription vertex_binding,
                                    const std::vector<VkVertexInputAttributeDescription> &attribute_binding,
-                                   const std::uint32_t window_width, const std::uint32_t window_height,
                                    const bool multisampling_enabled, const std::string &name)
     : device(device), name(name) {
 
     assert(device);
+    assert(pipeline_cache);
     assert(pipeline_layout);
     assert(render_pass);
     assert(!shader_stages.empty());
     assert(!attribute_binding.empty());
-    assert(window_width > 0);
-    assert(window_height > 0);
     assert(!name.empty());
 
     VkPipelineVertexInputStateCreateInfo vertex_input_ci = {};
@@ -41,27 +39,15 @@ GraphicsPipeline::GraphicsPipeline(const VkDevice device, const VkPipelineLayout
     input_assembly_ci.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
     input_assembly_ci.primitiveRestartEnable = VK_FALSE;
 
-    // TODO: Make viewport a parameter.
-    VkViewport view_port = {};
-    view_port.x = 0.0f;
-    view_port.y = 0.0f;
-    view_port.width = static_cast<float>(window_width);
-    view_port.height = static_cast<float>(window_height);
-    view_port.minDepth = 0.0f;
-    view_port.maxDepth = 1.0f;
-
-    // TODO: Make scissor a parameter.
-    VkRect2D scissor = {};
-    scissor.offset = {0, 0};
-    scissor.extent = {window_width, window_height};
-
+    // The viewport and the scissor are set when recording, so their values are ignored here. This way the pipeline
+    // does not have to be recreated when the size of the render targets changes.
     // TODO: Examine how creating multiple viewports and scissors at once could be useful.
     VkPipelineViewportStateCreateInfo viewport_state_ci = {};
     viewport_state_ci.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
     viewport_state_ci.viewportCount = 1;
-    viewport_state_ci.pViewports = &view_port;
+    viewport_state_ci.pViewports = nullptr;
     viewport_state_ci.scissorCount = 1;
-    viewport_state_ci.pScissors = &scissor;
+    viewport_state_ci.pScissors = nullptr;
 
     // TODO: Improve multisampling parameters: support other than 4 samples.
     VkPipelineMultisampleStateCreateInfo multisample_state_ci = {};
@@ -122,6 +108,7 @@ GraphicsPipeline::GraphicsPipeline(const VkDevice device, const VkPipelineLayout
 
     // TODO: Parameterize this.
     // Tell Vulkan that we want to change viewport and scissor during runtime so it's a dynamic state.
+    // The command buffers must call vkCmdSetViewport and vkCmdSetScissor before every draw with this pipeline.
     const std::vector<VkDynamicState> enabled_dynamic_states = {VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR};
 
     VkPipelineDynamicStateCreateInfo dynamic_state_ci = {};
@@ -150,17 +137,6 @@ GraphicsPipeline::GraphicsPipeline(const VkDevice device, const VkPipelineLayout
     pipeline_ci.basePipelineHandle = VK_NULL_HANDLE;
     pipeline_ci.basePipelineIndex = -1;
 
-    spdlog::debug("Creating cache for graphics pipeline.");
-
-    VkPipelineCacheCreateInfo cache_ci = {};
-    cache_ci.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
-
-    if (vkCreatePipelineCache(device, &cache_ci, nullptr, &pipeline_cache) != VK_SUCCESS) {
-        throw std::runtime_error("Error: vkCreatePipelineCache failed for " + name + " !");
-    }
-
-    // TODO: Assign an internal name to this pipeline cache using Vulkan debug markers!
-
     spdlog::debug("Creating graphics pipeline.");
 
     if (vkCreateGraphicsPipelines(device, pipeline_cache, 1, &pipeline_ci, nullptr, &graphics_pipeline) != VK_SUCCESS) {
@@ -169,13 +145,10 @@ GraphicsPipeline::GraphicsPipeline(const VkDevice device, const VkPipelineLayout
 
     // TODO: Assign an internal name to this graphics pipeline using Vulkan debug markers!
 
-    spdlog::debug("Created graphics pipeline and cache successfully.");
+    spdlog::debug("Created graphics pipeline successfully.");
 }
 
 GraphicsPipeline::~GraphicsPipeline() {
-    spdlog::trace("Destroying pipeline cache {}.", name);
-    vkDestroyPipelineCache(device, pipeline_cache, nullptr);
-
     spdlog::trace("Destroying pipeline {}.", name);
     vkDestroyPipeline(device, graphics_pipeline, nullptr);
 }
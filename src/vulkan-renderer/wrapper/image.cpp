@@ -2,22 +2,26 @@
 
 #include <spdlog/spdlog.h>
 
+#include <utility>
+
 namespace inexor::vulkan_renderer::wrapper {
 
 Image::Image(Image &&other) noexcept
-    : device(other.device), vma_allocator(other.vma_allocator), allocation(other.allocation),
-      allocation_info(other.allocation_info), image(other.image), format(other.format), image_view(other.image_view),
-      name(std::move(other.name)) {}
+    : device(other.device), vma_allocator(other.vma_allocator), allocation(std::exchange(other.allocation, nullptr)),
+      allocation_info(other.allocation_info), image(std::exchange(other.image, nullptr)), format(other.format),
+      image_view(std::exchange(other.image_view, nullptr)), name(std::move(other.name)) {}
 
 Image::Image(const VkDevice device, const VkPhysicalDevice graphics_card, const VmaAllocator vma_allocator,
              const VkFormat format, const VkImageUsageFlags image_usage, const VkImageAspectFlags aspect_flags,
-             const VkSampleCountFlagBits sample_count, const std::string &name, const VkExtent2D image_extent)
+             const VkSampleCountFlagBits sample_count, const std::string &name, const VkExtent2D image_extent,
+             const std::uint32_t mip_levels)
     : device(device), vma_allocator(vma_allocator), format(format), name(name) {
     assert(device);
     assert(graphics_card);
     assert(vma_allocator);
     assert(image_extent.width > 0);
     assert(image_extent.height > 0);
+    assert(mip_levels > 0);
     assert(!name.empty());
 
     VkImageCreateInfo image_ci = {};
@@ -26,7 +30,7 @@ Image::Image(const VkDevice device, const VkPhysicalDevice graphics_card, const
     image_ci.extent.width = image_extent.width;
     image_ci.extent.height = image_extent.height;
     image_ci.extent.depth = 1;
-    image_ci.mipLevels = 1;
+    image_ci.mipLevels = mip_levels;
     image_ci.arrayLayers = 1;
     image_ci.format = format;
     image_ci.tiling = VK_IMAGE_TILING_OPTIMAL;
@@ -59,7 +63,7 @@ Image::Image(const VkDevice device, const VkPhysicalDevice graphics_card, const
     image_view_ci.format = format;
     image_view_ci.subresourceRange.aspectMask = aspect_flags;
     image_view_ci.subresourceRange.baseMipLevel = 0;
-    image_view_ci.subresourceRange.levelCount = 1;
+    image_view_ci.subresourceRange.levelCount = mip_levels;
     image_view_ci.subresourceRange.baseArrayLayer = 0;
     image_view_ci.subresourceRange.layerCount = 1;
 
@@ -0,0 +1,97 @@
+#include "inexor/vulkan-renderer/wrapper/indirect_draw_buffer.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+namespace inexor::vulkan_renderer::wrapper {
+
+namespace {
+
+/// @brief Returns the size of a frame's region, which is rounded up so every region is aligned.
+VkDeviceSize get_frame_size(const std::uint32_t max_draw_count) {
+    const VkDeviceSize size =
+        IndirectDrawBuffer::FIRST_COMMAND_OFFSET + IndirectDrawBuffer::COMMAND_STRIDE * VkDeviceSize{max_draw_count};
+    return (size + IndirectDrawBuffer::REGION_ALIGNMENT - 1) & ~(IndirectDrawBuffer::REGION_ALIGNMENT - 1);
+}
+
+} // namespace
+
+IndirectDrawBuffer::IndirectDrawBuffer(const VkDevice &device, const VmaAllocator &vma_allocator,
+                                       const std::string &name, const std::uint32_t max_draw_count,
+                                       const std::uint32_t frame_count)
+    : GPUMemoryBuffer(device, vma_allocator, name, get_frame_size(max_draw_count) * frame_count,
+                      VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                      VMA_MEMORY_USAGE_CPU_TO_GPU),
+      max_draw_count(max_draw_count), frame_count(frame_count), frame_size(get_frame_size(max_draw_count)) {
+    assert(max_draw_count > 0);
+    assert(frame_count > 0);
+    assert(allocation_info.pMappedData);
+
+    // Every region draws nothing until its first draw commands are written.
+    std::memset(allocation_info.pMappedData, 0, frame_size * frame_count);
+
+    spdlog::debug("Created indirect draw buffer '{}' for {} draws per frame.", name, max_draw_count);
+}
+
+void IndirectDrawBuffer::begin_frame(const std::uint32_t frame_index) {
+    assert(frame_index < frame_count);
+
+    frame_begin = frame_index * frame_size;
+    draw_count = 0;
+}
+
+void IndirectDrawBuffer::write(const VkDrawIndexedIndirectCommand *commands, const std::uint32_t count) {
+    assert(commands || count == 0);
+
+    if (count > max_draw_count) {
+        throw std::runtime_error("Error: Indirect draw buffer " + name + " can only hold " +
+                                 std::to_string(max_draw_count) + " draws per frame, but " + std::to_string(count) +
+                                 " draws have been written!");
+    }
+
+    auto *region = static_cast<std::byte *>(allocation_info.pMappedData) + frame_begin;
+
+    std::memcpy(region, &count, sizeof(count));
+    if (count > 0) {
+        std::memcpy(region + FIRST_COMMAND_OFFSET, commands, COMMAND_STRIDE * static_cast<std::size_t>(count));
+    }
+
+    draw_count = count;
+}
+
+void IndirectDrawBuffer::begin_device_write(const std::uint32_t count) {
+    if (count > max_draw_count) {
+        throw std::runtime_error("Error: Indirect draw buffer " + name + " can only hold " +
+                                 std::to_string(max_draw_count) + " draws per frame, but " + std::to_string(count) +
+                                 " draws are written by the device!");
+    }
+
+    const std::uint32_t device_draw_count = 0;
+    std::memcpy(static_cast<std::byte *>(allocation_info.pMappedData) + frame_begin, &device_draw_count,
+                sizeof(device_draw_count));
+
+    draw_count = count;
+}
+
+std::uint32_t IndirectDrawBuffer::read_device_draw_count() const {
+    // This does nothing if the memory is host coherent.
+    vmaInvalidateAllocation(vma_allocator, allocation, frame_begin, sizeof(std::uint32_t));
+
+    std::uint32_t device_draw_count = 0;
+    std::memcpy(&device_draw_count, static_cast<const std::byte *>(allocation_info.pMappedData) + frame_begin,
+                sizeof(device_draw_count));
+    return device_draw_count;
+}
+
+void IndirectDrawBuffer::flush() {
+    const VkDeviceSize used_size = FIRST_COMMAND_OFFSET + COMMAND_STRIDE * VkDeviceSize{draw_count};
+
+    // This does nothing if the memory is host coherent.
+    vmaFlushAllocation(vma_allocator, allocation, frame_begin, used_size);
+}
+
+} // namespace inexor::vulkan_renderer::wrapper
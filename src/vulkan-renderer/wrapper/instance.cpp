@@ -14,7 +14,7 @@ Instance::Instance(const std::string &application_name, const std::string &engin
                    const std::uint32_t application_version, const std::uint32_t engine_version,
                    const std::uint32_t vulkan_api_version, std::vector<std::string> requested_instance_extensions,
                    std::vector<std::string> requested_instance_layers, bool enable_validation_layers,
-                   bool enable_renderdoc_instance_layer) {
+                   bool enable_renderdoc_instance_layer, bool enable_window_surface) {
     assert(!application_name.empty());
     assert(!engine_name.empty());
 
@@ -49,22 +49,27 @@ Instance::Instance(const std::string &application_name, const std::string &engin
 #endif
     };
 
-    std::uint32_t glfw_extension_count = 0;
+    // Headless rendering does not need a window, so GLFW does not have to be initialised.
+    if (enable_window_surface) {
+        std::uint32_t glfw_extension_count = 0;
 
-    // Because this requires some dynamic libraries to be loaded, this may take even up to some seconds!
-    auto *glfw_extensions = glfwGetRequiredInstanceExtensions(&glfw_extension_count);
+        // Because this requires some dynamic libraries to be loaded, this may take even up to some seconds!
+        auto *glfw_extensions = glfwGetRequiredInstanceExtensions(&glfw_extension_count);
 
-    if (glfw_extension_count == 0) {
-        throw std::runtime_error(
-            "Error: glfwGetRequiredInstanceExtensions results 0 as number of required instance extensions!");
-    }
+        if (glfw_extension_count == 0) {
+            throw std::runtime_error(
+                "Error: glfwGetRequiredInstanceExtensions results 0 as number of required instance extensions!");
+        }
 
-    spdlog::debug("Required GLFW instance extensions:");
+        spdlog::debug("Required GLFW instance extensions:");
 
-    // Add all instance extensions which are required by GLFW to our wishlist.
-    for (std::size_t i = 0; i < glfw_extension_count; i++) {
-        spdlog::debug(glfw_extensions[i]);
-        instance_extension_wishlist.push_back(glfw_extensions[i]);
+        // Add all instance extensions which are required by GLFW to our wishlist.
+        for (std::size_t i = 0; i < glfw_extension_count; i++) {
+            spdlog::debug(glfw_extensions[i]);
+            instance_extension_wishlist.push_back(glfw_extensions[i]);
+        }
+    } else {
+        spdlog::debug("No window surface requested, skipping GLFW instance extensions.");
     }
 
     // We have to check which instance extensions of our wishlist are available on the current system!
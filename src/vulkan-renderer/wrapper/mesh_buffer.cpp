@@ -1,5 +1,4 @@
 #include "inexor/vulkan-renderer/wrapper/mesh_buffer.hpp"
-#include "inexor/vulkan-renderer/wrapper/staging_buffer.hpp"
 
 #include <spdlog/spdlog.h>
 
@@ -10,8 +9,7 @@ MeshBuffer::MeshBuffer(MeshBuffer &&other) noexcept
       index_buffer(std::move(other.index_buffer)), number_of_vertices(other.number_of_vertices),
       number_of_indices(other.number_of_indices) {}
 
-MeshBuffer::MeshBuffer(const VkDevice device, VkQueue data_transfer_queue,
-                       const std::uint32_t data_transfer_queue_family_index, const VmaAllocator vma_allocator,
+MeshBuffer::MeshBuffer(const VkDevice device, UploadManager &upload_manager, const VmaAllocator vma_allocator,
                        const std::string &name, const VkDeviceSize size_of_vertex_structure,
                        const std::size_t number_of_vertices, void *vertices, const VkDeviceSize size_of_index_structure,
                        const std::size_t number_of_indices, void *indices)
@@ -41,29 +39,18 @@ MeshBuffer::MeshBuffer(const VkDevice device, VkQueue data_transfer_queue,
             "Always use an index buffer if possible! Not using an index buffer decreases performance drastically!");
     }
 
-    VkDeviceSize vertices_memory_size = number_of_vertices * size_of_vertex_structure;
-
-    StagingBuffer staging_buffer_for_vertices(device, vma_allocator, data_transfer_queue,
-                                              data_transfer_queue_family_index, name, vertex_buffer_size, vertices,
-                                              vertices_memory_size);
-
-    staging_buffer_for_vertices.upload_data_to_gpu(vertex_buffer);
+    upload_manager.upload_buffer(vertex_buffer.get_buffer(), vertices, vertex_buffer_size, 0,
+                                 VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT);
 
     if (number_of_indices > 0) {
-        VkDeviceSize indices_memory_size = number_of_indices * size_of_index_structure;
-
-        StagingBuffer staging_buffer_for_indices(device, vma_allocator, data_transfer_queue,
-                                                 data_transfer_queue_family_index, name, index_buffer_size, indices,
-                                                 indices_memory_size);
-
-        staging_buffer_for_indices.upload_data_to_gpu(*index_buffer);
+        upload_manager.upload_buffer(index_buffer->get_buffer(), indices, index_buffer_size, 0,
+                                     VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_INDEX_READ_BIT);
     } else {
         spdlog::warn("No index buffer created for mesh {}", name);
     }
 }
 
-MeshBuffer::MeshBuffer(const VkDevice device, VkQueue data_transfer_queue,
-                       const std::uint32_t data_transfer_queue_family_index, const VmaAllocator vma_allocator,
+MeshBuffer::MeshBuffer(const VkDevice device, UploadManager &upload_manager, const VmaAllocator vma_allocator,
                        const std::string &name, const VkDeviceSize size_of_vertex_structure,
                        const std::size_t number_of_vertices, void *vertices)
     // It's no problem to create the vertex buffer and index buffer before the corresponding staging buffers are
@@ -85,13 +72,8 @@ MeshBuffer::MeshBuffer(const VkDevice device, VkQueue data_transfer_queue,
     spdlog::warn("Creating a vertex buffer without an index buffer!");
     spdlog::warn("Always use an index buffer if possible. The performance will decrease drastically otherwise!");
 
-    VkDeviceSize vertices_memory_size = size_of_vertex_structure * number_of_vertices;
-
-    StagingBuffer staging_buffer_for_vertices(device, vma_allocator, data_transfer_queue,
-                                              data_transfer_queue_family_index, name, size_of_vertex_buffer, vertices,
-                                              vertices_memory_size);
-
-    staging_buffer_for_vertices.upload_data_to_gpu(vertex_buffer);
+    upload_manager.upload_buffer(vertex_buffer.get_buffer(), vertices, size_of_vertex_buffer, 0,
+                                 VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_ACCESS_VERTEX_ATTRIBUTE_READ_BIT);
 }
 
 MeshBuffer::~MeshBuffer() {}
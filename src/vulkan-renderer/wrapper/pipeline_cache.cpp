@@ -0,0 +1,153 @@
+#include "inexor/vulkan-renderer/wrapper/pipeline_cache.hpp"
+
+#include "inexor/vulkan-renderer/io/byte_stream.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace inexor::vulkan_renderer::wrapper {
+
+namespace {
+
+/// The identifier at the beginning of every pipeline cache file.
+constexpr std::uint32_t PIPELINE_CACHE_FILE_MAGIC = 0x43505849; // "IXPC"
+
+/// The version of the header, which must be increased whenever its layout changes.
+constexpr std::uint32_t PIPELINE_CACHE_FILE_VERSION = 1;
+
+/// @brief The header in front of the pipeline cache data in a pipeline cache file.
+struct PipelineCacheFileHeader {
+    std::uint32_t magic;
+    std::uint32_t version;
+    std::uint32_t vendor_id;
+    std::uint32_t device_id;
+    std::uint32_t driver_version;
+    std::uint8_t pipeline_cache_uuid[VK_UUID_SIZE];
+    std::uint32_t reserved;
+    std::uint64_t data_size;
+};
+
+// The header is compared with memcmp, so it must not contain any padding.
+static_assert(sizeof(PipelineCacheFileHeader) == 48);
+
+/// @brief Fills in the header for the data of a pipeline cache.
+PipelineCacheFileHeader make_header(const VkPhysicalDeviceProperties &properties, const std::uint64_t data_size) {
+    PipelineCacheFileHeader header = {};
+    header.magic = PIPELINE_CACHE_FILE_MAGIC;
+    header.version = PIPELINE_CACHE_FILE_VERSION;
+    header.vendor_id = properties.vendorID;
+    header.device_id = properties.deviceID;
+    header.driver_version = properties.driverVersion;
+    std::memcpy(header.pipeline_cache_uuid, properties.pipelineCacheUUID, VK_UUID_SIZE);
+    header.data_size = data_size;
+    return header;
+}
+
+} // namespace
+
+PipelineCache::PipelineCache(PipelineCache &&other) noexcept
+    : device(other.device), pipeline_cache(std::exchange(other.pipeline_cache, nullptr)),
+      graphics_card_properties(other.graphics_card_properties), file_name(std::move(other.file_name)),
+      loaded_from_file(other.loaded_from_file) {}
+
+PipelineCache::PipelineCache(const VkDevice device, const VkPhysicalDevice graphics_card,
+                             const std::string &file_name)
+    : device(device), file_name(file_name) {
+    assert(device);
+    assert(graphics_card);
+    assert(!file_name.empty());
+
+    vkGetPhysicalDeviceProperties(graphics_card, &graphics_card_properties);
+
+    // The file does not exist on the first run, which leaves the data empty.
+    const io::ByteStream file(file_name);
+    const std::vector<std::uint8_t> &file_data = file.buffer();
+
+    VkPipelineCacheCreateInfo cache_ci = {};
+    cache_ci.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+
+    if (file_data.size() >= sizeof(PipelineCacheFileHeader)) {
+        PipelineCacheFileHeader header;
+        std::memcpy(&header, file_data.data(), sizeof(header));
+
+        const auto expected_header = make_header(graphics_card_properties, file_data.size() - sizeof(header));
+
+        if (std::memcmp(&header, &expected_header, sizeof(header)) == 0) {
+            cache_ci.initialDataSize = static_cast<std::size_t>(header.data_size);
+            cache_ci.pInitialData = file_data.data() + sizeof(header);
+        } else {
+            spdlog::warn("Ignoring pipeline cache file {} because it has been created for another graphics card or "
+                         "driver version, or because it is damaged.",
+                         file_name);
+        }
+    } else if (!file_data.empty()) {
+        spdlog::warn("Ignoring pipeline cache file {} because it is truncated.", file_name);
+    }
+
+    spdlog::debug("Creating pipeline cache with {} bytes of initial data.", cache_ci.initialDataSize);
+
+    // The driver validates the initial data as well, so an implementation may still ignore it.
+    if (vkCreatePipelineCache(device, &cache_ci, nullptr, &pipeline_cache) != VK_SUCCESS) {
+        throw std::runtime_error("Error: vkCreatePipelineCache failed!");
+    }
+
+    loaded_from_file = cache_ci.initialDataSize > 0;
+
+    // TODO: Assign an internal name to this pipeline cache using Vulkan debug markers!
+}
+
+PipelineCache::~PipelineCache() {
+    spdlog::trace("Destroying pipeline cache.");
+    vkDestroyPipelineCache(device, pipeline_cache, nullptr);
+}
+
+bool PipelineCache::save() const {
+    assert(pipeline_cache);
+
+    std::size_t data_size = 0;
+    if (vkGetPipelineCacheData(device, pipeline_cache, &data_size, nullptr) != VK_SUCCESS) {
+        spdlog::error("Could not get the size of the pipeline cache data!");
+        return false;
+    }
+
+    std::vector<std::uint8_t> data(data_size);
+    if (vkGetPipelineCacheData(device, pipeline_cache, &data_size, data.data()) != VK_SUCCESS) {
+        spdlog::error("Could not get the pipeline cache data!");
+        return false;
+    }
+
+    const auto header = make_header(graphics_card_properties, data_size);
+    const std::string temporary_file_name = file_name + ".tmp";
+
+    {
+        std::ofstream file(temporary_file_name, std::ios::out | std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data_size));
+
+        if (!file) {
+            spdlog::error("Could not write pipeline cache file {}!", temporary_file_name);
+            return false;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary_file_name, file_name, error);
+    if (error) {
+        spdlog::error("Could not rename {} to {}: {}", temporary_file_name, file_name, error.message());
+        return false;
+    }
+
+    spdlog::debug("Saved {} bytes of pipeline cache data to {}.", data_size, file_name);
+
+    return true;
+}
+
+} // namespace inexor::vulkan_renderer::wrapper
@@ -11,7 +11,7 @@ PipelineLayout::PipelineLayout(PipelineLayout &&other) noexcept
       name(std::move(other.name)) {}
 
 PipelineLayout::PipelineLayout(const VkDevice device, const std::vector<VkDescriptorSetLayout> &descriptor_set_layouts,
-                               const std::string &name)
+                               const std::vector<VkPushConstantRange> &push_constant_ranges, const std::string &name)
     : device(device), name(name) {
     assert(device);
     assert(!descriptor_set_layouts.empty());
@@ -21,6 +21,8 @@ PipelineLayout::PipelineLayout(const VkDevice device, const std::vector<VkDescri
     pipeline_layout_ci.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
     pipeline_layout_ci.setLayoutCount = static_cast<std::uint32_t>(descriptor_set_layouts.size());
     pipeline_layout_ci.pSetLayouts = descriptor_set_layouts.data();
+    pipeline_layout_ci.pushConstantRangeCount = static_cast<std::uint32_t>(push_constant_ranges.size());
+    pipeline_layout_ci.pPushConstantRanges = push_constant_ranges.data();
 
     spdlog::debug("Creating pipeline layout {}.", name);
 
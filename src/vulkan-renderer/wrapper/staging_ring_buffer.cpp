@@ -0,0 +1,63 @@
+#include "inexor/vulkan-renderer/wrapper/staging_ring_buffer.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+
+namespace inexor::vulkan_renderer::wrapper {
+
+StagingRingBuffer::StagingRingBuffer(const VkDevice &device, const VmaAllocator &vma_allocator,
+                                     const std::string &name, const VkDeviceSize size, const VkDeviceSize alignment)
+    : GPUMemoryBuffer(device, vma_allocator, name, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, VMA_MEMORY_USAGE_CPU_ONLY),
+      size(size), alignment(alignment) {
+    assert(size > 0);
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+    assert(allocation_info.pMappedData);
+
+    spdlog::debug("Created staging ring buffer '{}' with {} bytes.", name, size);
+}
+
+std::optional<VkDeviceSize> StagingRingBuffer::allocate(const void *data, const VkDeviceSize data_size) {
+    assert(data);
+    assert(data_size > 0);
+
+    // Start at the beginning of the buffer whenever the ring is empty, so the whole buffer is available.
+    if (head == tail) {
+        head = (head + size - 1) / size * size;
+        tail = head;
+    }
+
+    const VkDeviceSize head_offset = head % size;
+    VkDeviceSize offset = (head_offset + alignment - 1) & ~(alignment - 1);
+
+    // Skip the rest of the buffer if the data does not fit in there. The skipped bytes are released along with the
+    // allocation.
+    if (offset + data_size > size) {
+        offset = 0;
+    }
+
+    const VkDeviceSize padding = offset >= head_offset ? offset - head_offset : size - head_offset;
+
+    if (get_used_size() + padding + data_size > size) {
+        return std::nullopt;
+    }
+
+    std::memcpy(static_cast<std::byte *>(allocation_info.pMappedData) + offset, data,
+                static_cast<std::size_t>(data_size));
+
+    head += padding + data_size;
+
+    return offset;
+}
+
+void StagingRingBuffer::release(const std::uint64_t mark) {
+    assert(mark <= head);
+
+    if (mark > tail) {
+        tail = mark;
+    }
+}
+
+} // namespace inexor::vulkan_renderer::wrapper
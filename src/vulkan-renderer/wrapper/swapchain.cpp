@@ -137,18 +137,19 @@ Swapchain::Swapchain(const VkDevice device, const VkPhysicalDevice graphics_card
     setup_swapchain(VK_NULL_HANDLE, window_width, window_height);
 }
 
-void Swapchain::recreate(std::uint32_t window_width, std::uint32_t window_height) {
+void Swapchain::recreate(std::uint32_t window_width, std::uint32_t window_height, DeletionQueue &deletion_queue) {
     // Store the old swapchain. This allows us to pass it to VkSwapchainCreateInfoKHR::oldSwapchain to speed up
     // swapchain recreation.
     VkSwapchainKHR old_swapchain = swapchain;
 
-    // When swapchain needs to be recreated, all the old swapchain images need to be destroyed.
-
-    // Unlike swapchain images, the image views were created by us directly.
-    // It is our job to destroy them again.
-    for (auto *image_view : swapchain_image_views) {
-        vkDestroyImageView(device, image_view, nullptr);
-    }
+    // Frames which are still in flight might use the old swapchain images, so the old swapchain and the image views,
+    // which were created by us directly, are destroyed once those frames have finished.
+    deletion_queue.push([device = device, old_swapchain, old_image_views = std::move(swapchain_image_views)] {
+        for (auto *image_view : old_image_views) {
+            vkDestroyImageView(device, image_view, nullptr);
+        }
+        vkDestroySwapchainKHR(device, old_swapchain, nullptr);
+    });
 
     swapchain_image_views.clear();
 
@@ -1,166 +1,151 @@
 #include "inexor/vulkan-renderer/wrapper/texture.hpp"
-#include "inexor/vulkan-renderer/wrapper/staging_buffer.hpp"
 
-#define STB_IMAGE_IMPLEMENTATION
+#include "inexor/vulkan-renderer/tools/mip_chain.hpp"
+
 #include <spdlog/spdlog.h>
-#include <stb_image.h>
 #include <vma/vk_mem_alloc.h>
 
+#include <cstdint>
+#include <vector>
+
 namespace inexor::vulkan_renderer::wrapper {
 
 Texture::Texture(Texture &&other) noexcept
     : texture_image(std::exchange(other.texture_image, nullptr)), name(std::move(other.name)),
       file_name(std::move(other.file_name)), texture_width(other.texture_width), texture_height(other.texture_height),
       texture_channels(other.texture_channels), mip_levels(other.mip_levels), device(other.device),
-      graphics_card(other.graphics_card), data_transfer_queue(other.data_transfer_queue),
-      vma_allocator(other.vma_allocator), sampler(std::exchange(other.sampler, nullptr)),
-      texture_image_format(other.texture_image_format), copy_command_buffer(std::move(other.copy_command_buffer)) {}
+      graphics_card(other.graphics_card), vma_allocator(other.vma_allocator),
+      sampler(std::exchange(other.sampler, nullptr)), texture_image_format(other.texture_image_format) {}
 
 Texture::Texture(const VkDevice device, const VkPhysicalDevice graphics_card, const VmaAllocator vma_allocator,
                  void *texture_data, const std::size_t texture_size, const std::string &name,
-                 const VkQueue data_transfer_queue, const std::uint32_t data_transfer_queue_family_index)
-    : name(name), file_name(file_name), device(device), graphics_card(graphics_card),
-      data_transfer_queue(data_transfer_queue), vma_allocator(vma_allocator),
-      copy_command_buffer(device, data_transfer_queue, data_transfer_queue_family_index) {
+                 UploadManager &upload_manager)
+    : name(name), file_name(file_name), device(device), graphics_card(graphics_card), vma_allocator(vma_allocator) {
 
-    create_texture(texture_data, texture_size);
+    create_texture(texture_data, texture_size, upload_manager);
 }
 
 Texture::Texture(const VkDevice device, const VkPhysicalDevice graphics_card, const VmaAllocator vma_allocator,
-                 const std::string &file_name, const std::string &name, const VkQueue data_transfer_queue,
-                 const std::uint32_t data_transfer_queue_family_index)
-    : name(name), file_name(file_name), device(device), graphics_card(graphics_card),
-      data_transfer_queue(data_transfer_queue), data_transfer_queue_family_index(data_transfer_queue_family_index),
-      vma_allocator(vma_allocator), copy_command_buffer(device, data_transfer_queue, data_transfer_queue_family_index) {
+                 const std::string &file_name, const std::string &name, UploadManager &upload_manager)
+    : Texture(device, graphics_card, vma_allocator, io::ImageFile(file_name), name, upload_manager) {}
+
+Texture::Texture(const VkDevice device, const VkPhysicalDevice graphics_card, const VmaAllocator vma_allocator,
+                 const io::ImageFile &image_file, const std::string &name, UploadManager &upload_manager)
+    : name(name), file_name(image_file.get_file_name()), device(device), graphics_card(graphics_card),
+      vma_allocator(vma_allocator) {
     assert(device);
     assert(vma_allocator);
-    assert(!file_name.empty());
     assert(!name.empty());
-    assert(data_transfer_queue);
-
-    spdlog::debug("Loading texture file {}.", file_name);
-
-    // Load the texture file using stb_image library.
-    // Force stb_image to load an alpha channel as well.
-    stbi_uc *texture_data =
-        stbi_load(file_name.c_str(), &texture_width, &texture_height, &texture_channels, STBI_rgb_alpha);
-
-    if (texture_data == nullptr) {
-        throw std::runtime_error("Error: Could not load texture file " + file_name + " using stbi_load!");
-    }
 
-    spdlog::debug("Texture dimensions: width: {}, height: {}, channels: {}.", texture_width, texture_height,
-                  texture_channels);
+    texture_width = static_cast<int>(image_file.get_width());
+    texture_height = static_cast<int>(image_file.get_height());
+    texture_channels = static_cast<int>(image_file.get_channels());
 
-    // Calculate the memory size of the texture.
-    // We need 4 times the size since we have 4 channels: red, green, blue and alpha channel.
-    VkDeviceSize texture_memory_size = 4 * texture_width * texture_height;
+    // The upload manager copies the texel data into a staging buffer, so the image file may be destroyed afterwards.
+    create_texture(image_file.get_data(), image_file.get_data_size(), upload_manager);
+}
 
-    create_texture(texture_data, texture_memory_size);
+Texture::Texture(const VkDevice device, const VkPhysicalDevice graphics_card, const VmaAllocator vma_allocator,
+                 const io::Ktx2File &ktx2_file, const std::string &name, UploadManager &upload_manager)
+    : name(name), file_name(ktx2_file.get_file_name()), device(device), graphics_card(graphics_card),
+      vma_allocator(vma_allocator) {
+    assert(device);
+    assert(vma_allocator);
+    assert(!name.empty());
 
-    // We can discard the texture data since we copied it already to GPU memory.
-    stbi_image_free(texture_data);
+    create_texture(ktx2_file, upload_manager);
 }
 
-void Texture::create_texture(void *texture_data, const std::size_t texture_size) {
+bool Texture::is_format_supported(const VkPhysicalDevice graphics_card, const VkFormat format) {
+    assert(graphics_card);
+
+    VkFormatProperties format_properties;
+    vkGetPhysicalDeviceFormatProperties(graphics_card, format, &format_properties);
 
-    // For now, we will not generate mip-maps automatically.
-    // TODO: Generate mip-maps automatically!
-    mip_levels = 1;
+    constexpr VkFormatFeatureFlags required_features =
+        VK_FORMAT_FEATURE_SAMPLED_IMAGE_BIT | VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
 
-    StagingBuffer texture_staging_buffer(device, vma_allocator, data_transfer_queue, data_transfer_queue_family_index,
-                                         name, texture_size, texture_data, texture_size);
+    return (format_properties.optimalTilingFeatures & required_features) == required_features;
+}
 
+void Texture::create_texture(const void *texture_data, const std::size_t texture_size, UploadManager &upload_manager) {
     VkExtent2D extent;
     extent.width = texture_width;
     extent.height = texture_height;
 
-    texture_image = std::make_unique<wrapper::Image>(device, graphics_card, vma_allocator, texture_image_format,
-                                                     VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
-                                                     VK_IMAGE_ASPECT_COLOR_BIT, VK_SAMPLE_COUNT_1_BIT, name, extent);
+    mip_levels = tools::calculate_mip_levels(extent.width, extent.height);
 
-    copy_command_buffer.create_command_buffer();
+    texture_image = std::make_unique<wrapper::Image>(
+        device, graphics_card, vma_allocator, texture_image_format,
+        VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+        VK_IMAGE_ASPECT_COLOR_BIT, VK_SAMPLE_COUNT_1_BIT, name, extent, mip_levels);
 
-    copy_command_buffer.start_recording();
+    // Blits with linear filtering are not supported for every format, e.g. for most integer formats.
+    VkFormatProperties format_properties;
+    vkGetPhysicalDeviceFormatProperties(graphics_card, texture_image_format, &format_properties);
 
-    spdlog::debug("Transitioning image layout of texture {} to VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL.", name);
+    constexpr VkFormatFeatureFlags required_features = VK_FORMAT_FEATURE_BLIT_SRC_BIT | VK_FORMAT_FEATURE_BLIT_DST_BIT |
+                                                       VK_FORMAT_FEATURE_SAMPLED_IMAGE_FILTER_LINEAR_BIT;
 
-    transition_image_layout(texture_image->get(), texture_image_format, VK_IMAGE_LAYOUT_UNDEFINED,
-                            VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    const bool blit_supported = (format_properties.optimalTilingFeatures & required_features) == required_features;
 
-    VkBufferImageCopy buffer_image_region = {};
+    // The upload is recorded into the current batch of the upload manager, together with all other textures and
+    // meshes. It transitions the image into VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL as well.
+    const VkExtent3D image_extent = {extent.width, extent.height, 1};
 
-    buffer_image_region.bufferOffset = 0;
-    buffer_image_region.bufferRowLength = 0;
-    buffer_image_region.bufferImageHeight = 0;
-    buffer_image_region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    buffer_image_region.imageSubresource.mipLevel = 0;
-    buffer_image_region.imageSubresource.baseArrayLayer = 0;
-    buffer_image_region.imageSubresource.layerCount = 1;
-    buffer_image_region.imageOffset = {0, 0, 0};
-    buffer_image_region.imageExtent = {static_cast<uint32_t>(texture_width), static_cast<uint32_t>(texture_height), 1};
+    if (blit_supported) {
+        spdlog::debug("Requesting upload of texture {} ({} bytes), generating {} mip levels on the graphics card.",
+                      name, texture_size, mip_levels);
 
-    vkCmdCopyBufferToImage(copy_command_buffer.get_command_buffer(), texture_staging_buffer.get_buffer(),
-                           texture_image->get(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &buffer_image_region);
-
-    spdlog::debug("Transitioning image layout of texture {} to VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL.", name);
+        upload_manager.upload_image_and_generate_mipmaps(
+            texture_image->get(), texture_data, texture_size, image_extent, mip_levels,
+            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    } else {
+        std::vector<VkDeviceSize> mip_level_offsets;
+        const auto mip_chain = tools::generate_mip_chain(static_cast<const std::uint8_t *>(texture_data),
+                                                         extent.width, extent.height, mip_levels, mip_level_offsets);
 
-    copy_command_buffer.end_recording_and_submit_command();
+        spdlog::debug("Requesting upload of texture {} ({} bytes), with {} mip levels generated on the CPU.", name,
+                      mip_chain.size(), mip_levels);
 
-    transition_image_layout(texture_image->get(), texture_image_format, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-                            VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+        upload_manager.upload_image(texture_image->get(), mip_chain.data(), mip_chain.size(), image_extent,
+                                    mip_level_offsets, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                    VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+    }
 
     create_texture_sampler();
 }
 
-void Texture::transition_image_layout(VkImage image, VkFormat format, VkImageLayout old_layout,
-                                      VkImageLayout new_layout) {
-
-    VkImageMemoryBarrier barrier = {};
-
-    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
-    barrier.oldLayout = old_layout;
-    barrier.newLayout = new_layout;
-    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
-    barrier.image = image;
-    barrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
-    barrier.subresourceRange.baseMipLevel = 0;
-    barrier.subresourceRange.levelCount = 1;
-    barrier.subresourceRange.baseArrayLayer = 0;
-    barrier.subresourceRange.layerCount = 1;
-
-    VkPipelineStageFlags source_stage = 0;
-    VkPipelineStageFlags destination_stage = 0;
-
-    if (VK_IMAGE_LAYOUT_UNDEFINED == old_layout && VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL == new_layout) {
-        barrier.srcAccessMask = 0;
-        barrier.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-
-        source_stage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-        destination_stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-    } else if (VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL == old_layout &&
-               VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL == new_layout) {
-        barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-        barrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-
-        source_stage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-        destination_stage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-    } else {
-        throw std::runtime_error("Error: unsupported layout transition!");
-    }
+void Texture::create_texture(const io::Ktx2File &ktx2_file, UploadManager &upload_manager) {
+    assert(is_format_supported(graphics_card, ktx2_file.get_format()));
 
-    spdlog::debug("Recording pipeline barrier for image layer transition");
+    texture_image_format = ktx2_file.get_format();
+    texture_width = static_cast<int>(ktx2_file.get_width());
+    texture_height = static_cast<int>(ktx2_file.get_height());
+    texture_channels = 4;
+    mip_levels = ktx2_file.get_mip_levels();
 
-    OnceCommandBuffer image_transition_change(device, data_transfer_queue, data_transfer_queue_family_index);
+    VkExtent2D extent;
+    extent.width = texture_width;
+    extent.height = texture_height;
 
-    image_transition_change.create_command_buffer();
-    image_transition_change.start_recording();
+    texture_image = std::make_unique<wrapper::Image>(device, graphics_card, vma_allocator, texture_image_format,
+                                                     VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT,
+                                                     VK_IMAGE_ASPECT_COLOR_BIT, VK_SAMPLE_COUNT_1_BIT, name, extent,
+                                                     mip_levels);
 
-    vkCmdPipelineBarrier(image_transition_change.get_command_buffer(), source_stage, destination_stage, 0, 0, nullptr,
-                         0, nullptr, 1, &barrier);
+    spdlog::debug("Requesting upload of texture {} ({} bytes) with {} mip levels from {}.", name,
+                  ktx2_file.get_data_size(), mip_levels, file_name);
 
-    image_transition_change.end_recording_and_submit_command();
+    // The mip levels are copied straight out of the file data, which is why the offsets are relative to the start of
+    // the file. Only the small header in front of the levels is copied needlessly.
+    const VkExtent3D image_extent = {extent.width, extent.height, 1};
+
+    upload_manager.upload_image(texture_image->get(), ktx2_file.get_data(), ktx2_file.get_data_size(), image_extent,
+                                ktx2_file.get_level_offsets(), VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                                VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_ACCESS_SHADER_READ_BIT);
+
+    create_texture_sampler();
 }
 
 void Texture::create_texture_sampler() {
@@ -200,7 +185,7 @@ void Texture::create_texture_sampler() {
     sampler_ci.mipmapMode = VK_SAMPLER_MIPMAP_MODE_LINEAR;
     sampler_ci.mipLodBias = 0.0f;
     sampler_ci.minLod = 0.0f;
-    sampler_ci.maxLod = 0.0f;
+    sampler_ci.maxLod = static_cast<float>(mip_levels);
 
     VkPhysicalDeviceFeatures device_features;
     vkGetPhysicalDeviceFeatures(graphics_card, &device_features);
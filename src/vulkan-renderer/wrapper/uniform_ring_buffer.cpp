@@ -0,0 +1,70 @@
+#include "inexor/vulkan-renderer/wrapper/uniform_ring_buffer.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+namespace inexor::vulkan_renderer::wrapper {
+
+namespace {
+
+/// @brief Rounds a size up to the next multiple of a power of two alignment.
+VkDeviceSize align_up(const VkDeviceSize size, const VkDeviceSize alignment) {
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+} // namespace
+
+UniformRingBuffer::UniformRingBuffer(const VkDevice &device, const VmaAllocator &vma_allocator,
+                                     const std::string &name, const VkDeviceSize frame_size,
+                                     const std::uint32_t frame_count, const VkDeviceSize alignment)
+    : GPUMemoryBuffer(device, vma_allocator, name, align_up(frame_size, alignment) * frame_count,
+                      VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, VMA_MEMORY_USAGE_CPU_TO_GPU),
+      frame_size(align_up(frame_size, alignment)), alignment(alignment), frame_count(frame_count) {
+    assert(frame_size > 0);
+    assert(frame_count > 0);
+    assert(alignment > 0 && (alignment & (alignment - 1)) == 0);
+    assert(allocation_info.pMappedData);
+
+    spdlog::debug("Created uniform ring buffer '{}' with {} bytes per frame and an alignment of {} bytes.", name,
+                  this->frame_size, alignment);
+}
+
+void UniformRingBuffer::begin_frame(const std::uint32_t frame_index) {
+    assert(frame_index < frame_count);
+
+    frame_begin = frame_index * frame_size;
+    frame_offset.store(0, std::memory_order_relaxed);
+}
+
+std::uint32_t UniformRingBuffer::allocate(const void *data, const std::size_t size) {
+    assert(data);
+    assert(size > 0);
+
+    // Only the offset is shared between threads, the memory of different allocations never overlaps.
+    const VkDeviceSize offset = frame_offset.fetch_add(align_up(size, alignment), std::memory_order_relaxed);
+
+    if (offset + size > frame_size) {
+        throw std::runtime_error("Error: Uniform ring buffer " + name + " is full! Size per frame: " +
+                                 std::to_string(frame_size) + " bytes.");
+    }
+
+    std::memcpy(static_cast<std::byte *>(allocation_info.pMappedData) + frame_begin + offset, data, size);
+
+    return static_cast<std::uint32_t>(frame_begin + offset);
+}
+
+void UniformRingBuffer::flush() {
+    const VkDeviceSize used_size = get_used_size();
+    if (used_size == 0) {
+        return;
+    }
+
+    // This does nothing if the memory is host coherent.
+    vmaFlushAllocation(vma_allocator, allocation, frame_begin, used_size);
+}
+
+} // namespace inexor::vulkan_renderer::wrapper
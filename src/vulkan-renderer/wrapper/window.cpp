@@ -26,16 +26,13 @@ Window::Window(const std::string &title, const std::uint32_t width, const std::u
     }
 }
 
-void Window::wait_for_focus() {
+void Window::update_size() {
     assert(window);
 
     int current_width = 0;
     int current_height = 0;
 
-    while (current_width == 0 || current_height == 0) {
-        glfwGetFramebufferSize(window, &current_width, &current_height);
-        glfwWaitEvents();
-    }
+    glfwGetFramebufferSize(window, &current_width, &current_height);
 
     width = current_width;
     height = current_height;
@@ -84,6 +81,12 @@ void Window::poll() {
     glfwPollEvents();
 }
 
+void Window::wait_events(const double timeout) {
+    assert(window);
+    assert(timeout > 0.0);
+    glfwWaitEventsTimeout(timeout);
+}
+
 bool Window::should_close() {
     assert(window);
     return glfwWindowShouldClose(window);
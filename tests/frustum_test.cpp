@@ -0,0 +1,121 @@
+#include "inexor/vulkan-renderer/frustum.hpp"
+
+#include <gtest/gtest.h>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <array>
+#include <random>
+
+namespace {
+
+using inexor::vulkan_renderer::Frustum;
+using Visibility = Frustum::Visibility;
+
+/// @brief Returns the frustum of a camera at the origin which looks along the negative z axis.
+/// With a field of view of 90 degrees and an aspect ratio of 1, the frustum at a distance d spans [-d, d] in x and y.
+Frustum get_test_frustum() {
+    return Frustum(glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 100.0f));
+}
+
+/// @brief Tests a box with test_box() and test_box_scalar() and checks that both agree.
+Visibility test_box(const Frustum &frustum, const glm::vec3 &min, const glm::vec3 &max) {
+    const Visibility visibility = frustum.test_box(min, max);
+    EXPECT_EQ(visibility, frustum.test_box_scalar(min, max));
+    return visibility;
+}
+
+} // namespace
+
+TEST(Frustum, BoxInside) {
+    const Frustum frustum = get_test_frustum();
+
+    EXPECT_EQ(test_box(frustum, {-1.0f, -1.0f, -10.0f}, {1.0f, 1.0f, -9.0f}), Visibility::INSIDE);
+    EXPECT_EQ(test_box(frustum, {-40.0f, -40.0f, -60.0f}, {40.0f, 40.0f, -50.0f}), Visibility::INSIDE);
+}
+
+TEST(Frustum, BoxOutside) {
+    const Frustum frustum = get_test_frustum();
+
+    // Behind the camera.
+    EXPECT_EQ(test_box(frustum, {-1.0f, -1.0f, 5.0f}, {1.0f, 1.0f, 6.0f}), Visibility::OUTSIDE);
+    // Beyond the far plane.
+    EXPECT_EQ(test_box(frustum, {-1.0f, -1.0f, -201.0f}, {1.0f, 1.0f, -200.0f}), Visibility::OUTSIDE);
+    // Right of the right plane.
+    EXPECT_EQ(test_box(frustum, {50.0f, -1.0f, -11.0f}, {52.0f, 1.0f, -9.0f}), Visibility::OUTSIDE);
+    // Below the bottom plane.
+    EXPECT_EQ(test_box(frustum, {-1.0f, -52.0f, -11.0f}, {1.0f, -50.0f, -9.0f}), Visibility::OUTSIDE);
+}
+
+TEST(Frustum, BoxIntersecting) {
+    const Frustum frustum = get_test_frustum();
+
+    // Contains the camera, so it crosses the near plane.
+    EXPECT_EQ(test_box(frustum, {-1.0f, -1.0f, -1.0f}, {1.0f, 1.0f, 1.0f}), Visibility::INTERSECTING);
+    // Crosses the left plane.
+    EXPECT_EQ(test_box(frustum, {-11.0f, -1.0f, -10.0f}, {-9.0f, 1.0f, -9.5f}), Visibility::INTERSECTING);
+    // Crosses the far plane.
+    EXPECT_EQ(test_box(frustum, {-1.0f, -1.0f, -101.0f}, {1.0f, 1.0f, -99.0f}), Visibility::INTERSECTING);
+    // Contains the whole frustum.
+    EXPECT_EQ(test_box(frustum, glm::vec3(-500.0f), glm::vec3(500.0f)), Visibility::INTERSECTING);
+}
+
+TEST(Frustum, SimdAndScalarAgree) {
+    const std::array<Frustum, 2> frustums = {
+        get_test_frustum(),
+        Frustum(glm::perspective(glm::radians(45.0f), 16.0f / 9.0f, 0.1f, 256.0f)),
+    };
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<float> coordinate(-150.0f, 150.0f);
+    std::uniform_real_distribution<float> extent(0.1f, 50.0f);
+
+    for (const auto &frustum : frustums) {
+        for (int i = 0; i < 10'000; i++) {
+            const glm::vec3 min{coordinate(generator), coordinate(generator), coordinate(generator)};
+            const glm::vec3 max = min + glm::vec3(extent(generator), extent(generator), extent(generator));
+
+            ASSERT_EQ(frustum.test_box(min, max), frustum.test_box_scalar(min, max))
+                << "box (" << min.x << ", " << min.y << ", " << min.z << ") - (" << max.x << ", " << max.y << ", "
+                << max.z << ")";
+        }
+    }
+}
+
+// Boxes which touch a plane are where a different rounding of the two paths would show.
+TEST(Frustum, SimdAndScalarAgreeOnPlanes) {
+    const Frustum frustum = get_test_frustum();
+
+    std::mt19937 generator(7);
+    std::uniform_real_distribution<float> coordinate(-100.0f, 100.0f);
+    std::uniform_real_distribution<float> extent(0.1f, 20.0f);
+
+    for (const auto &plane : frustum.planes) {
+        const glm::vec3 normal(plane);
+
+        for (int i = 0; i < 5'000; i++) {
+            // Project a random point onto the plane.
+            glm::vec3 point{coordinate(generator), coordinate(generator), coordinate(generator)};
+            point -= (glm::dot(normal, point) + plane.w) * normal;
+
+            const glm::vec3 size{extent(generator), extent(generator), extent(generator)};
+
+            // The point is the positive vertex of the first box and the negative vertex of the second box.
+            glm::vec3 outer_min;
+            glm::vec3 outer_max;
+            glm::vec3 inner_min;
+            glm::vec3 inner_max;
+            for (int axis = 0; axis < 3; axis++) {
+                const float sign = normal[axis] >= 0.0f ? 1.0f : -1.0f;
+                outer_min[axis] = std::min(point[axis], point[axis] - sign * size[axis]);
+                outer_max[axis] = std::max(point[axis], point[axis] - sign * size[axis]);
+                inner_min[axis] = std::min(point[axis], point[axis] + sign * size[axis]);
+                inner_max[axis] = std::max(point[axis], point[axis] + sign * size[axis]);
+            }
+
+            ASSERT_EQ(frustum.test_box(outer_min, outer_max), frustum.test_box_scalar(outer_min, outer_max));
+            ASSERT_EQ(frustum.test_box(inner_min, inner_max), frustum.test_box_scalar(inner_min, inner_max));
+        }
+    }
+}
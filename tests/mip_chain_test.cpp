@@ -0,0 +1,151 @@
+#include "inexor/vulkan-renderer/tools/mip_chain.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+using inexor::vulkan_renderer::tools::calculate_mip_levels;
+using inexor::vulkan_renderer::tools::generate_mip_chain;
+
+constexpr std::size_t TEXEL_SIZE = 4;
+
+/// @brief Creates an RGBA8 image whose channels are the given values plus the channel index.
+/// Since the box filter rounds the average of four texels, the channels of every filtered texel keep this offset, so
+/// mixing up channels shows in the results.
+std::vector<std::uint8_t> make_image(const std::vector<std::uint8_t> &values) {
+    std::vector<std::uint8_t> image;
+    for (const auto value : values) {
+        for (std::size_t channel = 0; channel < TEXEL_SIZE; channel++) {
+            image.push_back(static_cast<std::uint8_t>(value + channel));
+        }
+    }
+    return image;
+}
+
+/// @brief Checks the texels of a mip level against the values which were passed to make_image.
+void expect_mip_level(const std::vector<std::uint8_t> &mip_chain, const std::uint64_t offset,
+                      const std::vector<std::uint8_t> &expected_values) {
+    ASSERT_LE(offset + expected_values.size() * TEXEL_SIZE, mip_chain.size());
+
+    for (std::size_t texel = 0; texel < expected_values.size(); texel++) {
+        for (std::size_t channel = 0; channel < TEXEL_SIZE; channel++) {
+            EXPECT_EQ(mip_chain[offset + texel * TEXEL_SIZE + channel], expected_values[texel] + channel)
+                << "texel " << texel << ", channel " << channel;
+        }
+    }
+}
+
+} // namespace
+
+TEST(MipChain, CalculateMipLevels) {
+    EXPECT_EQ(calculate_mip_levels(1, 1), 1u);
+    EXPECT_EQ(calculate_mip_levels(2, 2), 2u);
+    EXPECT_EQ(calculate_mip_levels(256, 256), 9u);
+    EXPECT_EQ(calculate_mip_levels(5, 3), 3u);
+    EXPECT_EQ(calculate_mip_levels(1, 8), 4u);
+    EXPECT_EQ(calculate_mip_levels(7, 1), 3u);
+    EXPECT_EQ(calculate_mip_levels(1024, 16), 11u);
+}
+
+TEST(MipChain, NonSquareImage) {
+    // clang-format off
+    const auto image = make_image({
+         0, 10, 20, 30,
+        40, 50, 61, 71,
+    });
+    // clang-format on
+
+    std::vector<std::uint64_t> offsets;
+    const auto mip_chain = generate_mip_chain(image.data(), 4, 2, calculate_mip_levels(4, 2), offsets);
+
+    // 4x2, 2x1 and 1x1 texels.
+    ASSERT_EQ(offsets, (std::vector<std::uint64_t>{0, 32, 40}));
+    ASSERT_EQ(mip_chain.size(), 44u);
+
+    expect_mip_level(mip_chain, offsets[0], {0, 10, 20, 30, 40, 50, 61, 71});
+
+    // (0 + 10 + 40 + 50) / 4 = 25 and (20 + 30 + 61 + 71) / 4 = 45.5, which is rounded up.
+    expect_mip_level(mip_chain, offsets[1], {25, 46});
+
+    // The single row of the previous level is used twice: (25 + 46 + 25 + 46) / 4 = 35.5.
+    expect_mip_level(mip_chain, offsets[2], {36});
+}
+
+TEST(MipChain, OddExtent) {
+    // clang-format off
+    const auto image = make_image({
+          0,  10,  20,  30,  40,
+         50,  60,  70,  80,  90,
+        100, 110, 120, 130, 140,
+    });
+    // clang-format on
+
+    std::vector<std::uint64_t> offsets;
+    const auto mip_chain = generate_mip_chain(image.data(), 5, 3, calculate_mip_levels(5, 3), offsets);
+
+    // 5x3, 2x1 and 1x1 texels.
+    ASSERT_EQ(offsets, (std::vector<std::uint64_t>{0, 60, 68}));
+    ASSERT_EQ(mip_chain.size(), 72u);
+
+    // Odd extents are rounded down, so the last column and the last row do not contribute to the next level.
+    expect_mip_level(mip_chain, offsets[1], {30, 50});
+    expect_mip_level(mip_chain, offsets[2], {40});
+}
+
+TEST(MipChain, SingleColumn) {
+    const auto image = make_image({0, 100, 201, 250});
+
+    std::vector<std::uint64_t> offsets;
+    const auto mip_chain = generate_mip_chain(image.data(), 1, 4, calculate_mip_levels(1, 4), offsets);
+
+    // 1x4, 1x2 and 1x1 texels.
+    ASSERT_EQ(offsets, (std::vector<std::uint64_t>{0, 16, 24}));
+    ASSERT_EQ(mip_chain.size(), 28u);
+
+    // The single column is used twice, so every texel is the average of two texels.
+    expect_mip_level(mip_chain, offsets[1], {50, 226});
+    expect_mip_level(mip_chain, offsets[2], {138});
+}
+
+TEST(MipChain, SingleRow) {
+    const auto image = make_image({0, 100, 201, 250});
+
+    std::vector<std::uint64_t> offsets;
+    const auto mip_chain = generate_mip_chain(image.data(), 4, 1, calculate_mip_levels(4, 1), offsets);
+
+    ASSERT_EQ(offsets, (std::vector<std::uint64_t>{0, 16, 24}));
+    ASSERT_EQ(mip_chain.size(), 28u);
+
+    expect_mip_level(mip_chain, offsets[1], {50, 226});
+    expect_mip_level(mip_chain, offsets[2], {138});
+}
+
+TEST(MipChain, PartialChain) {
+    // A uniform image must stay uniform in every level.
+    const auto image = make_image(std::vector<std::uint8_t>(8 * 8, 77));
+
+    std::vector<std::uint64_t> offsets;
+    const auto mip_chain = generate_mip_chain(image.data(), 8, 8, 2, offsets);
+
+    // Only the requested levels are generated: 8x8 and 4x4 texels.
+    ASSERT_EQ(offsets, (std::vector<std::uint64_t>{0, 256}));
+    ASSERT_EQ(mip_chain.size(), 320u);
+
+    expect_mip_level(mip_chain, offsets[0], std::vector<std::uint8_t>(8 * 8, 77));
+    expect_mip_level(mip_chain, offsets[1], std::vector<std::uint8_t>(4 * 4, 77));
+}
+
+TEST(MipChain, SingleTexel) {
+    const auto image = make_image({123});
+
+    std::vector<std::uint64_t> offsets;
+    const auto mip_chain = generate_mip_chain(image.data(), 1, 1, 1, offsets);
+
+    ASSERT_EQ(offsets, (std::vector<std::uint64_t>{0}));
+    ASSERT_EQ(mip_chain.size(), TEXEL_SIZE);
+    expect_mip_level(mip_chain, offsets[0], {123});
+}
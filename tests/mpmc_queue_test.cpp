@@ -0,0 +1,135 @@
+#include "inexor/vulkan-renderer/mpmc_queue.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using inexor::MPMCQueue;
+
+/// The number of elements every producer pushes in the stress test.
+constexpr std::uint64_t STRESS_ELEMENTS_PER_PRODUCER = 20'000;
+
+/// @brief Encodes the producer and the sequence number of a stress test element into one value.
+std::uint64_t encode_element(const std::uint64_t producer, const std::uint64_t sequence) {
+    return (producer << 32) | sequence;
+}
+
+} // namespace
+
+TEST(MPMCQueue, CapacityMustBePowerOfTwo) {
+    EXPECT_THROW(MPMCQueue<int>(0), std::runtime_error);
+    EXPECT_THROW(MPMCQueue<int>(1), std::runtime_error);
+    EXPECT_THROW(MPMCQueue<int>(6), std::runtime_error);
+    EXPECT_EQ(MPMCQueue<int>(8).capacity(), 8u);
+}
+
+TEST(MPMCQueue, FirstInFirstOut) {
+    MPMCQueue<int> queue(4);
+
+    int value = 0;
+    EXPECT_FALSE(queue.try_pop(value));
+
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(queue.try_push(i));
+    }
+    EXPECT_FALSE(queue.try_push(4));
+    EXPECT_EQ(queue.size_approx(), 4u);
+
+    // Wrap around the ring buffer a few times.
+    for (int i = 4; i < 20; i++) {
+        ASSERT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, i - 4);
+        EXPECT_TRUE(queue.try_push(i));
+    }
+
+    for (int i = 16; i < 20; i++) {
+        ASSERT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.try_pop(value));
+    EXPECT_EQ(queue.size_approx(), 0u);
+}
+
+TEST(MPMCQueue, FailedPushDoesNotMoveFromValue) {
+    MPMCQueue<std::unique_ptr<int>> queue(2);
+
+    EXPECT_TRUE(queue.try_push(std::make_unique<int>(0)));
+    EXPECT_TRUE(queue.try_push(std::make_unique<int>(1)));
+
+    auto value = std::make_unique<int>(2);
+    EXPECT_FALSE(queue.try_push(std::move(value)));
+    ASSERT_NE(value, nullptr);
+    EXPECT_EQ(*value, 2);
+}
+
+// Several producers and consumers share a small queue, so it is full and empty very often. Every element must be
+// popped exactly once, and the elements of one producer must be popped in the order they have been pushed.
+TEST(MPMCQueue, StressMultipleProducersMultipleConsumers) {
+    constexpr std::uint64_t PRODUCER_COUNT = 4;
+    constexpr std::uint64_t CONSUMER_COUNT = 4;
+
+    MPMCQueue<std::uint64_t> queue(64);
+
+    std::vector<std::atomic<std::uint64_t>> popped_counts(PRODUCER_COUNT);
+    std::atomic<std::uint64_t> popped_total = 0;
+    std::atomic<bool> order_violated = false;
+
+    std::vector<std::thread> threads;
+
+    for (std::uint64_t producer = 0; producer < PRODUCER_COUNT; producer++) {
+        threads.emplace_back([&, producer]() {
+            for (std::uint64_t sequence = 0; sequence < STRESS_ELEMENTS_PER_PRODUCER; sequence++) {
+                while (!queue.try_push(encode_element(producer, sequence))) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    for (std::uint64_t consumer = 0; consumer < CONSUMER_COUNT; consumer++) {
+        threads.emplace_back([&]() {
+            // The next sequence number this consumer may see from every producer at the earliest.
+            std::vector<std::uint64_t> next_sequences(PRODUCER_COUNT, 0);
+
+            while (popped_total.load() < PRODUCER_COUNT * STRESS_ELEMENTS_PER_PRODUCER) {
+                std::uint64_t element = 0;
+                if (!queue.try_pop(element)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                const std::uint64_t producer = element >> 32;
+                const std::uint64_t sequence = element & 0xFFFFFFFF;
+
+                if (producer >= PRODUCER_COUNT || sequence < next_sequences[producer]) {
+                    order_violated = true;
+                } else {
+                    next_sequences[producer] = sequence + 1;
+                    popped_counts[producer]++;
+                }
+                popped_total++;
+            }
+        });
+    }
+
+    for (auto &thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_FALSE(order_violated);
+    EXPECT_EQ(popped_total, PRODUCER_COUNT * STRESS_ELEMENTS_PER_PRODUCER);
+    for (const auto &popped_count : popped_counts) {
+        EXPECT_EQ(popped_count, STRESS_ELEMENTS_PER_PRODUCER);
+    }
+
+    std::uint64_t element = 0;
+    EXPECT_FALSE(queue.try_pop(element));
+}
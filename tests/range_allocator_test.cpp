@@ -0,0 +1,160 @@
+#include "inexor/vulkan-renderer/range_allocator.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+using inexor::vulkan_renderer::RangeAllocator;
+
+TEST(RangeAllocator, AllocatesContiguousRanges) {
+    RangeAllocator allocator(100);
+    EXPECT_EQ(allocator.get_capacity(), 100u);
+    EXPECT_EQ(allocator.get_free_count(), 100u);
+
+    EXPECT_EQ(allocator.allocate(10), 0u);
+    EXPECT_EQ(allocator.allocate(20), 10u);
+    EXPECT_EQ(allocator.allocate(30), 30u);
+
+    EXPECT_EQ(allocator.get_free_count(), 40u);
+    EXPECT_EQ(allocator.get_free_range_count(), 1u);
+}
+
+TEST(RangeAllocator, FreedRangeIsReused) {
+    RangeAllocator allocator(100);
+
+    const auto first = allocator.allocate(10);
+    const auto second = allocator.allocate(10);
+    ASSERT_TRUE(first && second);
+
+    allocator.free(*first, 10);
+    EXPECT_EQ(allocator.get_free_count(), 90u);
+    EXPECT_EQ(allocator.get_free_range_count(), 2u);
+
+    // The first free range which is large enough is used.
+    EXPECT_EQ(allocator.allocate(4), 0u);
+    EXPECT_EQ(allocator.allocate(6), 4u);
+    EXPECT_EQ(allocator.allocate(1), 20u);
+    EXPECT_EQ(allocator.get_free_range_count(), 1u);
+}
+
+TEST(RangeAllocator, LargeAllocationSkipsSmallRanges) {
+    RangeAllocator allocator(100);
+
+    const auto first = allocator.allocate(10);
+    ASSERT_EQ(allocator.allocate(10), 10u);
+    ASSERT_TRUE(first);
+
+    allocator.free(*first, 10);
+
+    // The free range at the beginning is too small.
+    EXPECT_EQ(allocator.allocate(11), 20u);
+    EXPECT_EQ(allocator.allocate(10), 0u);
+}
+
+TEST(RangeAllocator, CoalescesWithNextRange) {
+    RangeAllocator allocator(30);
+
+    ASSERT_EQ(allocator.allocate(10), 0u);
+    ASSERT_EQ(allocator.allocate(10), 10u);
+
+    // [10, 20) is merged with the free range [20, 30).
+    allocator.free(10, 10);
+    EXPECT_EQ(allocator.get_free_range_count(), 1u);
+    EXPECT_EQ(allocator.get_free_count(), 20u);
+    EXPECT_EQ(allocator.allocate(20), 10u);
+}
+
+TEST(RangeAllocator, CoalescesWithPreviousRange) {
+    RangeAllocator allocator(30);
+
+    ASSERT_EQ(allocator.allocate(10), 0u);
+    ASSERT_EQ(allocator.allocate(10), 10u);
+    ASSERT_EQ(allocator.allocate(10), 20u);
+
+    allocator.free(0, 10);
+
+    // [10, 20) is merged with the free range [0, 10).
+    allocator.free(10, 10);
+    EXPECT_EQ(allocator.get_free_range_count(), 1u);
+    EXPECT_EQ(allocator.get_free_count(), 20u);
+    EXPECT_EQ(allocator.allocate(20), 0u);
+}
+
+TEST(RangeAllocator, CoalescesWithBothNeighbours) {
+    RangeAllocator allocator(50);
+
+    for (std::uint32_t i = 0; i < 5; i++) {
+        ASSERT_EQ(allocator.allocate(10), 10 * i);
+    }
+
+    allocator.free(10, 10);
+    allocator.free(30, 10);
+    EXPECT_EQ(allocator.get_free_range_count(), 2u);
+
+    // [20, 30) closes the gap between [10, 20) and [30, 40).
+    allocator.free(20, 10);
+    EXPECT_EQ(allocator.get_free_range_count(), 1u);
+    EXPECT_EQ(allocator.get_free_count(), 30u);
+    EXPECT_EQ(allocator.allocate(30), 10u);
+    EXPECT_EQ(allocator.get_free_count(), 0u);
+}
+
+TEST(RangeAllocator, FreeingEverythingRestoresOneRange) {
+    RangeAllocator allocator(64);
+
+    std::vector<std::uint32_t> offsets;
+    for (std::uint32_t i = 0; i < 8; i++) {
+        const auto offset = allocator.allocate(8);
+        ASSERT_TRUE(offset);
+        offsets.push_back(*offset);
+    }
+
+    // Free in an order which creates and merges ranges on both sides.
+    for (const std::uint32_t index : {1u, 5u, 3u, 0u, 7u, 2u, 6u, 4u}) {
+        allocator.free(offsets[index], 8);
+    }
+
+    EXPECT_EQ(allocator.get_free_range_count(), 1u);
+    EXPECT_EQ(allocator.get_free_count(), 64u);
+    EXPECT_EQ(allocator.allocate(64), 0u);
+}
+
+TEST(RangeAllocator, Exhaustion) {
+    RangeAllocator allocator(20);
+
+    EXPECT_EQ(allocator.allocate(21), std::nullopt);
+
+    ASSERT_EQ(allocator.allocate(20), 0u);
+    EXPECT_EQ(allocator.get_free_count(), 0u);
+    EXPECT_EQ(allocator.get_free_range_count(), 0u);
+    EXPECT_EQ(allocator.allocate(1), std::nullopt);
+
+    allocator.free(0, 20);
+    EXPECT_EQ(allocator.allocate(20), 0u);
+}
+
+TEST(RangeAllocator, FragmentedFreeCountIsNotEnough) {
+    RangeAllocator allocator(30);
+
+    for (std::uint32_t i = 0; i < 3; i++) {
+        ASSERT_EQ(allocator.allocate(10), 10 * i);
+    }
+
+    allocator.free(0, 10);
+    allocator.free(20, 10);
+
+    // 20 elements are free, but not in one range.
+    EXPECT_EQ(allocator.get_free_count(), 20u);
+    EXPECT_EQ(allocator.allocate(20), std::nullopt);
+    EXPECT_EQ(allocator.get_free_count(), 20u);
+}
+
+TEST(RangeAllocator, ZeroCapacity) {
+    RangeAllocator allocator(0);
+
+    EXPECT_EQ(allocator.get_free_count(), 0u);
+    EXPECT_EQ(allocator.get_free_range_count(), 0u);
+    EXPECT_EQ(allocator.allocate(1), std::nullopt);
+}
@@ -0,0 +1,86 @@
+#include "inexor/vulkan-renderer/task.hpp"
+
+#include <gtest/gtest.h>
+
+#include <future>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using inexor::TaskPriority;
+using inexor::ThreadPool;
+using inexor::vulkan_renderer::schedule_on;
+using inexor::vulkan_renderer::start_task;
+using inexor::vulkan_renderer::Task;
+
+Task<std::thread::id> get_worker_thread_id(ThreadPool &thread_pool, const TaskPriority priority) {
+    co_await schedule_on(thread_pool, priority);
+    co_return std::this_thread::get_id();
+}
+
+Task<int> square_on_worker(ThreadPool &thread_pool, const int value) {
+    co_await schedule_on(thread_pool);
+    co_return value * value;
+}
+
+Task<int> sum_of_squares(ThreadPool &thread_pool, const int count) {
+    int sum = 0;
+    for (int i = 1; i <= count; i++) {
+        sum += co_await square_on_worker(thread_pool, i);
+    }
+    co_return sum;
+}
+
+Task<void> throw_on_worker(ThreadPool &thread_pool) {
+    co_await schedule_on(thread_pool, TaskPriority::FRAME_CRITICAL);
+    throw std::runtime_error("Error: Task failed!");
+}
+
+Task<std::string> catch_on_worker(ThreadPool &thread_pool) {
+    try {
+        co_await throw_on_worker(thread_pool);
+    } catch (const std::runtime_error &exception) {
+        co_return exception.what();
+    }
+    co_return "";
+}
+
+} // namespace
+
+TEST(Task, ScheduleOnContinuesOnWorkerThread) {
+    ThreadPool thread_pool(4);
+
+    for (const auto priority : {TaskPriority::BACKGROUND, TaskPriority::FRAME_CRITICAL}) {
+        auto worker_thread_id = start_task(get_worker_thread_id(thread_pool, priority));
+        EXPECT_NE(worker_thread_id.get(), std::this_thread::get_id());
+    }
+}
+
+TEST(Task, ChainReturnsResult) {
+    ThreadPool thread_pool(4);
+
+    // 1^2 + 2^2 + ... + 100^2
+    EXPECT_EQ(start_task(sum_of_squares(thread_pool, 100)).get(), 338350);
+}
+
+TEST(Task, ManyChainsRunConcurrently) {
+    ThreadPool thread_pool(4);
+
+    std::vector<std::future<int>> results;
+    for (int i = 0; i < 64; i++) {
+        results.push_back(start_task(sum_of_squares(thread_pool, 10)));
+    }
+    for (auto &result : results) {
+        EXPECT_EQ(result.get(), 385);
+    }
+}
+
+TEST(Task, ExceptionPropagatesThroughChain) {
+    ThreadPool thread_pool(4);
+
+    EXPECT_THROW(start_task(throw_on_worker(thread_pool)).get(), std::runtime_error);
+    EXPECT_EQ(start_task(catch_on_worker(thread_pool)).get(), "Error: Task failed!");
+}
@@ -0,0 +1,161 @@
+#include "inexor/vulkan-renderer/thread_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using inexor::TaskPriority;
+using inexor::TaskQueueBackend;
+using inexor::ThreadPool;
+
+/// The number of worker threads of the threadpools in these tests.
+constexpr std::size_t TEST_THREAD_COUNT = 6;
+
+/// The capacity of the lock-free tasklists, small enough for execute() to wait for free slots under stress.
+constexpr std::size_t TEST_LOCK_FREE_CAPACITY = 16;
+
+/// Runs every test once for every tasklist backend.
+class ThreadPoolTest : public testing::TestWithParam<TaskQueueBackend> {
+protected:
+    ThreadPool thread_pool{TEST_THREAD_COUNT, 1, GetParam(), TEST_LOCK_FREE_CAPACITY};
+};
+
+} // namespace
+
+TEST_P(ThreadPoolTest, ExecuteReturnsResults) {
+    std::vector<std::future<int>> results;
+    for (int i = 0; i < 100; i++) {
+        const auto priority = i % 2 == 0 ? TaskPriority::FRAME_CRITICAL : TaskPriority::BACKGROUND;
+        results.push_back(thread_pool.execute(priority, [](const int value) { return 2 * value; }, i));
+    }
+
+    for (int i = 0; i < 100; i++) {
+        EXPECT_EQ(results[i].get(), 2 * i);
+    }
+}
+
+TEST_P(ThreadPoolTest, ExceptionIsStoredInFuture) {
+    auto result = thread_pool.execute([]() -> int { throw std::runtime_error("Error: Task failed!"); });
+    EXPECT_THROW(result.get(), std::runtime_error);
+}
+
+// Several threads submit tasks of both priority classes at the same time while workers take them out.
+TEST_P(ThreadPoolTest, StressConcurrentSubmission) {
+    constexpr std::size_t SUBMITTER_COUNT = 4;
+    constexpr std::size_t TASKS_PER_SUBMITTER = 5'000;
+
+    thread_pool.set_instrumentation_enabled(true);
+
+    std::atomic<std::size_t> executed_tasks = 0;
+
+    std::vector<std::thread> submitters;
+    for (std::size_t submitter = 0; submitter < SUBMITTER_COUNT; submitter++) {
+        submitters.emplace_back([&, submitter]() {
+            std::vector<std::future<std::size_t>> results;
+            results.reserve(TASKS_PER_SUBMITTER);
+
+            for (std::size_t i = 0; i < TASKS_PER_SUBMITTER; i++) {
+                const auto priority =
+                    (i + submitter) % 3 == 0 ? TaskPriority::FRAME_CRITICAL : TaskPriority::BACKGROUND;
+                results.push_back(thread_pool.execute(priority, [&executed_tasks, i]() {
+                    executed_tasks++;
+                    return i;
+                }));
+            }
+
+            for (std::size_t i = 0; i < TASKS_PER_SUBMITTER; i++) {
+                EXPECT_EQ(results[i].get(), i);
+            }
+        });
+    }
+
+    // Reading the statistics must be safe while tasks are running.
+    for (int i = 0; i < 100; i++) {
+        const auto stats = thread_pool.get_stats();
+        EXPECT_EQ(stats.worker_utilization.size(), TEST_THREAD_COUNT);
+    }
+
+    for (auto &submitter : submitters) {
+        submitter.join();
+    }
+
+    EXPECT_EQ(executed_tasks, SUBMITTER_COUNT * TASKS_PER_SUBMITTER);
+
+    // A task counts as completed right after its future became ready, so give the workers a moment to catch up.
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    auto stats = thread_pool.get_stats();
+    while (stats.completed_tasks != stats.enqueued_tasks && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+        stats = thread_pool.get_stats();
+    }
+
+    EXPECT_EQ(stats.enqueued_tasks[0] + stats.enqueued_tasks[1], SUBMITTER_COUNT * TASKS_PER_SUBMITTER);
+    EXPECT_EQ(stats.completed_tasks, stats.enqueued_tasks);
+    EXPECT_EQ(stats.queue_depth[0] + stats.queue_depth[1], 0u);
+}
+
+// Tasks which submit further tasks from worker threads.
+TEST_P(ThreadPoolTest, StressNestedSubmission) {
+    constexpr std::size_t OUTER_TASK_COUNT = 200;
+    constexpr std::size_t INNER_TASKS_PER_OUTER_TASK = 10;
+
+    std::atomic<std::size_t> executed_inner_tasks = 0;
+
+    std::vector<std::future<void>> outer_results;
+    for (std::size_t i = 0; i < OUTER_TASK_COUNT; i++) {
+        outer_results.push_back(thread_pool.execute([&]() {
+            for (std::size_t j = 0; j < INNER_TASKS_PER_OUTER_TASK; j++) {
+                // Workers must never wait for other tasks, so the futures of the inner tasks are dropped.
+                static_cast<void>(
+                    thread_pool.execute(TaskPriority::FRAME_CRITICAL, [&]() { executed_inner_tasks++; }));
+            }
+        }));
+    }
+
+    for (auto &outer_result : outer_results) {
+        outer_result.get();
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    while (executed_inner_tasks < OUTER_TASK_COUNT * INNER_TASKS_PER_OUTER_TASK &&
+           std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::yield();
+    }
+
+    EXPECT_EQ(executed_inner_tasks, OUTER_TASK_COUNT * INNER_TASKS_PER_OUTER_TASK);
+}
+
+// Worker threads can be added while other threads read the statistics.
+TEST_P(ThreadPoolTest, StartThreadWhileReadingStats) {
+    thread_pool.set_instrumentation_enabled(true);
+
+    std::thread stats_reader([&]() {
+        for (int i = 0; i < 200; i++) {
+            static_cast<void>(thread_pool.get_stats());
+            thread_pool.reset_stats();
+        }
+    });
+
+    for (int i = 0; i < 4; i++) {
+        thread_pool.start_thread(i % 2 == 0);
+    }
+
+    stats_reader.join();
+
+    EXPECT_EQ(thread_pool.get_stats().worker_utilization.size(), TEST_THREAD_COUNT + 4);
+    EXPECT_EQ(thread_pool.execute([]() { return 42; }).get(), 42);
+}
+
+INSTANTIATE_TEST_SUITE_P(Backends, ThreadPoolTest,
+                         testing::Values(TaskQueueBackend::MUTEX, TaskQueueBackend::LOCK_FREE),
+                         [](const testing::TestParamInfo<TaskQueueBackend> &info) {
+                             return info.param == TaskQueueBackend::MUTEX ? "Mutex" : "LockFree";
+                         });
@@ -0,0 +1,202 @@
+#include "bc_encoder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdlib>
+
+namespace inexor::texture_converter {
+
+namespace {
+
+/// The RGBA8 texels of a 4x4 block.
+using Block = std::array<std::uint8_t, 16 * 4>;
+
+/// @brief Copies a 4x4 block out of an image, repeating the last row or column at the edges.
+Block load_block(const std::uint8_t *rgba, const std::uint32_t width, const std::uint32_t height,
+                 const std::uint32_t block_x, const std::uint32_t block_y) {
+    Block block;
+
+    for (std::uint32_t y = 0; y < 4; y++) {
+        for (std::uint32_t x = 0; x < 4; x++) {
+            const std::size_t src_x = std::min(block_x * 4 + x, width - 1);
+            const std::size_t src_y = std::min(block_y * 4 + y, height - 1);
+            std::copy_n(rgba + (src_y * width + src_x) * 4, 4, block.data() + (y * 4 + x) * 4);
+        }
+    }
+
+    return block;
+}
+
+std::uint16_t pack_rgb565(const std::uint8_t *color) {
+    return static_cast<std::uint16_t>(((color[0] >> 3) << 11) | ((color[1] >> 2) << 5) | (color[2] >> 3));
+}
+
+std::array<int, 3> unpack_rgb565(const std::uint16_t color) {
+    const int r = (color >> 11) & 31;
+    const int g = (color >> 5) & 63;
+    const int b = color & 31;
+    return {(r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2)};
+}
+
+/// @brief Encodes the colors of a block into the 8 byte color block which BC1 and BC3 share.
+/// The color block is always encoded in the four color mode, which BC3 requires.
+void encode_color_block(const Block &block, std::uint8_t *output) {
+    std::array<std::uint8_t, 3> min_color = {255, 255, 255};
+    std::array<std::uint8_t, 3> max_color = {0, 0, 0};
+
+    for (std::size_t i = 0; i < 16; i++) {
+        for (std::size_t channel = 0; channel < 3; channel++) {
+            min_color[channel] = std::min(min_color[channel], block[i * 4 + channel]);
+            max_color[channel] = std::max(max_color[channel], block[i * 4 + channel]);
+        }
+    }
+
+    // Insetting the bounding box by 1/16 of its size reduces the error of the interpolated colors.
+    for (std::size_t channel = 0; channel < 3; channel++) {
+        const int inset = (max_color[channel] - min_color[channel]) >> 4;
+        min_color[channel] = static_cast<std::uint8_t>(std::min(min_color[channel] + inset, 255));
+        max_color[channel] = static_cast<std::uint8_t>(std::max(max_color[channel] - inset, 0));
+    }
+
+    std::uint16_t color0 = pack_rgb565(max_color.data());
+    std::uint16_t color1 = pack_rgb565(min_color.data());
+
+    // The four color mode is selected by color0 > color1. If both are equal, every texel uses color0.
+    if (color0 < color1) {
+        std::swap(color0, color1);
+    }
+
+    std::uint32_t indices = 0;
+
+    if (color0 != color1) {
+        const auto c0 = unpack_rgb565(color0);
+        const auto c1 = unpack_rgb565(color1);
+
+        std::array<std::array<int, 3>, 4> palette = {c0, c1};
+        for (std::size_t channel = 0; channel < 3; channel++) {
+            palette[2][channel] = (2 * c0[channel] + c1[channel]) / 3;
+            palette[3][channel] = (c0[channel] + 2 * c1[channel]) / 3;
+        }
+
+        for (std::uint32_t i = 0; i < 16; i++) {
+            std::uint32_t best_index = 0;
+            int best_distance = 0x7FFFFFFF;
+
+            for (std::uint32_t index = 0; index < 4; index++) {
+                int distance = 0;
+                for (std::size_t channel = 0; channel < 3; channel++) {
+                    const int difference = block[i * 4 + channel] - palette[index][channel];
+                    distance += difference * difference;
+                }
+
+                if (distance < best_distance) {
+                    best_distance = distance;
+                    best_index = index;
+                }
+            }
+
+            indices |= best_index << (2 * i);
+        }
+    }
+
+    output[0] = static_cast<std::uint8_t>(color0);
+    output[1] = static_cast<std::uint8_t>(color0 >> 8);
+    output[2] = static_cast<std::uint8_t>(color1);
+    output[3] = static_cast<std::uint8_t>(color1 >> 8);
+
+    for (std::size_t i = 0; i < 4; i++) {
+        output[4 + i] = static_cast<std::uint8_t>(indices >> (8 * i));
+    }
+}
+
+/// @brief Encodes the alpha channel of a block into the 8 byte alpha block of BC3.
+void encode_alpha_block(const Block &block, std::uint8_t *output) {
+    std::uint8_t min_alpha = 255;
+    std::uint8_t max_alpha = 0;
+
+    for (std::size_t i = 0; i < 16; i++) {
+        min_alpha = std::min(min_alpha, block[i * 4 + 3]);
+        max_alpha = std::max(max_alpha, block[i * 4 + 3]);
+    }
+
+    std::uint64_t indices = 0;
+
+    // With alpha0 > alpha1, the six other alpha values are interpolated between them.
+    if (max_alpha != min_alpha) {
+        std::array<int, 8> palette = {max_alpha, min_alpha};
+        for (int index = 2; index < 8; index++) {
+            palette[index] = ((8 - index) * max_alpha + (index - 1) * min_alpha) / 7;
+        }
+
+        for (std::uint32_t i = 0; i < 16; i++) {
+            std::uint64_t best_index = 0;
+            int best_distance = 256;
+
+            for (std::uint32_t index = 0; index < 8; index++) {
+                const int distance = std::abs(block[i * 4 + 3] - palette[index]);
+                if (distance < best_distance) {
+                    best_distance = distance;
+                    best_index = index;
+                }
+            }
+
+            indices |= best_index << (3 * i);
+        }
+    }
+
+    output[0] = max_alpha;
+    output[1] = min_alpha;
+
+    for (std::size_t i = 0; i < 6; i++) {
+        output[2 + i] = static_cast<std::uint8_t>(indices >> (8 * i));
+    }
+}
+
+} // namespace
+
+std::vector<std::uint8_t> compress_bc1(const std::uint8_t *rgba, const std::uint32_t width,
+                                       const std::uint32_t height) {
+    assert(rgba);
+    assert(width > 0);
+    assert(height > 0);
+
+    const std::uint32_t blocks_x = (width + 3) / 4;
+    const std::uint32_t blocks_y = (height + 3) / 4;
+
+    std::vector<std::uint8_t> blocks(static_cast<std::size_t>(blocks_x) * blocks_y * 8);
+
+    for (std::uint32_t block_y = 0; block_y < blocks_y; block_y++) {
+        for (std::uint32_t block_x = 0; block_x < blocks_x; block_x++) {
+            const Block block = load_block(rgba, width, height, block_x, block_y);
+            encode_color_block(block, blocks.data() + (static_cast<std::size_t>(block_y) * blocks_x + block_x) * 8);
+        }
+    }
+
+    return blocks;
+}
+
+std::vector<std::uint8_t> compress_bc3(const std::uint8_t *rgba, const std::uint32_t width,
+                                       const std::uint32_t height) {
+    assert(rgba);
+    assert(width > 0);
+    assert(height > 0);
+
+    const std::uint32_t blocks_x = (width + 3) / 4;
+    const std::uint32_t blocks_y = (height + 3) / 4;
+
+    std::vector<std::uint8_t> blocks(static_cast<std::size_t>(blocks_x) * blocks_y * 16);
+
+    for (std::uint32_t block_y = 0; block_y < blocks_y; block_y++) {
+        for (std::uint32_t block_x = 0; block_x < blocks_x; block_x++) {
+            const Block block = load_block(rgba, width, height, block_x, block_y);
+            std::uint8_t *output = blocks.data() + (static_cast<std::size_t>(block_y) * blocks_x + block_x) * 16;
+            encode_alpha_block(block, output);
+            encode_color_block(block, output + 8);
+        }
+    }
+
+    return blocks;
+}
+
+} // namespace inexor::texture_converter
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace inexor::texture_converter {
+
+/// @brief Compresses an RGBA8 image into BC1 blocks, ignoring the alpha channel.
+/// The endpoints of every block are the corners of the slightly inset bounding box of its colors, which is fast and
+/// good enough for the diffuse textures of the engine.
+/// @param rgba [in] The tightly packed texels.
+/// @param width [in] The width of the image.
+/// @param height [in] The height of the image. Incomplete blocks at the edges are padded by repeating the last row or
+/// column.
+/// @return The blocks in row-major order.
+[[nodiscard]] std::vector<std::uint8_t> compress_bc1(const std::uint8_t *rgba, std::uint32_t width,
+                                                     std::uint32_t height);
+
+/// @brief Compresses an RGBA8 image into BC3 blocks, which store the alpha channel separately.
+/// @param rgba [in] The tightly packed texels.
+/// @param width [in] The width of the image.
+/// @param height [in] The height of the image.
+/// @return The blocks in row-major order.
+[[nodiscard]] std::vector<std::uint8_t> compress_bc3(const std::uint8_t *rgba, std::uint32_t width,
+                                                     std::uint32_t height);
+
+} // namespace inexor::texture_converter
@@ -0,0 +1,97 @@
+#include "bc_encoder.hpp"
+
+#include "inexor/vulkan-renderer/io/image_file.hpp"
+#include "inexor/vulkan-renderer/io/ktx2_file.hpp"
+#include "inexor/vulkan-renderer/tools/mip_chain.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace inexor::vulkan_renderer;
+using namespace inexor::texture_converter;
+
+namespace {
+
+/// @brief Converts a JPG or PNG file into a KTX 2.0 file with the same name next to it.
+/// Opaque textures are compressed into BC1, textures with transparent texels into BC3. Every texture gets a full mip
+/// chain, as the mip levels of block compressed textures can't be generated at load time.
+void convert_texture(const std::filesystem::path &input_file_name) {
+    const auto start = std::chrono::steady_clock::now();
+
+    std::vector<std::uint64_t> mip_level_offsets;
+    std::vector<std::uint8_t> mip_chain;
+    std::uint32_t texture_width = 0;
+    std::uint32_t texture_height = 0;
+    std::uint32_t mip_levels = 0;
+
+    {
+        const io::ImageFile image_file(input_file_name);
+
+        texture_width = image_file.get_width();
+        texture_height = image_file.get_height();
+        mip_levels = tools::calculate_mip_levels(texture_width, texture_height);
+        mip_chain = tools::generate_mip_chain(image_file.get_data(), texture_width, texture_height, mip_levels,
+                                              mip_level_offsets);
+    }
+
+    bool has_alpha = false;
+    for (std::size_t i = 3; i < mip_chain.size() && !has_alpha; i += 4) {
+        has_alpha = mip_chain[i] != 255;
+    }
+
+    const VkFormat format = has_alpha ? VK_FORMAT_BC3_UNORM_BLOCK : VK_FORMAT_BC1_RGB_UNORM_BLOCK;
+
+    std::vector<std::vector<std::uint8_t>> levels;
+    std::size_t compressed_size = 0;
+
+    for (std::uint32_t level = 0; level < mip_levels; level++) {
+        const std::uint8_t *level_data = mip_chain.data() + mip_level_offsets[level];
+        const std::uint32_t level_width = std::max(texture_width >> level, 1u);
+        const std::uint32_t level_height = std::max(texture_height >> level, 1u);
+
+        levels.push_back(has_alpha ? compress_bc3(level_data, level_width, level_height)
+                                   : compress_bc1(level_data, level_width, level_height));
+        compressed_size += levels.back().size();
+    }
+
+    auto output_file_name = input_file_name;
+    output_file_name.replace_extension(".ktx2");
+
+    io::write_ktx2_file(output_file_name, format, texture_width, texture_height, levels);
+
+    const std::chrono::duration<double, std::milli> duration = std::chrono::steady_clock::now() - start;
+
+    spdlog::info("Converted {} ({}x{}) to {} with {} and {} mip levels in {:.2f} ms: {} bytes instead of {} bytes of "
+                 "uncompressed texels.",
+                 input_file_name.string(), texture_width, texture_height, output_file_name.string(),
+                 has_alpha ? "BC3" : "BC1", mip_levels, duration.count(), compressed_size, mip_chain.size());
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+    if (argc < 2) {
+        spdlog::error("Usage: {} <texture files>...", argv[0]);
+        return 1;
+    }
+
+    int result = 0;
+
+    for (int i = 1; i < argc; i++) {
+        try {
+            convert_texture(argv[i]);
+        } catch (const std::exception &exception) {
+            spdlog::error("{}", exception.what());
+            result = 1;
+        }
+    }
+
+    return result;
+}